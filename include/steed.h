@@ -14,10 +14,14 @@
 
 #include "Config.h"
 #include "Utility.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "SchemaTreeMap.h"
 #include "ColumnParser.h"
 #include "ColumnAssembler.h"
 #include "RecordOutput.h"
+#include "ColumnOutput.h"
 
 namespace steed {
 using std::string;
@@ -30,6 +34,13 @@ using std::ifstream;
  */
 void init(const string &cfile);
 
+/**
+ * init steed runtime (logger, metrics, memory, tracer and static data)
+ *   by g_config, which should be loaded before
+ * @return 0 success; <0 failed
+ */
+int initRuntime(void);
+
 /**
  * uninit steed static data
  */
@@ -144,6 +155,30 @@ extern "C" {
      */
     int assemble_to_file(const char *db, const char *table, const char **cols, int ncol, const char *jpath);
 
+    /**
+     * assemble binary records and write JSON lines to a file descriptor
+     * @param db database name
+     * @param table table name
+     * @param cols column names
+     * @param ncol number of columns
+     * @param fd file descriptor opened to write, not closed
+     * @return 1 success, -1 if failed
+     */
+    int assemble_to_fd(const char *db, const char *table, const char **cols, int ncol, int fd);
+
+    /**
+     * assemble binary records and pass JSON lines to callback by batches
+     * @param db database name
+     * @param table table name
+     * @param cols column names
+     * @param ncol number of columns
+     * @param cb callback for each batch, returns <0 to stop
+     * @param arg callback arg
+     * @return 1 success, -1 if failed or stopped
+     */
+    int assemble_to_callback(const char *db, const char *table, const char **cols, int ncol,
+        int (*cb)(const char *data, uint64_t len, void *arg), void *arg);
+
     /**
      * assemble binary records and output to string
      * @param db database name
@@ -154,6 +189,21 @@ extern "C" {
      */
     const char *assemble_to_string(const char *db, const char *table, const char **cols, int ncol);
 
+    /**
+     * assemble binary records in a range and output to string
+     * @param db database name
+     * @param table table name
+     * @param cols column names
+     * @param ncol number of columns
+     * @param begin begin record index
+     * @param end end record index, excluded, UINT64_MAX to the end
+     * @param offset records to skip in the range
+     * @param limit max record number, UINT64_MAX no limit
+     * @return a list of json records, NULL if failed
+     */
+    const char *assemble_range_to_string(const char *db, const char *table, const char **cols, int ncol,
+        uint64_t begin, uint64_t end, uint64_t offset, uint64_t limit);
+
 
     /*
      * parse JSON records in a string and insert into table
@@ -183,4 +233,78 @@ extern "C" {
      */
     void close_parser(steed::ColumnParser *cp);
 
+
+    /*
+     * metrics of the hot path, enabled by the metrics config option
+     */
+
+    /**
+     * enable or disable collecting metrics
+     * @param on  non-zero to enable
+     */
+    void metrics_enable(int on);
+
+    /**
+     * reset the metrics of all threads
+     */
+    void metrics_reset(void);
+
+    /**
+     * get a counter value in the metrics snapshot
+     * @param name counter name, such as recd_parsed
+     * @return counter value, 0 for unknown name
+     */
+    uint64_t metrics_counter(const char *name);
+
+    /**
+     * get the metrics snapshot as a JSON string
+     * @return JSON string, free it by free_string
+     */
+    const char *metrics_to_string(void);
+
+
+    /*
+     * logging, initialized by the log_* config options
+     */
+
+    /**
+     * set the min log level
+     * @param level trace, debug, info, warn, error or off
+     * @return 0 success, -1 unknown level
+     */
+    int log_set_level(const char *level);
+
+    /**
+     * append log lines to a file
+     * @param path file path, NULL or empty for stderr
+     * @return 0 success, -1 if failed
+     */
+    int log_set_file(const char *path);
+
+    /**
+     * pass log messages to a callback instead of the file
+     * @param cb callback with the level (0 trace .. 4 error) and the message,
+     *           NULL to output to the file again
+     */
+    void log_set_callback(void (*cb)(int level, const char *msg));
+
+
+    /*
+     * trace events, started by the trace_file config option
+     */
+
+    /**
+     * start buffering trace events, written to the file by trace_stop
+     * @param path output file path
+     * @param format json (Chrome trace) or binary, NULL as json
+     * @return 0 success, -1 if failed
+     */
+    int trace_start(const char *path, const char *format);
+
+    /**
+     * stop tracing and write the buffered events
+     * @return written event number, -1 if failed
+     */
+    int64_t trace_stop(void);
+
 } // extern "C"
\ No newline at end of file
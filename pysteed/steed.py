@@ -73,6 +73,15 @@ def assemble_to_file(db, table, cols, jpath):
     return libsteed.assemble_to_file(db.encode("utf-8"), table.encode("utf-8"), cols_bytes, cols_num, jpath.encode("utf-8"))
 
 
+# int assemble_to_fd(const char *db, const char *table, const char **cols, int ncol, int fd);
+def assemble_to_fd(db, table, cols, fd):
+    cols_num = len(cols)
+    cols_bytes = (ctypes.c_char_p * cols_num)(*[s.encode('utf-8') for s in cols])
+    libsteed.assemble_to_fd.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int]
+    libsteed.assemble_to_fd.restype = ctypes.c_int
+    return libsteed.assemble_to_fd(db.encode("utf-8"), table.encode("utf-8"), cols_bytes, cols_num, fd)
+
+
 # const char *assemble_to_string(const char *db, const char *table, const char **cols, int ncol, int *len);
 json_bytes = None
 def assemble_to_string(db, table, cols):
@@ -86,6 +95,21 @@ def assemble_to_string(db, table, cols):
     jdata = json.loads(json_string)
     return jdata
 
+# const char *assemble_range_to_string(const char *db, const char *table, const char **cols, int ncol,
+#     uint64_t begin, uint64_t end, uint64_t offset, uint64_t limit);
+def assemble_range_to_string(db, table, cols, begin=0, end=2**64-1, offset=0, limit=2**64-1):
+    cols_num = len(cols)
+    cols_bytes = (ctypes.c_char_p * cols_num)(*[s.encode('utf-8') for s in cols])
+    libsteed.assemble_range_to_string.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int,
+        ctypes.c_uint64, ctypes.c_uint64, ctypes.c_uint64, ctypes.c_uint64]
+    libsteed.assemble_range_to_string.restype = ctypes.c_char_p
+    global json_bytes
+    json_bytes = libsteed.assemble_range_to_string(db.encode("utf-8"), table.encode("utf-8"), cols_bytes, cols_num,
+        begin, end, offset, limit)
+    json_string = json_bytes.decode("utf-8")
+    jdata = json.loads(json_string)
+    return jdata
+
 def malloc_json_bytes():
     global json_bytes
     json_bytes = None
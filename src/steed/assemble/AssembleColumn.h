@@ -60,6 +60,8 @@ public:
 
 public:
     uint64_t               getMaxDepth      (void) { return m_max_depth; }
+    QueryPathes           *getAllPathes     (void) { return m_all_path ; }
+    vector<ColumnReader*> &getAllColRead    (void) { return m_all_crds ; }
     QueryPathes           *getCurrentPathes (void) { return m_cur_path ; }
     vector<ColumnReader*> &getCurrentColRead(void) { return m_cur_crds ; }
 
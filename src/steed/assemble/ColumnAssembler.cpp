@@ -28,16 +28,24 @@
 namespace steed {
 
 
-int ColumnAssembler::init(const string &db, const string &tb, vector<string> cols)
+int ColumnAssembler::init(const string &db, const string &tb, vector<string> cols,
+    const string &cond)
 {
-    int got = SchemaTreeMap::getDefinedTree(db, tb, m_tree);
+    // query a read-only tree: appending by another thread is not seen
+    int got = SchemaTreeMap::getSnapshot(db, tb, m_tree_ref);
+    m_tree  = m_tree_ref.get();
     if (got <= 0)
     {
         printf( "ColumnAssembler: SchemaTree [%s:%s] is missing!\n", db.c_str(), tb.c_str());
-        return got;
+        return -1;
     } // if
 
-    m_buf = new Buffer(g_config.m_assemble_buf_cap);
+    // buffers and CABs created below are charged to the query 
+    MemTrackerScope scope(&m_mem);
+    uint64_t cap = std::min(uint64_t(g_config.m_assemble_buf_cap), m_mem.available() / 2);
+    cap = std::max(cap, uint64_t(g_config.m_recd_max_len));
+    m_buf = new Buffer(cap, false); // rows are built in place
+    m_buf->setBudget(true);
     m_parser.init(m_tree, &m_exps);
 
     // parse column names into m_exps,
@@ -73,6 +81,17 @@ int ColumnAssembler::init(const string &db, const string &tb, vector<string> col
         m_col_rds.emplace_back(rd);
     } // for
 
+    // the filter column is read before the projections
+    if (!cond.empty())
+    {
+        m_filter = new ColumnFilter();
+        if (m_filter->init(dir, m_tree, cond) < 0)
+        {
+            printf("ColumnAssembler: filter [%s] init failed!\n", cond.c_str());
+            return -1;
+        } // if
+    } // if
+
     return this->init(&m_fields, m_col_rds);
 } // init 
 
@@ -103,25 +122,67 @@ int32_t ColumnAssembler::getNext(char* &rbgn)
 
 
 
+int32_t ColumnAssembler::getNextItems(vector<ColumnItem> &items)
+{
+    if (m_flat == nullptr)
+    {
+        puts("ColumnAssembler: getNextItems needs pathes without repeated field!");
+        return -1;
+    } // if
+    if (m_total_rnum >= m_limit) { return 0; }
+
+    int got = prepareColumnReader();
+    if (got <= 0) { return got; }
+
+    vector<ColumnReader*> &crds = m_columns->getAllColRead();
+    uint32_t cnum = crds.size();
+    items.resize(cnum);
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        // not prepared: the column is valid after current record
+        items[ci].reset();
+        if (crds[ci]->getValidRecdIdx() > m_cur_recd_idx) { continue; }
+
+        got = crds[ci]->readItem(items[ci]);
+        if (got <= 0)
+        {
+            printf("ColumnAssembler: read item from [%u] failed!\n", ci);
+            return (got < 0) ? got : -1;
+        } // if
+    } // for ci
+
+    ++m_cur_recd_idx;
+    ++m_total_rnum;
+    return 1;
+} // getNextItems
+
+
+
 int32_t ColumnAssembler::bufferMore(void)
 {
-    if (m_dbl_buf)
+    MemTrackerScope scope(&m_mem);
+    if (m_dbl_buf && !m_mem.pressured())
     {
         m_dbl_buf = false;
         if (doubleBuffer() < 0)
         {
-            puts("CFO: double buffer for space failed!");
-            return -1;
+            // over the budget: assemble smaller batches in the buffer
+            m_buf_max = true;
+            STEED_LOG(warn, "ColumnAssembler: buffer is capped at [%lu] bytes by the memory budget",
+                m_buf->capacity());
         } // if
     } // if
 
+    MetricsTimer timer(Metrics::t_assemble);
+    TraceScope   trace(Tracer::assemble_batch);
     int32_t rnum = 0, rd_got = 0, anum = 0;
-    while  (rnum < int32_t(g_config.m_recd_cap))
+    int32_t rcap = int32_t(std::min(uint64_t(g_config.m_recd_cap), m_limit - m_total_rnum));
+    while  (rnum < rcap)
     {
         // check avail space is enough
         uint64_t  avail = m_buf->available();
-        m_dbl_buf = (avail < g_config.m_recd_max_len);
-        if (m_dbl_buf) { break; }
+        if (avail < g_config.m_recd_max_len)
+        {   m_dbl_buf = !m_buf_max; break;   }
 
 
         // prepare and assemble
@@ -129,14 +190,15 @@ int32_t ColumnAssembler::bufferMore(void)
         if      (rd_got <  0) { rnum = rd_got; break; } // failed
         else if (rd_got == 0) { break; }                // EOF
 
-        anum = m_assemble->assemble();
-        assert(anum == 1);
+        anum = (m_flat != nullptr) ? m_flat->assemble() : m_assemble->assemble();
+        if      (anum <  0) { rnum = anum; break; } // failed
+        else if (anum == 0) { break; }              // EOF
 
         m_cur_recd_idx += anum;  // assemble one: update record index
         ++rnum;
     } // rnum
 
-
+    if (rnum > 0) { Metrics::add(Metrics::recd_assembled, rnum); }
     return rnum;
 } // bufferMore
 
@@ -144,11 +206,32 @@ int32_t ColumnAssembler::bufferMore(void)
 
 int ColumnAssembler::prepareColumnReader(void)
 {
+    // projections are only read for the selected records in range,
+    // the offset records are skipped before any projection is read
+    while (true)
+    {
+        if (m_filter != nullptr)
+        {
+            int got = m_filter->next(m_cur_recd_idx);
+            if (got <= 0) { return got; }
+        } // if
+
+        if (m_cur_recd_idx >= m_recd_end) { return 0; }
+        if (m_offset == 0) { break; }
+
+        // without filter, jump over the offset records directly
+        uint64_t skip  = (m_filter == nullptr) ? m_offset : 1;
+        m_offset      -= skip;
+        m_cur_recd_idx = (m_recd_end - m_cur_recd_idx > skip) ?
+            m_cur_recd_idx + skip : m_recd_end;
+    } // while
+
     // some columns become valid: reinit assembler
     if (m_columns->need2update (m_cur_recd_idx))
     {
         m_columns ->updateColumn(m_cur_recd_idx);
-        m_assemble->reinit(m_columns);
+        if (m_flat != nullptr) { m_flat    ->reinit(m_columns); }
+        else                   { m_assemble->reinit(m_columns); }
     } // if
 
     // prepare each column reader:
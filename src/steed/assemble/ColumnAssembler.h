@@ -26,17 +26,24 @@
 #pragma once
 
 #include <stdint.h>
+#include <algorithm>
 
 #include "Row.h"
 #include "Buffer.h"
 #include "Config.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "Utility.h"
+#include "MemTracker.h"
 #include "SchemaTree.h"
 #include "SchemaTreeMap.h"
 
 #include "ColumnExpressionParser.h"
 
 #include "AssembleColumn.h"
+#include "ColumnFilter.h"
+#include "RecordFlatAssembler.h"
 #include "RecordNestedAssembler.h"
 
 
@@ -52,19 +59,28 @@ protected: // init by column name strings
     ColumnExpressionParser   m_parser {}; /**< column expression parser */
     QueryPathes              m_fields {}; /**< query pathes for fields */
     vector<ColumnReader*>    m_col_rds{}; /**< column readers for fields */
+    ColumnFilter            *m_filter {nullptr}; /**< select records first */
 
 protected: // init by QueryPathes and ColumnReader 
+    /** buffers and CABs of the query, freed before it is destroyed */
+    MemTracker     m_mem  {"query", g_config.m_query_mem_limit, &MemTracker::process()};
     Buffer        *m_buf  {nullptr}; /**< binary row buffer  */
+    SchemaTreeRef  m_tree_ref{};     /**< held SchemaTree    */
     SchemaTree    *m_tree {nullptr}; /**< related SchemaTree */
 
     AssembleColumn          *m_columns {nullptr}; /**< assemble columns  */
     RecordNestedAssembler   *m_assemble{nullptr}; /**< bin row assembler */
+    RecordFlatAssembler     *m_flat    {nullptr}; /**< no repeated pathes */
     uint64_t                 m_cur_recd_idx  {0}; /**< current recd idx  */
+    uint64_t                 m_recd_end{UINT64_MAX}; /**< read recd end  */
+    uint64_t                 m_offset  {0};          /**< recds to skip  */
+    uint64_t                 m_limit {UINT64_MAX};   /**< max recd num   */
 
     uint64_t       m_total_rnum {0}; /**< total record number*/
     uint64_t       m_next_rbgn  {0}; /**< next record begin  */
     uint32_t       m_buf_rnum   {0}; /**< record buffer num  */
     bool           m_dbl_buf{false}; /**< double buffer flag */
+    bool           m_buf_max{false}; /**< capped by budget   */
 
     
 public:
@@ -78,9 +94,11 @@ public:
      *   1. use SchemaTree to get related QueryPathes
      *   2. use each path in QueryPathes to create reader in vector<ColumnReader*>
      * @param cols  column name strings in vector
+     * @param cond  filter condition "path op value", empty selects all
      * @return 0 success; <0 failed
      */
-    int init(const string &db, const string &tb, vector<string> cols);
+    int init(const string &db, const string &tb, vector<string> cols,
+        const string &cond = "");
 
     /**
      * init function:
@@ -91,8 +109,29 @@ public:
      */
     int init(QueryPathes *path, vector<ColumnReader*> &crd);
 
+    /**
+     * read the records in [bgn, end) only, set before the first getNext:
+     *   the readers seek to bgn by CAB index without reading the front
+     * @param bgn   begin record index
+     * @param end   end   record index, UINT64_MAX to the end
+     * @return 0 success; <0 failed
+     */
+    int setRecordRange(uint64_t bgn, uint64_t end = UINT64_MAX);
+
+    /**
+     * skip the first offset records and stop after limit records,
+     *   the records are counted after the filter and record range
+     * @param offset   record number to skip
+     * @param limit    max record number to get, UINT64_MAX no limit
+     * @return 0 success; <0 failed
+     */
+    int setLimit(uint64_t offset, uint64_t limit = UINT64_MAX);
+
 public:
     SchemaTree* getSchemaTree(void) { return m_tree; }
+    QueryPathes*getQueryPathes(void) { return m_columns->getAllPathes(); }
+    bool        isFlat       (void) { return m_flat != nullptr; }
+    MemTracker* getMemTracker(void) { return &m_mem; }
 
 public:
     /**
@@ -102,23 +141,34 @@ public:
      */
     int32_t getNext(char* &rbgn);
 
+    /**
+     * get next record as column items straight from the readers:
+     *    only for flat pathes, each column has one item in a record,
+     *    the items are valid until the next call. Do not mix with getNext
+     * @param items  one item for each query path, def 0 as missing column
+     * @return  <0 error code; ==0 EOF; 1 got
+     */
+    int32_t getNextItems(vector<ColumnItem> &items);
+
 private:
     /**
      * buffer more records from lower operator:
-     *    operator buffers more records by itself
+     *    operator buffers more records by itself,
+     *    the batch stops growing when the memory budget is pressured
      * @return >0 buffered record number; 0 EOF; <0 read error
      */
     int32_t bufferMore(void);
 
 
     /**
-     * double m_buf content capacity
+     * grow m_buf content capacity by Buffer growth policy
      * @return 0 success; <0 failed
      */
     int doubleBuffer(void);
 
     /**
-     * prepare ColumnReader for the record
+     * prepare ColumnReader for the record:
+     *    skip to the next selected record if filtered
      * @return 1 prepare success; 0 EOF; <0 failed;
      */
     int prepareColumnReader(void);
@@ -130,14 +180,22 @@ inline
 ColumnAssembler::~ColumnAssembler(void)
 {
     m_tree = nullptr;
-    delete m_buf;  m_buf = nullptr; 
     delete m_columns ; m_columns  = nullptr;
-    delete m_assemble; m_assemble = nullptr;
+    delete m_assemble; m_assemble = nullptr; // clears m_buf
+    delete m_flat    ; m_flat     = nullptr; // clears m_buf
+    delete m_buf;  m_buf = nullptr;
+    delete m_filter  ; m_filter   = nullptr;
+    for (auto & rd : m_col_rds) { delete rd; rd = nullptr; } // created by init
+    m_col_rds.clear();
     m_cur_recd_idx = 0;
+    m_recd_end   = UINT64_MAX;
+    m_offset     = 0;
+    m_limit      = UINT64_MAX;
     m_total_rnum = 0;
     m_next_rbgn  = 0;
     m_buf_rnum   = 0;
     m_dbl_buf    = false;
+    m_buf_max    = false;
 } // dtor 
 
 
@@ -151,18 +209,57 @@ int ColumnAssembler::init(QueryPathes *path, vector<ColumnReader*> &crd)
     m_columns->init(path, crd);              // app pathes
     m_columns->updateColumn(m_cur_recd_idx); // get current
 
-    // use current pathes to init assembler
+    // use current pathes to init assembler:
+    // pathes without repeated SchemaNode need no FSM
+    if (RecordFlatAssembler::isFlat(m_tree, path))
+    {
+        m_flat = new RecordFlatAssembler(m_buf, m_tree);
+        return m_flat->init(m_columns);
+    } // if
+
     m_assemble = new RecordNestedAssembler(m_buf, m_tree);
     return m_assemble->init(m_columns);
 } // init
 
 
 
+inline
+int ColumnAssembler::setRecordRange(uint64_t bgn, uint64_t end)
+{
+    if ((m_total_rnum > 0) || (m_buf_rnum > 0) || (bgn > end))
+    {
+        printf("ColumnAssembler: set record range [%lu, %lu) failed!\n", bgn, end);
+        return -1;
+    } // if
+
+    m_cur_recd_idx = bgn;
+    m_recd_end     = end;
+    return 0;
+} // setRecordRange
+
+
+
+inline
+int ColumnAssembler::setLimit(uint64_t offset, uint64_t limit)
+{
+    if ((m_total_rnum > 0) || (m_buf_rnum > 0))
+    {
+        puts("ColumnAssembler: set limit after reading failed!");
+        return -1;
+    } // if
+
+    m_offset = offset;
+    m_limit  = limit;
+    return 0;
+} // setLimit
+
+
+
 inline
 int32_t ColumnAssembler::doubleBuffer(void)
 {
-    uint64_t cap = m_buf->capacity();
-    return   m_buf->reserve(cap * 2);
+    uint64_t cap = m_buf->calcGrowCapacity(m_buf->capacity() + 1);
+    return  (cap == 0) ? -1 : m_buf->reserve(cap);
 } // doubleBuffer
 
 
@@ -41,24 +41,18 @@ int ColumnExpressionParser::parse(vector<string> &names, uint32_t idx)
 
     // parse key as SchemaNode
     int  got_num = 0; 
-    auto rng = m_tree->findNode(key.c_str(), psign);
-    if  (rng.first != rng.second)
+    vector<SchemaSignature> signs;
+    m_tree->findNodes(key.c_str(), psign, signs);
+    for (auto sign : signs)
     {
-        auto  cur  = rng.first, end = rng.second; 
-        while(cur != end)
-        {
-            SchemaSignature sign = cur->second;
-            int s = parseSchemaNode(sign, names, idx);
-            if (s < 0)
-            { 
-                printf("ColumnExpressionParser: parse by Schema failed!");
-                return -1;
-            } // if 
-            got_num += s;  
-
-            ++cur;
-        } // while  
-    } // if 
+        int s = parseSchemaNode(sign, names, idx);
+        if (s < 0)
+        { 
+            printf("ColumnExpressionParser: parse by Schema failed!");
+            return -1;
+        } // if 
+        got_num += s;  
+    } // for sign 
     return got_num;
 } // parse 
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file ColumnFilter.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   definitions and functions for ColumnFilter
+ */
+
+#include "Config.h"
+#include "Logger.h"
+#include "Utility.h"
+#include "ColumnFilter.h"
+
+
+
+namespace steed {
+
+
+
+int ColumnFilter::init(const string &dir, SchemaTree *tree, const string &cond)
+{
+    m_tree = tree;
+
+    string path, op, val;
+    if (splitCondition(cond, path, op, val) < 0)
+    {
+        printf("ColumnFilter: condition [%s] is not 'path op value'!\n", cond.c_str());
+        return -1;
+    } // if
+
+    auto it = DataType::s_data_cmp_tab.find(op);
+    m_cmp = (it == DataType::s_data_cmp_tab.cend()) ? DataType::s_cmp_invalid : it->second;
+    if ((m_cmp == DataType::s_cmp_invalid) || (m_cmp == DataType::s_cmp_like))
+    {
+        printf("ColumnFilter: compare operation [%s] is not supported!\n", op.c_str());
+        return -1;
+    } // if
+
+    // the path should be one leaf got in each record
+    vector<string>           names;
+    vector<ColumnExpression> exps;
+    ColumnExpressionParser   parser;
+    parser.init(m_tree, &exps);
+    Utility::splitString(path, Config::s_field_delim, names);
+    if ((parser.parse(names) <= 0) || (exps.size() != 1) ||
+        (m_tree->getRepeatedNumber(exps[0].getPath()) > 0))
+    {
+        printf("ColumnFilter: [%s] is not one leaf without repeated field!\n", path.c_str());
+        return -1;
+    } // if
+
+    m_dt   = exps[0].getDataType();
+    m_cst  = m_dt->trans2BinConst(val.c_str());
+    if (m_cst == nullptr)
+    {
+        printf("ColumnFilter: const [%s] is invalid for [%s]!\n", val.c_str(), path.c_str());
+        return -1;
+    } // if
+
+    m_read = new ColumnReader();
+    if (m_read->init2read(dir, m_tree, exps[0].getPath()) < 0)
+    {
+        puts("ColumnFilter: ColumnReader init2read failed!");
+        return -1;
+    } // if
+
+    m_sel = new BitMap(g_config.m_cab_recd_num / 8 + 1);
+    return 0;
+} // init
+
+
+
+int ColumnFilter::splitCondition(const string &cond, string &path, string &op, string &val)
+{
+    const char *blank = " \t";
+    uint64_t pbgn = cond.find_first_not_of(blank);
+    uint64_t pend = cond.find_first_of    (blank, pbgn);
+    uint64_t obgn = cond.find_first_not_of(blank, pend);
+    uint64_t oend = cond.find_first_of    (blank, obgn);
+    uint64_t vbgn = cond.find_first_not_of(blank, oend);
+    if (vbgn == string::npos) { return -1; }
+
+    uint64_t vend = cond.find_last_not_of (blank) + 1;
+    path = cond.substr(pbgn, pend - pbgn);
+    op   = cond.substr(obgn, oend - obgn);
+    val  = cond.substr(vbgn, vend - vbgn);
+    return 0;
+} // splitCondition
+
+
+
+int ColumnFilter::loadSelection(uint64_t ridx)
+{
+    int got = m_read->loadCAB4Record(ridx);
+    if (got <= 0)
+    {
+        if (got < 0) { STEED_LOG(error, "ColumnFilter: load CAB for [%lu] failed!", ridx); }
+        return got;
+    } // if
+
+    // one item for each record in the filter column
+    m_cab_rbgn = m_read->getCABReader()->getCABBeginRid();
+    m_cab_rnum = m_read->getCABItemNum();
+    if (m_cab_rnum == 0) { return 0; }
+
+    if (m_read->compareItems(m_cmp, m_cst, m_sel) < 0)
+    {
+        STEED_LOG(error, "ColumnFilter: compare CAB begins at [%lu] failed!", m_cab_rbgn);
+        return -1;
+    } // if
+
+    return 1;
+} // loadSelection
+
+
+
+} // namespace steed
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file   ColumnFilter.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   definitions and functions for ColumnFilter
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "BitMap.h"
+#include "DataType.h"
+
+#include "SchemaTree.h"
+#include "ColumnReader.h"
+
+#include "ColumnExpressionParser.h"
+
+
+
+namespace steed {
+
+using std::string;
+using std::vector;
+
+/**
+ * @class ColumnFilter
+ * @brief select records by comparing one column with a const
+ * @details
+ * The condition text is "path op value", such as "qty > 50" or
+ * 'item == "abc"'. The path should be one leaf without repeated SchemaNode,
+ * so each record has exactly one item in the column. The filter column is
+ * compared CAB by CAB into a selection BitMap before any projected column
+ * is read, then next() gives the selected record indexes one by one.
+ * The CABs without selected records are never loaded by the projections.
+ */
+class ColumnFilter {
+protected:
+    SchemaTree   *m_tree {nullptr}; /**< related SchemaTree    */
+    ColumnReader *m_read {nullptr}; /**< filter column reader  */
+    DataType     *m_dt   {nullptr}; /**< filter leaf DataType  */
+    const void   *m_cst  {nullptr}; /**< const binary value    */
+    int           m_cmp  {0};       /**< compare operation id  */
+
+    BitMap       *m_sel  {nullptr}; /**< selected items in CAB */
+    uint64_t      m_cab_rbgn {0};   /**< CAB record begin idx  */
+    uint64_t      m_cab_rnum {0};   /**< CAB record number     */
+
+    uint64_t      m_sel_num  {0};   /**< selected record num   */
+
+public:
+    ColumnFilter (void) = default;
+    ~ColumnFilter(void);
+
+public:
+    uint64_t getSelectedNum(void) { return m_sel_num; }
+
+    /**
+     * init filter to select records
+     * @param dir    directory of the binary values
+     * @param tree   SchemaTree of the table
+     * @param cond   condition text: "path op value"
+     * @return 0 success; <0 failed
+     */
+    int init(const string &dir, SchemaTree *tree, const string &cond);
+
+    /**
+     * move to the next selected record
+     * @param ridx   record index to begin, the selected one as result
+     * @return 1 got; 0 EOF; <0 failed
+     */
+    int next(uint64_t &ridx);
+
+protected:
+    /**
+     * split condition text into path, op and value
+     * @return 0 success; <0 failed
+     */
+    static int splitCondition(const string &cond, string &path, string &op, string &val);
+
+    /**
+     * load the CAB with the record and compare its items
+     * @param ridx   record index in CAB
+     * @return 1 success; 0 EOF; <0 failed
+     */
+    int loadSelection(uint64_t ridx);
+}; // ColumnFilter
+
+
+
+
+
+inline
+ColumnFilter::~ColumnFilter(void)
+{
+    delete m_read;  m_read = nullptr;
+    delete m_sel ;  m_sel  = nullptr;
+    free((void*)m_cst); m_cst = nullptr;
+
+    m_tree = nullptr;
+    m_dt   = nullptr;
+} // dtor
+
+
+
+inline
+int ColumnFilter::next(uint64_t &ridx)
+{
+    // no item before the column is valid
+    uint64_t valid = m_read->getValidRecdIdx();
+    if (ridx < valid) { ridx = valid; }
+
+    while (true)
+    {
+        bool loaded = (ridx >= m_cab_rbgn) && (ridx < m_cab_rbgn + m_cab_rnum);
+        if (!loaded)
+        {
+            int got = loadSelection(ridx);
+            if (got <= 0) { return got; }
+        } // if
+
+        uint64_t bi = (m_sel->getSetBitNum() == 0) ?
+            uint64_t(-1) : m_sel->getNextSetBit(ridx - m_cab_rbgn);
+        if (bi < m_cab_rnum)
+        {
+            ridx = m_cab_rbgn + bi;
+            ++m_sel_num;
+            return 1;
+        } // if
+
+        ridx = m_cab_rbgn + m_cab_rnum; // skip to the next CAB
+    } // while
+} // next
+
+
+
+} // namespace steed
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file ColumnOutput.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   definitions and functions for ColumnOutput
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ColumnOutput.h"
+
+
+
+namespace steed {
+
+
+
+const char ColumnOutput::s_magic[] = "STEEDCOL";
+
+
+
+ColumnOutput::ColumnOutput(SchemaTree *tree, QueryPathes *path, uint64_t cap):
+    m_tree(tree), m_batch_cap(cap == 0 ? 1 : cap)
+{
+    m_tbuf = new Buffer();
+
+    uint32_t pnum = path->size();
+    m_cols .resize(pnum);
+    m_names.resize(pnum);
+    for (uint32_t pi = 0; pi < pnum; ++pi)
+    {
+        SchemaPath  &sp = path->get(pi);
+        ColumnBatch &cb = m_cols[pi];
+        cb.m_dt   = m_tree->getDataType(sp.back());
+        cb.m_def  = sp.size();
+        cb.m_size = cb.m_dt->isFixedType() ? cb.m_dt->getDefSize() : 0;
+
+        string &name = m_names[pi];
+        for (uint32_t di = 0; di < sp.size(); ++di)
+        {
+            if (di > 0) { name.append(Config::s_field_delim); }
+            name.append(m_tree->getName(sp[di]));
+        } // for di
+    } // for pi
+} // ctor
+
+
+
+int ColumnOutput::outCSVHeader(OutputSink *sink, char delim)
+{
+    uint32_t cnum = m_names.size();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        if (ci > 0) { sink->put(delim); }
+        outCSVString(sink, m_names[ci].c_str(), delim);
+    } // for ci
+    sink->put('\n');
+    return sink->good() ? 0 : -1;
+} // outCSVHeader
+
+
+
+int ColumnOutput::outCSV2Sink(OutputSink *sink, vector<ColumnItem> &items, char delim)
+{
+    uint32_t cnum = m_cols.size();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        if (ci > 0) { sink->put(delim); }
+
+        ColumnBatch &cb = m_cols[ci];
+        if (!isValid(cb, items[ci])) { continue; } // empty field
+
+        const void *bin = items[ci].getBin();
+        if (cb.m_dt->getTypeID() == DataType::s_type_string)
+        {
+            uint64_t len = 0;
+            outCSVString(sink, unescape((const char*)bin, len), delim);
+            continue;
+        } // if
+
+        uint64_t len = m_tbuf->available();
+        char    *txt = (char*)m_tbuf->getNextPosition();
+        if (cb.m_dt->transBin2Txt(bin, txt, len) < 0)
+        {
+            printf("ColumnOutput: transBin2Txt [%s] failed!\n", m_names[ci].c_str());
+            return -1;
+        } // if
+        sink->write(txt);
+    } // for ci
+
+    sink->put('\n');
+    return sink->good() ? 0 : -1;
+} // outCSV2Sink
+
+
+
+void ColumnOutput::outCSVString(OutputSink *sink, const char *str, char delim)
+{
+    const char special[] = {delim, '"', '\n', '\r', '\0'};
+    if (strpbrk(str, special) == nullptr)
+    {   sink->write(str);   return;   }
+
+    // quote the field and double the quotes in it
+    sink->put('"');
+    for (const char *c = str; *c != '\0'; ++c)
+    {
+        if (*c == '"') { sink->put('"'); }
+        sink->put(*c);
+    } // for c
+    sink->put('"');
+} // outCSVString
+
+
+
+const char *ColumnOutput::unescape(const char *str, uint64_t &len)
+{
+    const char *esc = strchr(str, '\\');
+    if (esc == nullptr) { len = strlen(str); return str; }
+
+    m_str.assign(str, esc - str);
+    for (const char *c = esc; *c != '\0'; ++c)
+    {
+        if ((*c != '\\') || (c[1] == '\0')) { m_str.push_back(*c); continue; }
+
+        switch (*++c)
+        {
+            case 'b': m_str.push_back('\b'); break;
+            case 'f': m_str.push_back('\f'); break;
+            case 'n': m_str.push_back('\n'); break;
+            case 'r': m_str.push_back('\r'); break;
+            case 't': m_str.push_back('\t'); break;
+            case 'u':
+            {
+                // \uXXXX to UTF-8, surrogate pairs are kept as they are
+                char  hex[5] = {0};
+                char *end    = nullptr;
+                strncpy(hex, c + 1, 4);
+                uint32_t cp  = strtoul(hex, &end, 16);
+                if ((end != hex + 4) || ((cp >= 0xD800) && (cp < 0xE000)))
+                {   m_str.push_back('\\'); m_str.push_back('u'); break;   }
+
+                if (cp < 0x80) { m_str.push_back(char(cp)); }
+                else if (cp < 0x800)
+                {
+                    m_str.push_back(char(0xC0 | (cp >> 6)));
+                    m_str.push_back(char(0x80 | (cp & 0x3F)));
+                }
+                else
+                {
+                    m_str.push_back(char(0xE0 | (cp >> 12)));
+                    m_str.push_back(char(0x80 | ((cp >> 6) & 0x3F)));
+                    m_str.push_back(char(0x80 | (cp & 0x3F)));
+                } // if
+                c += 4;
+                break;
+            } // case
+            default : m_str.push_back(*c); break; // '"', '\\' and '/'
+        } // switch
+    } // for c
+
+    len = m_str.size();
+    return m_str.c_str();
+} // unescape
+
+
+
+int ColumnOutput::outBinHeader(OutputSink *sink)
+{
+    uint32_t ver  = s_version;
+    uint32_t cnum = m_cols.size();
+    sink->write(s_magic, sizeof(s_magic) - 1);
+    sink->write(&ver , sizeof(ver ));
+    sink->write(&cnum, sizeof(cnum));
+
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        uint32_t tid  = m_cols[ci].m_dt->getTypeID();
+        uint32_t nlen = m_names[ci].size();
+        sink->write(&tid , sizeof(tid ));
+        sink->write(&nlen, sizeof(nlen));
+        sink->write(m_names[ci].data(), nlen);
+    } // for ci
+
+    return sink->good() ? 0 : -1;
+} // outBinHeader
+
+
+
+int ColumnOutput::appendBin(OutputSink *sink, vector<ColumnItem> &items)
+{
+    uint64_t ri   = m_batch_num;
+    uint32_t cnum = m_cols.size();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        ColumnBatch &cb  = m_cols[ci];
+        bool       valid = isValid(cb, items[ci]);
+        const char *bin  = (const char*)items[ci].getBin();
+
+        if (ri % 64 == 0) { cb.m_valid.emplace_back(0); }
+        if (valid) { cb.m_valid.back() |= (uint64_t(1) << (ri % 64)); }
+
+        if (cb.m_size > 0)
+        {
+            uint64_t used = cb.m_data.size();
+            cb.m_data.resize(used + cb.m_size, 0);
+            if (valid) { memcpy(&cb.m_data[used], bin, cb.m_size); }
+        }
+        else
+        {
+            if (cb.m_offs.empty()) { cb.m_offs.emplace_back(0); }
+            if (valid)
+            {
+                uint64_t blen = cb.m_dt->getBinSize(bin);
+                if (cb.m_dt->getTypeID() == DataType::s_type_string)
+                {   bin = unescape(bin, blen);   }
+                cb.m_data.insert(cb.m_data.end(), bin, bin + blen);
+            } // if
+            cb.m_offs.emplace_back(int32_t(cb.m_data.size()));
+        } // if
+    } // for ci
+
+    return (++m_batch_num < m_batch_cap) ? 0 : outBatch(sink);
+} // appendBin
+
+
+
+int ColumnOutput::outBatch(OutputSink *sink)
+{
+    sink->write(&m_batch_num, sizeof(m_batch_num));
+    for (auto &cb : m_cols)
+    {
+        outBuffer(sink, cb.m_valid.data(), cb.m_valid.size() * sizeof(uint64_t));
+        if (cb.m_size == 0)
+        {   outBuffer(sink, cb.m_offs.data(), cb.m_offs.size() * sizeof(int32_t));   }
+        outBuffer(sink, cb.m_data.data(), cb.m_data.size());
+
+        cb.m_valid.clear();
+        cb.m_data .clear();
+        cb.m_offs .clear();
+    } // for cb
+
+    m_batch_num = 0;
+    return sink->good() ? 0 : -1;
+} // outBatch
+
+
+
+} // namespace steed
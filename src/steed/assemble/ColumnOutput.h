@@ -0,0 +1,202 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file   ColumnOutput.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   output column items as CSV text or binary columnar batches
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+#include <string>
+
+#include "Config.h"
+#include "Buffer.h"
+#include "OutputSink.h"
+#include "DataType.h"
+#include "ColumnItem.h"
+#include "SchemaTree.h"
+#include "QueryPathes.h"
+
+
+namespace steed {
+
+using std::string;
+using std::vector;
+
+extern Config g_config;
+
+
+/**
+ * @class ColumnOutput
+ * @brief output the column items got by ColumnAssembler::getNextItems
+ * @details
+ * CSV/TSV: a header line with the path names, then one line each record.
+ * Missing values are empty fields, strings are quoted only when needed.
+ * Strings are stored with JSON escapes, which are decoded in both formats.
+ *
+ * Binary columnar: the buffers of each column follow the Arrow layout,
+ * all little endian and padded to 8 bytes, each led by its byte length:
+ *   header : "STEEDCOL" u32 version, u32 column number,
+ *            then for each column u32 type id, u32 name length, name
+ *   batch  : u64 record number, then for each column
+ *            validity bitmap (LSB first, 1 as valid),
+ *            fixed types: values with 0 for nulls,
+ *            string     : i32 offsets (record number + 1) and chars
+ *   end    : u64 record number 0
+ */
+class ColumnOutput {
+protected:
+    class ColumnBatch {
+    public:
+        DataType         *m_dt   {nullptr}; /**< column DataType     */
+        uint32_t          m_def  {0};       /**< def of leaf value   */
+        int               m_size {0};       /**< fixed size; 0 var   */
+        vector<uint64_t>  m_valid{};        /**< validity bitmap     */
+        vector<char>      m_data {};        /**< values or chars     */
+        vector<int32_t>   m_offs {};        /**< var value offsets   */
+    }; // ColumnBatch
+
+    SchemaTree           *m_tree {nullptr}; /**< related SchemaTree  */
+    vector<string>        m_names{};        /**< column path names   */
+    vector<ColumnBatch>   m_cols {};        /**< column batches      */
+    uint64_t              m_batch_num{0};   /**< records in batch    */
+    uint64_t              m_batch_cap{0};   /**< records each batch  */
+    Buffer               *m_tbuf {nullptr}; /**< buffer value text   */
+    string                m_str  {};        /**< unescaped string    */
+
+public:
+    static const char     s_magic[];         /**< binary file magic   */
+    static const uint32_t s_version{1};      /**< binary file version */
+
+public:
+    ~ColumnOutput(void);
+
+    /**
+     * ctor
+     * @param tree   SchemaTree of the pathes
+     * @param path   flat query pathes, in the order of the items
+     * @param cap    record number in each binary batch
+     */
+    ColumnOutput (SchemaTree *tree, QueryPathes *path, uint64_t cap = g_config.m_recd_cap);
+
+public:
+    /**
+     * output the path names as CSV header
+     * @param sink   output sink ins
+     * @param delim  field delimiter, ',' or '\t'
+     * @return 0 success; <0 failed
+     */
+    int outCSVHeader(OutputSink *sink, char delim);
+
+    /**
+     * output one record as a CSV line
+     * @param sink   output sink ins
+     * @param items  column items of the record
+     * @param delim  field delimiter, ',' or '\t'
+     * @return 0 success; <0 failed
+     */
+    int outCSV2Sink (OutputSink *sink, vector<ColumnItem> &items, char delim);
+
+public:
+    /**
+     * output binary columnar header
+     * @param sink   output sink ins
+     * @return 0 success; <0 failed
+     */
+    int outBinHeader(OutputSink *sink);
+
+    /**
+     * append one record to the batch, output the batch when it is full
+     * @param sink   output sink ins
+     * @param items  column items of the record
+     * @return 0 success; <0 failed
+     */
+    int appendBin   (OutputSink *sink, vector<ColumnItem> &items);
+
+    /**
+     * output the last batch and the end mark
+     * @param sink   output sink ins
+     * @return 0 success; <0 failed
+     */
+    int outBinFooter(OutputSink *sink);
+
+protected:
+    /** output the buffered batch and clear it */
+    int  outBatch(OutputSink *sink);
+
+    /** output a CSV string field, quoted if it has delim, quote or newline */
+    void outCSVString(OutputSink *sink, const char *str, char delim);
+
+    /**
+     * decode the JSON escapes in string bin value
+     * @param str    string bin value
+     * @param len    string length as result, without '\0'
+     * @return decoded string begin, str itself without any escape
+     */
+    const char *unescape(const char *str, uint64_t &len);
+
+    /** output a buffer led by its byte length and padded to 8 bytes */
+    void outBuffer   (OutputSink *sink, const void *bgn, uint64_t len);
+
+    /** check item has the leaf value */
+    static bool isValid(ColumnBatch &cb, ColumnItem &ci)
+    { return (ci.getDef() >= cb.m_def) && (ci.getBin() != nullptr); }
+}; // ColumnOutput
+
+
+
+
+
+inline
+ColumnOutput::~ColumnOutput(void)
+{
+    delete m_tbuf;  m_tbuf = nullptr;
+    m_tree = nullptr;
+} // dtor
+
+
+
+inline
+int ColumnOutput::outBinFooter(OutputSink *sink)
+{
+    if ((m_batch_num > 0) && (outBatch(sink) < 0)) { return -1; }
+
+    uint64_t end = 0;
+    sink->write(&end, sizeof(end));
+    return sink->good() ? 0 : -1;
+} // outBinFooter
+
+
+
+inline
+void ColumnOutput::outBuffer(OutputSink *sink, const void *bgn, uint64_t len)
+{
+    static const char pad[8] = {0};
+    sink->write(&len, sizeof(len));
+    sink->write(bgn , len);
+    sink->write(pad , (8 - len % 8) % 8);
+} // outBuffer
+
+} // namespace steed
@@ -81,6 +81,38 @@ void FSMTable::initCommonLevel(SchemaTree * tree, QueryPathes &path)
 
 
 
+void FSMTable::initLevelTables(QueryPathes &path)
+{
+    uint32_t cnum = m_column_num;
+    if (cnum > s_max_tab_cols) { return; } // loop on the neighbours instead
+
+    m_com_rep_tab .assign(cnum * cnum, 0);
+    m_low_same_tab.assign(cnum * cnum, 0);
+    for (uint32_t tgt = 0; tgt < cnum; ++tgt)
+    {
+        SchemaPath &tsp = path[tgt];
+        uint32_t    row = tgt * cnum;
+        uint32_t    rep = m_tree->getLowestRepeatedNodeIndex(tsp) + 1;
+        uint32_t    low = tsp.size();
+        m_com_rep_tab [row + tgt] = rep;
+        m_low_same_tab[row + tgt] = low;
+
+        // level(a, ..., c) === min( level(a, b), level(b, ..., c) )
+        rep = low = uint32_t(-1);
+        for (uint32_t cur = tgt - 1; cur != uint32_t(-1); --cur)
+        {
+            rep = std::min(rep, m_com_rep_lvl [cur]);
+            low = std::min(low, m_low_same_lvl[cur]);
+            m_com_rep_tab [row + cur] = m_com_rep_tab [cur * cnum + tgt] = rep;
+            m_low_same_tab[row + cur] = m_low_same_tab[cur * cnum + tgt] = low;
+        } // for cur 
+    } // for tgt 
+} // initLevelTables
+
+
+
+
+
 int FSMTable::initTransTable(QueryPathes &path, vector< vector<uint32_t> > &trans)
 {
     // alloc space for each SchemaPath in QueryPathes
@@ -68,10 +68,23 @@ public:
      */
     vector<uint32_t>  m_com_rep_lvl{};
 
+    /**
+     * level tables between any 2 columns, precomputed by the above:
+     *   m_com_rep_tab [i * m_column_num + j] === common repetition level 
+     *   m_low_same_tab[i * m_column_num + j] === the lowest same level 
+     * both are symmetric, empty if columns are more than s_max_tab_cols
+     */
+    vector<uint32_t>  m_com_rep_tab {};
+    vector<uint32_t>  m_low_same_tab{};
+
     uint32_t         *m_fsm_table {nullptr}; /**< transition array content   */
     uint32_t          m_column_num{0};       /**< column number in FSM table */
     uint32_t          m_max_size  {0};       /**< max size in all SchemaPath */
 
+public:
+    /** max column number to precompute level tables: 2 x 4MB */
+    static const uint32_t s_max_tab_cols = 1024;
+
 public:
     FSMTable (void) = default; 
     ~FSMTable(void) { uninit(); }
@@ -100,6 +113,12 @@ protected:
      */
     void initCommonLevel(SchemaTree * tree, QueryPathes &path);
 
+    /**
+     * init level tables between any 2 columns 
+     * @param path    assemble related SchemaPathes in QueryPathes 
+     */
+    void initLevelTables(QueryPathes &path);
+
     /**
      * init QueryPathes in FSMTable 
      * @param path    assemble related QueryPathes in QueryPathes 
@@ -167,6 +186,7 @@ int FSMTable::init(SchemaTree * tree, QueryPathes &path)
 {
     m_tree = tree;
     initCommonLevel(tree, path); 
+    initLevelTables(path);
 
     /**
      * FSM transition table in vector
@@ -193,6 +213,8 @@ void FSMTable::uninit(void)
     m_pathes      .clear();
     m_low_same_lvl.clear();
     m_com_rep_lvl .clear();
+    m_com_rep_tab .clear();
+    m_low_same_tab.clear();
 
     free (m_fsm_table);
     m_fsm_table  = nullptr;
@@ -206,6 +228,9 @@ inline
 uint32_t FSMTable::getCommonReptLevel(uint32_t tgt, SchemaPath &tsp, uint32_t cur)
 {
     // NOTE: tgt >= cur 
+    if (!m_com_rep_tab.empty())
+    {   return m_com_rep_tab[tgt * m_column_num + cur];   }
+
     uint32_t rep_lvl = uint32_t(-1);
     if (tgt == cur)
     {
@@ -231,6 +256,9 @@ uint32_t FSMTable::getCommonReptLevel(uint32_t tgt, SchemaPath &tsp, uint32_t cu
 inline
 uint32_t FSMTable::getLowestSameLevel(uint32_t tgt, SchemaPath &tsp, uint32_t cur)
 {
+    if (!m_low_same_tab.empty())
+    {   return m_low_same_tab[tgt * m_column_num + cur];   }
+
     if (tgt == cur)
     {
         return tsp.size();
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file RecordFlatAssembler.cpp
+ * @author  Zhiyi Wang <wangzhiyi@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   definitions and functions for RecordFlatAssembler
+ */
+
+#include "RecordFlatAssembler.h"
+
+
+
+namespace steed {
+
+
+
+int RecordFlatAssembler::reinit(AssembleColumn *cols)
+{
+    m_path = cols->getCurrentPathes ();
+    m_crds = cols->getCurrentColRead();
+
+    m_ids    .clear();
+    m_dts    .clear();
+    m_fix_len.clear();
+    m_ret_lvl.clear();
+    m_top = true;
+
+    uint32_t cnum = m_path->size();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        SchemaPath     &sp = m_path->get(ci);
+        SchemaSignature lf = sp.back();
+        DataType       *dt = m_tree->getDataType(lf);
+        m_ids    .emplace_back(m_tree->getFieldID(lf));
+        m_dts    .emplace_back(dt);
+        m_fix_len.emplace_back(dt->isFixedType() ? dt->getDefSize() : 0);
+        m_top = m_top && (sp.size() == 1);
+
+        // return to the lowest same level of the next, the root after the last
+        bool     last = (ci + 1 == cnum);
+        uint32_t rlvl = last ? 0 : SchemaPath::getLowestSameLevel(sp, m_path->get(ci + 1));
+        m_ret_lvl.emplace_back(rlvl);
+    } // for ci
+
+    return 0;
+} // reinit
+
+
+
+int RecordFlatAssembler::assemble(void)
+{
+    void *   recd_bgn   = m_buf->getNextPosition();
+    uint64_t before_use = m_buf->used();
+
+    int got = m_top ? assembleTop() : assembleNested();
+    if (got <= 0) { return got; }
+
+    uint64_t recd_used = m_buf->used() - before_use;
+    uint32_t recd_size = *(uint32_t*)recd_bgn;
+    if (recd_used != recd_size)
+    {
+        puts  ("RecordFlatAssembler: assemble error!");
+        printf("buffer used:[%lu] record size:[%u]\n", recd_used, recd_size);
+        m_buf->output2debug();
+        abort();
+    } // if
+
+    return 1;
+} // assemble
+
+
+
+int RecordFlatAssembler::assembleTop(void)
+{
+    ColumnItem citm; // ColumnItem to read
+    uint32_t   cnum = m_crds.size();
+    uint64_t   bgn  = m_buf->used();
+    m_root->init();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        int s = m_crds[ci]->readItem(citm);
+        if (s <= 0)
+        {
+            if (s < 0) { printf("RecordFlatAssembler: read from [%u] failed!\n", ci); }
+            m_buf ->deallocate(m_buf->used() - bgn);
+            m_root->clear();
+            return s;
+        } // if
+
+        // def is 0 for nothing or 1 for the value
+        if (citm.getDef() == 0) { continue; }
+
+        int blen = copyValue(ci, citm);
+        if (blen < 0)
+        {
+            puts("RecordFlatAssembler: copyValue failed!");
+            m_buf ->deallocate(m_buf->used() - bgn);
+            m_root->clear();
+            return -1;
+        } // if
+        m_root->appendElem (m_ids[ci]);
+        m_root->appendValue(blen);
+    } // for ci
+
+    uint32_t used = m_root->package();
+    m_root->clear();
+    return (used == uint32_t(-1)) ? -1 : 1;
+} // assembleTop
+
+
+
+int RecordFlatAssembler::assembleNested(void)
+{
+    ColumnItem citm; // ColumnItem to read
+    uint32_t   cnum = m_crds.size();
+    m_build->begin2build();
+    for (uint32_t ci = 0; ci < cnum; ++ci)
+    {
+        SchemaPath &sp = m_path->get(ci);
+        int s = m_crds[ci]->readItem(citm);
+        if (s <= 0)
+        {
+            if (s < 0) { printf("RecordFlatAssembler: read from [%u] failed!\n", ci); }
+            m_build->erase();
+            return s;
+        } // if
+
+        uint32_t def = citm.getDef();
+        if (m_build->move2level(def, sp, false) < 0)
+        {
+            printf("RecordFlatAssembler: move2level failed!\n");
+            m_build->erase();
+            return -1;
+        } // move2level
+
+        if (def == sp.size())
+        {
+            int blen = copyValue(ci, citm);
+            if (blen < 0)
+            {
+                puts("RecordFlatAssembler: copyValue failed!");
+                m_build->erase();
+                return -1;
+            } // if
+            m_build->appendLeafValue(blen);
+        } // if
+
+        m_build->return2level(m_ret_lvl[ci], sp, false);
+    } // for ci
+
+    m_build->end2build();
+    return 1;
+} // assembleNested
+
+
+
+} // namespace
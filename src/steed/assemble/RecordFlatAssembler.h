@@ -0,0 +1,188 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file   RecordFlatAssembler.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   definitions and functions for RecordFlatAssembler
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Buffer.h"
+
+#include "RecordBuilder.h"
+
+#include "SchemaSignature.h"
+#include "SchemaTree.h"
+#include "AssembleColumn.h"
+
+
+
+namespace steed {
+
+using std::vector;
+
+/**
+ * @class RecordFlatAssembler
+ * @brief assemble the pathes without any repeated SchemaNode
+ * @details
+ * Each column has exactly one item in a record, so the columns are read
+ * one by one in path order and no FSMTable is needed. The levels to return
+ * between neighbouring columns are got at reinit. If all pathes are top
+ * level fields, the values are appended to the root object directly;
+ * otherwise RecordBuilder nests the objects with the same binary layout
+ * as RecordNestedAssembler.
+ */
+class RecordFlatAssembler {
+protected:
+    Buffer                *m_buf  {nullptr}; /**< Buffer 4 assembled row    */
+    SchemaTree            *m_tree {nullptr}; /**< related SchemaTree ins    */
+
+    QueryPathes           *m_path {nullptr}; /**< assemble query pathes     */
+    vector<ColumnReader*>  m_crds {};        /**< ColumnReader to get items */
+
+    Row::RecordBuilder    *m_build{nullptr}; /**< Row layout builder        */
+    Row::RowObjectBuilder *m_root {nullptr}; /**< root object of top fields */
+
+    vector<Row::ID>        m_ids     {};     /**< leaf field id per column  */
+    vector<DataType*>      m_dts     {};     /**< leaf DataType per column  */
+    vector<int>            m_fix_len {};     /**< fixed bin size; 0 var len */
+    vector<uint32_t>       m_ret_lvl {};     /**< level to return after col */
+    bool                   m_top {true};     /**< all pathes in top level   */
+
+public:
+    /**
+     * ctor
+     * @param buf   Buffer for assembled binary row
+     * @param t     SchemaTree used    to assemble
+     */
+    RecordFlatAssembler (Buffer *buf, SchemaTree *t): m_buf(buf), m_tree(t) {}
+    ~RecordFlatAssembler(void);
+
+public:
+    /**
+     * check all pathes have no repeated SchemaNode
+     * @param t     SchemaTree of the pathes
+     * @param path  pathes to assemble
+     * @return true if RecordFlatAssembler can assemble them
+     */
+    static bool isFlat(SchemaTree *t, QueryPathes *path);
+
+public:
+    /**
+     * init assembler to assemble
+     * @param cols  AssembleColumn with current pathes and readers
+     */
+    int  init  (AssembleColumn *cols);
+
+    /**
+     * reinit assembler to assemble: assemble columns are changed
+     * @param cols  AssembleColumn with current pathes and readers
+     */
+    int  reinit(AssembleColumn *cols);
+
+    /**
+     * assemble column items to binary row layout
+     * @return 1 assmble num; ==0 EOF; <0 failed
+     */
+    int assemble(void);
+
+protected:
+    /** append the top level fields to the root object */
+    int assembleTop   (void);
+
+    /** nest the objects on pathes by RecordBuilder */
+    int assembleNested(void);
+
+    /**
+     * copy the leaf value in item to buffer
+     * @return binary value length; <0 failed
+     */
+    int copyValue(uint32_t cidx, ColumnItem &citm);
+}; // RecordFlatAssembler
+
+
+
+
+
+
+
+
+
+
+inline
+RecordFlatAssembler::~RecordFlatAssembler(void)
+{
+    m_tree = nullptr;  m_path = nullptr;
+
+    m_crds.clear()  ;
+    m_buf->clear()  ;  m_buf  = nullptr;
+
+    delete m_build  ;  m_build= nullptr;
+    delete m_root   ;  m_root = nullptr;
+} // dtor
+
+
+
+inline
+bool RecordFlatAssembler::isFlat(SchemaTree *t, QueryPathes *path)
+{
+    uint32_t pnum = path->size();
+    for (uint32_t pi = 0; pi < pnum; ++pi)
+    {
+        if (t->getRepeatedNumber(path->get(pi)) > 0)
+        {   return false;   }
+    } // for pi
+    return true;
+} // isFlat
+
+
+
+inline
+int  RecordFlatAssembler::init  (AssembleColumn *cols)
+{
+    uint32_t max_depth = cols->getMaxDepth();
+    m_build = new Row::RecordBuilder(m_tree, m_buf, max_depth);
+    m_root  = new Row::RowObjectBuilder(m_buf);
+
+    return reinit(cols);
+} // init
+
+
+
+inline
+int RecordFlatAssembler::copyValue(uint32_t cidx, ColumnItem &citm)
+{
+    const void *src  = citm.getBin();
+    int         blen = m_fix_len[cidx];
+    if (blen == 0) { blen = m_dts[cidx]->getBinSize(src); }
+
+    void *dest = m_buf->allocate(blen, false);
+    if   (dest == nullptr) { return -1; }
+    memcpy(dest, src, blen);
+    return blen;
+} // copyValue
+
+
+
+} // namespace steed
@@ -35,7 +35,7 @@ namespace steed {
 int RecordNestedAssembler::assemble(void)
 {
     void *   recd_bgn   = m_buf->getNextPosition();
-    uint32_t before_use = m_buf->used();
+    uint64_t before_use = m_buf->used();
 
 
     int s = 0;       // state
@@ -122,13 +122,13 @@ int RecordNestedAssembler::assemble(void)
     } // while
 
 
-    uint32_t after_used = m_buf->used();
-    uint32_t recd_used  = after_used - before_use;  
+    uint64_t after_used = m_buf->used();
+    uint64_t recd_used  = after_used - before_use;  
     uint32_t recd_size  = *(uint32_t*)recd_bgn;
     if (recd_used != recd_size)
     {
         puts  ("RecordNestedAssembler: assemble error!");
-        printf("buffer used:[%u] record size:[%u]\n", recd_used, recd_size);
+        printf("buffer used:[%lu] record size:[%u]\n", recd_used, recd_size);
         m_buf->output2debug();
         abort();
     } // if 
@@ -31,11 +31,11 @@ namespace steed {
 
 
 int RecordOutput::
-    outJSONArr2Strm(ostream *ostrm, char *bgn, uint32_t lvl, SchemaSignature ss)
+    outJSONArr2Sink(OutputSink *sink, char *bgn, uint32_t lvl, SchemaSignature ss)
 {
     assert(lvl < m_lvl_exp.size());
 
-    (*ostrm) << '[';
+    sink->put('[');
     
     RowArrayOperator &arr_op = m_lvl_exp[lvl].m_arr;
     arr_op.init2read (bgn);
@@ -46,12 +46,12 @@ int RecordOutput::
     while   (i < num)
     {
         if (comma) 
-        {   (*ostrm) << ',';   }
+        {   sink->put(',');   }
 
         bool empty = (arr_op.getBinSize(i) == 0);
         if  (empty)
         {
-            (*ostrm) << (leaf ? "null" : "{}"); 
+            sink->write(leaf ? "null" : "{}"); 
             comma = true, ++i;
             continue;
         } // if 
@@ -59,22 +59,24 @@ int RecordOutput::
         char *bin = (char*)arr_op.getBinVal(i);
         if (leaf)
         {
-            // use but no need to allocate buffer content 
             DataType *dt  = m_tree->getDataType  (ss);
-            uint64_t  len = m_tbuf->available();
-            char     *txt = (char*)m_tbuf->getNextPosition();
-            if (dt->transBin2Txt(bin, txt, len) < 0)
+            int      vnum = outJSONValues2Sink(sink, dt, arr_op, i);
+            if (vnum > 0)
             {
-                puts("RecordOutput:: outJSONArr2Strm to transBin2Txt failed!\n");
+                comma = true, i += vnum;
+                continue;
+            } // if 
+
+            if ((vnum < 0) || (outJSONValue2Sink(sink, dt, bin) < 0))
+            {
+                puts("RecordOutput:: outJSONArr2Sink to outJSONValue2Sink failed!\n");
                 abort();
                 return -1;
             } // if 
-
-            (*ostrm) << txt; 
         }
-        else if (outJSONObj2Strm(ostrm, bin, lvl + 1, ss) < 0)
+        else if (outJSONObj2Sink(sink, bin, lvl + 1, ss) < 0)
         {
-            printf("RecordOutput::outJSONObj2Strm failed\n");
+            printf("RecordOutput::outJSONObj2Sink failed\n");
             return -1;
         } // if 
 
@@ -84,22 +86,22 @@ int RecordOutput::
     } // while  
     
     arr_op.uninit();
-    (*ostrm) << ']';
+    sink->put(']');
 
     return 0;    
-} // outJSONArr2Strm 
+} // outJSONArr2Sink 
 
 
 
 
 
 int RecordOutput::
-    outJSONObj2Strm(ostream *ostrm, char *bgn, uint32_t lvl, SchemaSignature ss)
+    outJSONObj2Sink(OutputSink *sink, char *bgn, uint32_t lvl, SchemaSignature ss)
 {
     (void) ss;
     assert(lvl < m_lvl_exp.size());
 
-    (*ostrm) << '{';
+    sink->put('{');
 
     RowObjectOperator &obj_op = m_lvl_exp[lvl].m_obj;
     obj_op.init2read  (bgn);
@@ -113,25 +115,27 @@ int RecordOutput::
         {   ++i; continue;   }
 
         if (comma) 
-        {   (*ostrm) << ',';   }
+        {   sink->put(',');   }
 
         char   *bin = (char*)obj_op.getBinVal(i);
         Row::ID         id = obj_op.getRowID (i);
         SchemaSignature ss = m_tree->getSignByID(id);
         if (!m_tree->isDefined(id))
         {
-            printf("RecordOutput::outJSONObj2Strm [%u] failed!\n", id);
+            printf("RecordOutput::outJSONObj2Sink [%u] failed!\n", id);
             return -1;
         } // if 
 
 
         // SchemaNode is defined in SchemaTree
         const string &key = m_tree->getName(ss);
-        (*ostrm)  << "\"" << key << "\"" << ":";
+        sink->put('"');
+        sink->write(key);
+        sink->write("\":", 2);
 
         if (m_tree->isRepeated(ss))
         {
-            if (outJSONArr2Strm(ostrm, bin, lvl, ss) < 0)
+            if (outJSONArr2Sink(sink, bin, lvl, ss) < 0)
             {
                 printf("RecordOutput::outArr4Debug failed\n");
                 return -1;
@@ -144,13 +148,13 @@ int RecordOutput::
                 // use but no need to allocate buffer content 
                 DataType *dt  = m_tree->getDataType  (ss);
 
-                if (outJSONValue2Strm(ostrm, dt, bin) < 0)
+                if (outJSONValue2Sink(sink, dt, bin) < 0)
                 {
-                    puts("RecordOutput::outJSONObj2Strm to outJSONValue2Strm failed!\n");
+                    puts("RecordOutput::outJSONObj2Sink to outJSONValue2Sink failed!\n");
                     return -1;
                 } // if 
             }
-            else if (outJSONObj2Strm(ostrm, bin, lvl + 1, ss) < 0)
+            else if (outJSONObj2Sink(sink, bin, lvl + 1, ss) < 0)
             {
                 printf("RecordOutput::outObj4Debug failed\n");
                 return -1;
@@ -163,10 +167,10 @@ int RecordOutput::
     } // while 
 
     obj_op.uninit();
-    (*ostrm) << '}';
+    sink->put('}');
 
     return 0;    
-} // outJSONObj2Strm
+} // outJSONObj2Sink
 
 
 
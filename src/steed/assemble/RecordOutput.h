@@ -33,6 +33,7 @@
 
 #include "Config.h"
 #include "Buffer.h"
+#include "OutputSink.h"
 #include "SchemaTree.h"
 #include "RowArrayOperator.h"
 #include "RowObjectOperator.h"
@@ -62,6 +63,11 @@ protected:
     vector<LevelReader>  m_lvl_exp    {}; /**< each reader level  */
     Buffer              *m_tbuf{nullptr}; /**< buffer value text  */
     SchemaTree          *m_tree{nullptr}; /**< relate SchemaTree  */
+    StreamSink          *m_ssink{nullptr};/**< sink for ostream   */
+
+public:
+    static const uint64_t s_fixed_txt{512}; /**< max fixed value text */
+    static const uint32_t s_batch_num{64};  /**< max values in a batch */
 
 public:
     ~RecordOutput(void);
@@ -69,7 +75,15 @@ public:
 
 public:
     /**
-     * output JSON records to ostream 
+     * output JSON records to OutputSink, the sink drains by batches
+     * @param sink   output sink ins
+     * @param recd   binary record begin position 
+     * @return 0 success; <0 failed 
+     */
+    int outJSON2Sink(OutputSink *sink, char* recd);
+
+    /**
+     * output JSON records to ostream, written once for each record
      * @param ostrm  output stream isn 
      * @param recd   binary record begin position 
      * @return 0 success; <0 failed 
@@ -78,33 +92,44 @@ public:
 
 protected:
     /**
-     * output binary arrays for debug
-     * @param ostrm  output stream ins  
+     * output binary arrays as JSON text
+     * @param sink   output sink ins
      * @param bgn    binary array begin  
      * @param lvl    nested level in record  
      * @param ss     SchemaNode's sign in SchemaTree 
      * @return 0 success; <0 failed 
      */
-    int outJSONArr2Strm(ostream *ostrm, char *bgn, uint32_t lvl, SchemaSignature ss); 
+    int outJSONArr2Sink(OutputSink *sink, char *bgn, uint32_t lvl, SchemaSignature ss); 
 
     /**
-     * output binary object for debug
+     * output binary object as JSON text
+     * @param sink   output sink ins
      * @param bgn    binary array begin  
      * @param lvl    nested level in record  
      * @param ss     SchemaNode's sign in SchemaTree 
-     * @param num    nested number for output format
      * @return 0 success; <0 failed 
      */
-    int outJSONObj2Strm(ostream *ostrm, char *bgn, uint32_t lvl, SchemaSignature ss); 
+    int outJSONObj2Sink(OutputSink *sink, char *bgn, uint32_t lvl, SchemaSignature ss); 
 
     /**
-     * output text value to ostrm
-     * @param ostrm  output stream ins  
+     * output text value to sink, trans in place of the sink batch
+     * @param sink   output sink ins
      * @param dt     bin DataType ins 
      * @param bin    binary value begin 
      * @return 0 success; <0 failed 
      */
-    int outJSONValue2Strm(ostream *ostrm, DataType *dt, char *bin);
+    int outJSONValue2Sink(OutputSink *sink, DataType *dt, char *bin);
+
+    /**
+     * output contiguous fixed size array elements to sink in a batch
+     * @param sink   output sink ins
+     * @param dt     bin DataType ins 
+     * @param arr    binary array operator inited to read
+     * @param bgn    begin element index
+     * @return >0 output element number; 0 not batched; <0 failed
+     */
+    int outJSONValues2Sink(OutputSink *sink, DataType *dt,
+        RowArrayOperator &arr, uint32_t bgn);
 
 
 public:
@@ -152,6 +177,8 @@ protected:
 inline
 RecordOutput::~RecordOutput(void)
 {
+    delete m_ssink;
+    m_ssink = nullptr;
     delete m_tbuf;
     m_tbuf = nullptr;
     m_tree = nullptr;
@@ -168,31 +195,84 @@ RecordOutput::RecordOutput(SchemaTree *tree): m_tree(tree)
 
 
 
+inline
+int RecordOutput::outJSON2Sink(OutputSink *sink, char* recd)
+{
+    int got = outJSONObj2Sink(sink, recd, 0, SchemaSignature(0)); 
+    sink->put('\n');
+    return sink->good() ? got : -1;
+} // outJSON2Sink 
+
+
+
 inline
 int RecordOutput::outJSON2Strm(ostream *ostrm, char* recd)
 {
-    int got = outJSONObj2Strm(ostrm, recd, 0, SchemaSignature(0)); 
-    (*ostrm) << '\n';
-    return got;
+    if (m_ssink == nullptr) { m_ssink = new StreamSink(); }
+    m_ssink->setStream(ostrm);
+
+    int got = outJSON2Sink(m_ssink, recd);
+    return (m_ssink->flush() < 0) ? -1 : got;
 } // outJSON2Strm 
 
 
 
 inline
-int RecordOutput::outJSONValue2Strm(ostream *ostrm, DataType *dt, char *bin)
+int RecordOutput::outJSONValue2Sink(OutputSink *sink, DataType *dt, char *bin)
 {
-    uint64_t len = m_tbuf->available();
-    char    *txt = (char*)m_tbuf->getNextPosition();
-    if (dt->transBin2Txt(bin, txt, len) < 0)
+    // some types do not output '\0', stop at the returned length
+    uint64_t len = dt->isFixedType() ? s_fixed_txt : (dt->getBinSize(bin) + 2);
+    char    *txt = sink->reserve(len);
+    if (txt != nullptr)
+    {
+        int got = dt->transBin2Txt(bin, txt, len);
+        if (got >= 0) { sink->commit(strnlen(txt, got)); return 0; }
+    } // if
+
+    // too long for the sink batch
+    len = m_tbuf->available();
+    txt = (char*)m_tbuf->getNextPosition();
+    int got = dt->transBin2Txt(bin, txt, len);
+    if (got < 0)
     {
-        puts("RecordOutput:: outArr4Debug to transBin2Txt failed!\n");
+        puts("RecordOutput:: outJSONValue2Sink to transBin2Txt failed!\n");
         return -1;
     } // if 
 
-    (*ostrm) << txt; 
+    return sink->write(txt, strnlen(txt, got));
+} // outJSONValue2Sink
+
+
+
+inline
+int RecordOutput::outJSONValues2Sink(OutputSink *sink, DataType *dt,
+    RowArrayOperator &arr, uint32_t bgn)
+{
+    int fix = dt->getDefSize();
+    if (fix <= 0) { return 0; } // var size values one by one
+
+    uint32_t num = arr.getElemNum();
+    uint32_t max = (num - bgn > s_batch_num) ? (bgn + s_batch_num) : num;
+    uint32_t end = bgn;
+    while ((end < max) && (arr.getBinSize(end) == uint32_t(fix)) &&
+           ((end == bgn) || (arr.getOffset(end) == arr.getOffset(end - 1) + fix)))
+    {   ++end;   }
+    if (end - bgn < 2) { return 0; }
+
+    uint64_t len = (end - bgn) * (s_fixed_txt + 1);
+    char    *txt = sink->reserve(len);
+    if (txt == nullptr) { return 0; } // too long for the sink batch
+
+    int64_t  got = dt->transBin2Txts(arr.getBinVal(bgn), end - bgn, txt, len, ',');
+    if (got < 0)
+    {
+        puts("RecordOutput:: outJSONValues2Sink to transBin2Txts failed!");
+        return -1;
+    } // if 
 
-    return 0;
-} // outJSONValue2Strm
+    sink->commit(uint64_t(got));
+    return int(end - bgn);
+} // outJSONValues2Sink
 
 
 } // namespace
@@ -75,7 +75,7 @@ public:
     virtual int64_t  resizeElemUsed(uint64_t num)         = 0;
 
     virtual const void *getOffsetBegin     (void) = 0;
-    virtual void     setBeginOffset(uint32_t off) = 0;
+    virtual void     setBeginOffset(uint64_t off) = 0;
     virtual uint64_t getOffsetSize         (void) = 0;
     virtual uint64_t getOffsetArrayUsed    (void) = 0;
 
@@ -188,7 +188,7 @@ public:
     int64_t     resizeElemUsed        (uint64_t num) override
     { m_val_num = num; return int64_t(m_val_num * m_length); }
 
-    void        setBeginOffset(uint32_t off) override
+    void        setBeginOffset(uint64_t off) override
     { (void)off; assert(m_val_num == 0); }
     const void *getOffsetBegin        (void) override { return nullptr; }
     uint64_t    getOffsetSize         (void) override { return 0; }
@@ -261,8 +261,8 @@ public:
     { m_val_num = num; return int64_t(m_val_num * s_offset_size); }
 
 
-    void        setBeginOffset(uint32_t off) override
-    {   assert(m_val_num ==0); m_cur_off = off;   }
+    void        setBeginOffset(uint64_t off) override
+    {   assert(m_val_num ==0); assert(off < s_invalid_off); m_cur_off = uint32_t(off);   }
 
     const void *getOffsetBegin        (void) override { return m_offsets    ; }
     uint64_t    getOffsetSize         (void) override { return s_offset_size; }
@@ -291,6 +291,15 @@ protected:
      */
     int  trans2Bin(const char *txt, const void* &bin);
 
+    /**
+     * check the offset is able to hold len more bytes:
+     *   value content in CAB is limited to 4GB by 32-bit offsets
+     * @param len    bytes number to write 
+     * @return true offset overflow; false not overflow
+     */
+    bool isOffsetOverflow(uint64_t len)
+    {   return len >= uint64_t(s_invalid_off - m_cur_off);   }
+
 public:
     int64_t appendOffsets(Buffer *buf) override;
     int64_t appendValues (Buffer *buf) override;
@@ -374,6 +374,12 @@ int VarLengthValueArray::writeText(const char *txt, const void* &bin)
         } // if 
     } // if
 
+    if (isOffsetOverflow(used))
+    {
+        printf("VarLengthValueArray: offset overflow [%u]!\n", m_cur_off);
+        return -1;
+    } // if 
+
     // already written  
     m_cur_buf->allocate(used, false); 
 
@@ -391,6 +397,12 @@ int VarLengthValueArray::writeBinVal(uint64_t len, const void *bin)
 {
     if (m_val_num == m_val_cap) { return 0; }  // full 
 
+    if (isOffsetOverflow(len))
+    {
+        printf("VarLengthValueArray: offset overflow [%u]!\n", m_cur_off);
+        return -1;
+    } // if 
+
     uint64_t  avail = m_cur_buf->available();
     if (len > avail)
     {
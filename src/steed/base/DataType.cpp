@@ -113,6 +113,96 @@ DTCompareFP DataType::getCompareFunc(int cmp_op_id)
 
 
 
+int64_t DataType::transTxt2Bins(const char *const *txts, uint64_t num,
+    void *bins, uint64_t size)
+{
+    int      fix  = getDefSize();
+    char    *bin  = (char*)bins;
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        int got = transTxt2Bin(txts[i], bin + used, size - used);
+        if ((got == 0) && (fix > 0) && (used + fix <= size))
+        {   fillNull(bin + used, 1); got = fix;   } // null value
+        if  (got <= 0) { return -1; }
+        used += got;
+    } // for i
+
+    return int64_t(used);
+} // transTxt2Bins
+
+
+
+int64_t DataType::transBin2Txts(const void *bins, uint64_t num,
+    char *txt, uint64_t size, char delim)
+{
+    const char *bin  = (const char*)bins;
+    uint64_t    used = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        if ((i > 0) && (used + 1 < size)) { txt[used++] = delim; }
+
+        // some types do not output '\0', stop at the used length
+        int got = transBin2Txt(bin, txt + used, size - used);
+        if (got < 0) { return -1; }
+        used += strnlen(txt + used, got);
+        bin  += getBinSize(bin);
+    } // for i
+
+    if (used >= size) { return -1; }
+    txt[used] = '\0';
+    return int64_t(used);
+} // transBin2Txts
+
+
+
+int64_t DataType::compareConst(int cmp_op_id, const void *bins, uint64_t num,
+    const void *cst, uint64_t *bits)
+{
+    DTCompareFP cfp = getCompareFunc(cmp_op_id);
+    if (cfp == nullptr) { return -1; }
+
+    const char *bin = (const char*)bins;
+    int64_t     cnt = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        if ((i % 64) == 0) { bits[i / 64] = 0; }
+
+        int got = (this->*cfp)(bin, cst);
+        if (got < 0) { return -1; }
+
+        bits[i / 64] |= (uint64_t(got > 0) << (i % 64));
+        cnt += (got > 0);
+        bin += getBinSize(bin);
+    } // for i
+
+    return cnt;
+} // compareConst
+
+
+
+int64_t DataType::updateMinMax(const void *bins, uint64_t num,
+    void *min, void *max, bool has)
+{
+    int fix = getDefSize();
+    if (fix <= 0) { return -1; } // fixed size only
+
+    const char *bin = (const char*)bins;
+    int64_t     cnt = 0;
+    for (uint64_t i = 0; i < num; ++i, bin += fix)
+    {
+        if (compareIsNull(bin) > 0) { continue; }
+
+        if (!has || (compareLess   (bin, min) > 0)) { copy(bin, min); }
+        if (!has || (compareGreater(bin, max) > 0)) { copy(bin, max); }
+        has = true, ++cnt;
+    } // for i
+
+    return cnt;
+} // updateMinMax
+
+
+
 /** bin null value */ 
 template<> const     int8_t  TypeNumeric<int8_t> ::s_null( INT8_MIN);
 template<> const     int16_t TypeNumeric<int16_t>::s_null(INT16_MIN); 
@@ -33,7 +33,10 @@
 #include <string.h>
 
 #include <vector>
+#include <limits>
 #include <iostream>
+#include <functional>
+#include <type_traits>
 
 #include "Allocator.h"
 #include "SymbolMap.h"
@@ -290,6 +293,58 @@ public: // compare related funcs
      * @return single compared single func for type ins
      */
     static DTCompareFP getCompareFunc(int cmp_op_id);
+
+
+public: // batch funcs: one virtual call for a batch of values
+    /**
+     * trans texts to binary values stored one by one
+     *   fixed size types write bin null for nullptr text
+     * @param txts   text values array
+     * @param num    text value number
+     * @param bins   binary values begin
+     * @param size   size available in bins
+     * @return <0 failed; >=0 num of bytes used
+     */
+    virtual int64_t transTxt2Bins(const char *const *txts, uint64_t num,
+        void *bins, uint64_t size);
+
+    /**
+     * trans binary values stored one by one to texts joined by delim
+     *   fixed size types output bin null as "null"
+     * @param bins   binary values begin
+     * @param num    binary value number
+     * @param txt    text content ended by '\0'
+     * @param size   size available in txt
+     * @param delim  delimiter between texts
+     * @return <0 failed; >=0 num of chars used without '\0'
+     */
+    virtual int64_t transBin2Txts(const void *bins, uint64_t num,
+        char *txt, uint64_t size, char delim);
+
+    /**
+     * compare binary values stored one by one with a const
+     *   fixed size types never set bits for bin null
+     * @param cmp_op_id  compared operation id
+     * @param bins       binary values begin
+     * @param num        binary value number
+     * @param cst        const got by trans2BinConst, trans2LikeConst ...
+     * @param bits       set bit for each true, (num + 63) / 64 words written
+     * @return <0 failed; >=0 true result number
+     */
+    virtual int64_t compareConst(int cmp_op_id, const void *bins, uint64_t num,
+        const void *cst, uint64_t *bits);
+
+    /**
+     * update min and max by binary values stored one by one, skip bin nulls
+     * @param bins   binary values begin
+     * @param num    binary value number
+     * @param min    min value to update
+     * @param max    max value to update
+     * @param has    min and max are valid before update
+     * @return <0 failed; >=0 non-null value number
+     */
+    virtual int64_t updateMinMax(const void *bins, uint64_t num,
+        void *min, void *max, bool has);
 }; // DataType
 
 
@@ -349,7 +404,43 @@ public: // single compare single funcs
     MACRO_COMPARE_FUNC(compareNotLess,    NT, >=)
     MACRO_COMPARE_FUNC(compareNotGreater, NT, <=)
     MACRO_COMPARE_FUNC(compareNotEqual,   NT, !=)
-}; // TypeNumeric 
+
+public: // batch funcs, inner loops without virtual calls
+    int64_t transTxt2Bins(const char *const *txts, uint64_t num,
+        void *bins, uint64_t size) override;
+    int64_t transBin2Txts(const void *bins, uint64_t num,
+        char *txt, uint64_t size, char delim) override;
+    int64_t compareConst (int cmp_op_id, const void *bins, uint64_t num,
+        const void *cst, uint64_t *bits) override;
+    int64_t updateMinMax (const void *bins, uint64_t num,
+        void *min, void *max, bool has) override;
+
+protected:
+    /**
+     * parse text to numeric value
+     * @param txt    text value content
+     * @param val    numeric value got
+     * @return true success; false invalid text
+     */
+    static bool txt2Num(const char *txt, NT &val);
+
+    /**
+     * output numeric value to text without '\0'
+     * @param val    numeric value
+     * @param txt    text content
+     * @param size   size available in txt
+     * @param fmt    format for float types
+     * @return <0 failed; >=0 num of chars used
+     */
+    static int  num2Txt(NT val, char *txt, uint64_t size, const char *fmt);
+
+    /**
+     * compare values with const by OP, 64 values for each bits word
+     * @return true result number
+     */
+    template <class OP>
+    static int64_t compareBits(const char *bins, uint64_t num, NT cst, uint64_t *bits);
+}; // TypeNumeric
 
 
 
@@ -362,6 +453,11 @@ public:
     int transTxt2Bin(const char *txt, void *bin, uint64_t size) override;
     int transBin2Txt(const void *bin, char *txt, uint64_t size) override;
     int outputText2Stream(const void *bin, std::ostream &ostrm) override;
+
+    int64_t transTxt2Bins(const char *const *txts, uint64_t num,
+        void *bins, uint64_t size) override;
+    int64_t transBin2Txts(const void *bins, uint64_t num,
+        char *txt, uint64_t size, char delim) override;
 }; // TypeBoolean
 
 
@@ -462,6 +558,14 @@ public:
     int         compareLike      (const void *l, const void *ptn);
     int         compareSubString (const void *l, const void *sub)
     { return (strstr((const char*)l, (const char*)sub) != nullptr); }
+
+public: // batch funcs: nullptr text is written as empty string
+    int64_t transTxt2Bins(const char *const *txts, uint64_t num,
+        void *bins, uint64_t size) override;
+    int64_t transBin2Txts(const void *bins, uint64_t num,
+        char *txt, uint64_t size, char delim) override;
+    int64_t compareConst (int cmp_op_id, const void *bins, uint64_t num,
+        const void *cst, uint64_t *bits) override;
 }; // TypeString
 
 
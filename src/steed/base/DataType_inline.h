@@ -27,6 +27,7 @@
 
 #pragma once 
 
+#include <errno.h>
 #include <stdlib.h>
 
 
@@ -128,11 +129,10 @@ inline int TypeNumeric <NT>::
     if (txt == nullptr)    { return  0; } // null value 
     if (size < sizeof(NT)) { return -1; } // space not enough
 
-    int used = -1;
-    const char *fmt = s_type_desc[m_type_id].fmt;
-    if (sscanf(txt, fmt, (NT*)bin) == 1) 
-    {   used = this->getBinSize(bin);   }
-    return used;
+    NT val = 0;
+    if (!txt2Num(txt, val)) { return -1; }
+    memcpy(bin, &val, sizeof(NT));
+    return sizeof(NT);
 } // transTxt2Bin
 
 
@@ -153,6 +153,169 @@ inline int TypeNumeric <NT>::
 
 
 
+
+template<class NT>
+inline bool TypeNumeric<NT>::txt2Num(const char *txt, NT &val)
+{
+    // same as sscanf by fmt, but never writes more than sizeof(NT)
+    char *end = nullptr;
+    if (std::is_floating_point<NT>::value)
+    {   val = (sizeof(NT) == sizeof(float)) ? NT(strtof(txt, &end)) : NT(strtod(txt, &end));   }
+    else
+    {
+        // out of NT range is invalid instead of wrapped
+        errno = 0;
+        long long v = strtoll(txt, &end, 10);
+        bool under  = (double(v) < double(std::numeric_limits<NT>::lowest()));
+        bool over   = (double(v) > double(std::numeric_limits<NT>::max   ()));
+        if ((errno == ERANGE) || under || over) { return false; }
+        val = NT(v);
+    } // if
+    return (end != txt);
+} // txt2Num
+
+
+template<class NT>
+inline int TypeNumeric<NT>::num2Txt(NT val, char *txt, uint64_t size, const char *fmt)
+{
+    if (std::is_floating_point<NT>::value)
+    {
+        int len = snprintf(txt, size, fmt, val);
+        return (len < (int)size) ? len : -1;
+    } // if
+
+    // integer digits in reverse order, faster than snprintf
+    char     digit[24];
+    int      dnum = 0;
+    bool     neg  = (val < 0);
+    uint64_t uval = neg ? (0 - uint64_t(int64_t(val))) : uint64_t(int64_t(val));
+    do { digit[dnum++] = char('0' + uval % 10); uval /= 10; } while (uval > 0);
+
+    int len = dnum + int(neg);
+    if (uint64_t(len) >= size) { return -1; }
+
+    if (neg) { *txt++ = '-'; }
+    while (dnum > 0) { *txt++ = digit[--dnum]; }
+    return len;
+} // num2Txt
+
+
+template<class NT> template <class OP>
+inline int64_t TypeNumeric<NT>::
+    compareBits(const char *bins, uint64_t num, NT cst, uint64_t *bits)
+{
+    // no branch in the inner loop to leave it to the compiler to vectorize
+    OP       op;
+    int64_t  cnt = 0;
+    for (uint64_t bgn = 0; bgn < num; bgn += 64)
+    {
+        uint64_t end  = (bgn + 64 < num) ? (bgn + 64) : num;
+        uint64_t word = 0;
+        for (uint64_t i = bgn; i < end; ++i)
+        {
+            NT val;
+            memcpy(&val, bins + i * sizeof(NT), sizeof(NT)); // maybe unaligned
+            word |= uint64_t((val != s_null) & op(val, cst)) << (i - bgn);
+        } // for i
+
+        bits[bgn / 64] = word;
+        cnt += __builtin_popcountll(word);
+    } // for bgn
+
+    return cnt;
+} // compareBits
+
+
+template<class NT>
+inline int64_t TypeNumeric<NT>::transTxt2Bins(const char *const *txts, uint64_t num,
+    void *bins, uint64_t size)
+{
+    if (size < num * sizeof(NT)) { return -1; } // space not enough
+
+    char *bin = (char*)bins;
+    for (uint64_t i = 0; i < num; ++i, bin += sizeof(NT))
+    {
+        NT val = s_null;
+        if ((txts[i] != nullptr) && !txt2Num(txts[i], val)) { return -1; }
+        memcpy(bin, &val, sizeof(NT));
+    } // for i
+
+    return int64_t(num * sizeof(NT));
+} // transTxt2Bins
+
+
+template<class NT>
+inline int64_t TypeNumeric<NT>::transBin2Txts(const void *bins, uint64_t num,
+    char *txt, uint64_t size, char delim)
+{
+    const char *fmt  = s_type_desc[m_type_id].fmt;
+    const char *bin  = (const char*)bins;
+    uint64_t    used = 0;
+    for (uint64_t i = 0; i < num; ++i, bin += sizeof(NT))
+    {
+        if ((i > 0) && (used + 1 < size)) { txt[used++] = delim; }
+
+        NT  val;
+        memcpy(&val, bin, sizeof(NT));
+        int len = -1;
+        if (val == s_null)
+        {   len = (used + 5 <= size) ? (memcpy(txt + used, "null", 4), 4) : -1;   }
+        else
+        {   len = num2Txt(val, txt + used, size - used, fmt);   }
+        if (len < 0) { return -1; }
+        used += len;
+    } // for i
+
+    if (used >= size) { return -1; }
+    txt[used] = '\0';
+    return int64_t(used);
+} // transBin2Txts
+
+
+template<class NT>
+inline int64_t TypeNumeric<NT>::compareConst(int cmp_op_id, const void *bins,
+    uint64_t num, const void *cst, uint64_t *bits)
+{
+    NT c;
+    memcpy(&c, cst, sizeof(NT));
+
+    const char *bin = (const char*)bins;
+    if (cmp_op_id == s_cmp_less     ) { return compareBits<std::less         <NT>>(bin, num, c, bits); }
+    if (cmp_op_id == s_cmp_not_grt  ) { return compareBits<std::less_equal   <NT>>(bin, num, c, bits); }
+    if (cmp_op_id == s_cmp_equal    ) { return compareBits<std::equal_to     <NT>>(bin, num, c, bits); }
+    if (cmp_op_id == s_cmp_not_equal) { return compareBits<std::not_equal_to <NT>>(bin, num, c, bits); }
+    if (cmp_op_id == s_cmp_greater  ) { return compareBits<std::greater      <NT>>(bin, num, c, bits); }
+    if (cmp_op_id == s_cmp_not_less ) { return compareBits<std::greater_equal<NT>>(bin, num, c, bits); }
+    return -1; // like and substr are string only
+} // compareConst
+
+
+template<class NT>
+inline int64_t TypeNumeric<NT>::updateMinMax(const void *bins, uint64_t num,
+    void *min, void *max, bool has)
+{
+    NT mn = std::numeric_limits<NT>::max   ();
+    NT mx = std::numeric_limits<NT>::lowest();
+    if (has) { memcpy(&mn, min, sizeof(NT)); memcpy(&mx, max, sizeof(NT)); }
+
+    const char *bin = (const char*)bins;
+    int64_t     cnt = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        NT val;
+        memcpy(&val, bin + i * sizeof(NT), sizeof(NT));
+        bool valid = (val != s_null);
+        mn   = (valid && (val < mn)) ? val : mn;
+        mx   = (valid && (val > mx)) ? val : mx;
+        cnt += valid;
+    } // for i
+
+    if (has || (cnt > 0))
+    {   memcpy(min, &mn, sizeof(NT)); memcpy(max, &mx, sizeof(NT));   }
+    return cnt;
+} // updateMinMax
+
+
 inline
 int TypeBoolean::transTxt2Bin(const char *txt, void *bin, uint64_t size) 
 {
@@ -194,6 +357,53 @@ int TypeBoolean::outputText2Stream(const void *bin, std::ostream &ostrm)
 
 
 
+inline
+int64_t TypeBoolean::transTxt2Bins(const char *const *txts, uint64_t num,
+    void *bins, uint64_t size)
+{
+    if (size < num) { return -1; } // space not enough
+
+    int8_t *bin = (int8_t*)bins;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        const char *txt = txts[i];
+        if      (txt == nullptr)             { bin[i] = s_null; }
+        else if (strcmp(txt, "true" ) == 0)  { bin[i] = 1;      }
+        else if (strcmp(txt, "false") == 0)  { bin[i] = 0;      }
+        else { return -1; }
+    } // for i
+
+    return int64_t(num);
+} // transTxt2Bins
+
+
+
+inline
+int64_t TypeBoolean::transBin2Txts(const void *bins, uint64_t num,
+    char *txt, uint64_t size, char delim)
+{
+    static const char *s_txt[] = {"false", "true", "null"};
+    static const int   s_len[] = {5, 4, 4};
+
+    const int8_t *bin  = (const int8_t*)bins;
+    uint64_t      used = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        if ((i > 0) && (used + 1 < size)) { txt[used++] = delim; }
+
+        int idx = (bin[i] == s_null) ? 2 : int(bin[i]);
+        if ((idx < 0) || (idx > 2) || (used + s_len[idx] >= size)) { return -1; }
+        memcpy(txt + used, s_txt[idx], s_len[idx]);
+        used += s_len[idx];
+    } // for i
+
+    if (used >= size) { return -1; }
+    txt[used] = '\0';
+    return int64_t(used);
+} // transBin2Txts
+
+
+
 
 inline
 int TypeString::transTxt2Bin(const char *txt, void *bin, uint64_t size)
@@ -285,6 +495,97 @@ int TypeString::compareLike (const void *l, const void *pattern)
 
 
 
+inline
+int64_t TypeString::transTxt2Bins(const char *const *txts, uint64_t num,
+    void *bins, uint64_t size)
+{
+    char    *bin  = (char*)bins;
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        // text is "xxx": skip the begin and end '\"' delims
+        const char *txt  = txts[i];
+        uint64_t    tlen = (txt == nullptr) ? 0 : strlen(txt);
+        uint64_t    blen = (tlen < 2) ? 0 : (tlen - 2);
+        if (used + blen + 1 > size) { return -1; }
+
+        memcpy(bin + used, txt + 1, blen);
+        bin[used + blen] = '\0';
+        used += blen + 1;
+    } // for i
+
+    return int64_t(used);
+} // transTxt2Bins
+
+
+
+inline
+int64_t TypeString::transBin2Txts(const void *bins, uint64_t num,
+    char *txt, uint64_t size, char delim)
+{
+    const char *bin  = (const char*)bins;
+    uint64_t    used = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        if ((i > 0) && (used + 1 < size)) { txt[used++] = delim; }
+
+        uint64_t blen = strlen(bin);
+        if (used + blen + 2 >= size) { return -1; }
+
+        txt[used] = '"';
+        memcpy(txt + used + 1, bin, blen);
+        txt[used + blen + 1] = '"';
+        used += blen + 2;
+        bin  += blen + 1;
+    } // for i
+
+    if (used >= size) { return -1; }
+    txt[used] = '\0';
+    return int64_t(used);
+} // transBin2Txts
+
+
+
+inline
+int64_t TypeString::compareConst(int cmp_op_id, const void *bins, uint64_t num,
+    const void *cst, uint64_t *bits)
+{
+    bool like = (cmp_op_id == s_cmp_like), sub = (cmp_op_id == s_cmp_substr);
+    bool ord  = (cmp_op_id > s_cmp_invalid) && (cmp_op_id < s_cmp_like);
+    if (!like && !sub && !ord) { return -1; }
+
+    const char *bin = (const char*)bins;
+    const char *tgt = (const char*)cst;
+    int64_t     cnt = 0;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+        if ((i % 64) == 0) { bits[i / 64] = 0; }
+
+        bool got = false;
+        if (like)
+        {   got = (regexec((const regex_t*)cst, bin, 0, NULL, 0) == 0);   }
+        else if (sub)
+        {   got = (strstr(bin, tgt) != nullptr);   }
+        else
+        {
+            int c = strcmp(bin, tgt);
+            got = (cmp_op_id == s_cmp_less     ) ? (c <  0) :
+                  (cmp_op_id == s_cmp_not_grt  ) ? (c <= 0) :
+                  (cmp_op_id == s_cmp_equal    ) ? (c == 0) :
+                  (cmp_op_id == s_cmp_not_equal) ? (c != 0) :
+                  (cmp_op_id == s_cmp_greater  ) ? (c >  0) : (c >= 0);
+        } // if
+
+        bits[i / 64] |= (uint64_t(got) << (i % 64));
+        cnt += got;
+        bin += strlen(bin) + 1;
+    } // for i
+
+    return cnt;
+} // compareConst
+
+
+
 
 
 inline
@@ -57,6 +57,7 @@ int Config::init (int argc, char** argv, const string &cfile)
 
     // subcommands
     m_app.require_subcommand(1);    // one of the following subcommands is required
+    m_app.fallthrough();            // global options may follow the subcommand
 
     auto op_create = m_app.add_subcommand("create", "Create a database or table");
     addDB2Option(op_create, m_db);
@@ -80,6 +81,12 @@ int Config::init (int argc, char** argv, const string &cfile)
     addDB2Option  (op_assemble, m_db);
     addTB2Option  (op_assemble, m_tb);
     addCols2Option(op_assemble, m_cols);
+    addWhere2Option(op_assemble, m_where);
+    addRange2Option(op_assemble, m_recd_bgn, m_recd_end);
+    addLimit2Option(op_assemble, m_offset, m_limit);
+    addOut2Option (op_assemble, m_out_path, m_out_format);
+
+    m_app.add_flag("--timing", m_timing, "Output records/s, bytes/s and peak RSS");
 
 
     // parse the command line and config params
@@ -143,8 +150,25 @@ void Config::addConfOptions(void)
 
     // runtime related
     m_app.add_option("--mem_align_size", m_mem_align_size, "memory aligned size");
+    m_app.add_option("--direct_io"     , m_direct_io, "read and write CAB content via O_DIRECT");
+    m_app.add_option("--mmap_read"     , m_mmap_read, "read CAB files via mmap without copying");
+    m_app.add_option("--cab_cache_size", m_cab_cache_size, "bytes of decoded CABs cached and shared by readers");
+    m_app.add_option("--mem_pool_cache", m_mem_pool_cache, "bytes of freed buffer blocks kept for reuse, 0 disables the cache");
+    m_app.add_option("--mem_limit"     , m_mem_limit, "max bytes of buffers in the process, 0 unlimited");
+    m_app.add_option("--query_mem_limit", m_query_mem_limit, "max bytes of buffers in each query, 0 unlimited");
+    m_app.add_option("--metrics"       , m_metrics, "collect hot path metrics and output them at uninit");
+    m_app.add_option("--log_level"     , m_log_level, "min log level: trace, debug, info, warn, error or off")
+        ->check(CLI::IsMember({"trace", "debug", "info", "warn", "error", "off"}));
+    m_app.add_option("--log_file"      , m_log_file, "log file to append, stderr as default");
+    m_app.add_option("--log_rate"      , m_log_rate, "max log messages per second, 0 unlimited");
+    m_app.add_option("--trace_file"    , m_trace_file, "write trace events to the file at uninit, empty disables tracing");
+    m_app.add_option("--trace_format"  , m_trace_format, "trace file format: json (Chrome trace) or binary")
+        ->check(CLI::IsMember({"json", "binary"}));
     m_app.add_option("--cab_recd_num"  , m_cab_recd_num, "number of records in a cab file");
     m_app.add_option("--text_recd_num" , m_text_recd_num, "number of records in text record buffer");
+    m_app.add_option("--write_behind_num", m_write_behind_num, "number of pending CAB buffers written in background");
+    m_app.add_option("--assemble_buf_cap", m_assemble_buf_cap, "initial bytes of assembled record buffer");
+    m_app.add_option("--out_batch_size", m_out_batch_size, "bytes of each output batch written to file or callback");
 } // addConfOptions
 
 
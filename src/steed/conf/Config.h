@@ -59,7 +59,15 @@ public: // call related
     string          m_db{""};
     string          m_tb{""};
     vector<string>  m_cols{};
+    string          m_where{""};            /**< assemble filter, "path op value" */
+    uint64_t        m_recd_bgn{0};          /**< assemble record range begin */
+    uint64_t        m_recd_end{UINT64_MAX}; /**< assemble record range end   */
+    uint64_t        m_offset{0};            /**< assemble records to skip    */
+    uint64_t        m_limit{UINT64_MAX};    /**< assemble max record number  */
     string          m_jpath{""};
+    string          m_out_path{""};         /**< assemble output, empty as stdout */
+    string          m_out_format{"ndjson"}; /**< assemble output format */
+    bool            m_timing{false};        /**< output timing summary  */
 
 public: // store related
     /**< base dir to store binary data */
@@ -71,6 +79,18 @@ public: // store related
 
 public: // memory related
     uint32_t m_mem_align_size{4096};    /**< memory aligned size */
+    bool     m_direct_io{false};        /**< CAB content IO via O_DIRECT */
+    bool     m_mmap_read{false};        /**< read CAB files via mmap     */
+    uint64_t m_cab_cache_size{0};       /**< decoded CAB cache bytes, 0 off */
+    uint64_t m_mem_pool_cache{268435456}; /**< freed blocks kept, 0 off */
+    uint64_t m_mem_limit{0};            /**< process memory bytes, 0 unlimited */
+    uint64_t m_query_mem_limit{0};      /**< query memory bytes, 0 unlimited   */
+    bool     m_metrics{false};          /**< collect hot path metrics */
+    string   m_log_level{"info"};       /**< min log level to output  */
+    string   m_log_file {};             /**< log file, empty stderr   */
+    uint32_t m_log_rate {100};          /**< log messages per second  */
+    string   m_trace_file{};            /**< trace file, empty off    */
+    string   m_trace_format{"json"};    /**< trace json or binary     */
 
 public: // schema related
     /** SampleNode has many sibling threshold  */
@@ -93,6 +113,9 @@ public: // cab
 
     double m_reserve_factor {1.618};
 
+    /** pending CAB buffers written in background, 0 writes inline */
+    uint32_t m_write_behind_num{0};
+
 public: // parse related 
     /** record number in text record buffer */
     uint32_t m_text_recd_num = 16;
@@ -122,6 +145,7 @@ public: // parse related
 public: // assemble
     uint32_t m_recd_cap  = 2048;
     uint32_t m_assemble_buf_cap = {64 * 1024 * 1024}; // 64MB 
+    uint64_t m_out_batch_size{1024 * 1024}; // 1MB, output sink batch
 
 
 public:
@@ -155,13 +179,15 @@ public:
      */
     void addConfOptions(void);
 
+public:
+    Mode getRunMode(void) const { return m_run_mode; }
+
 private:
     /**
      * get CLI11 app
      * @return CLI11 app
      */
     CLI::App& getApp(void) { return m_app; }
-    Mode getRunMode(void) const { return m_run_mode; }
 
     void addDB2Option(CLI::App* app, string &db)
     {   app->add_option("-d,--database", db, "Database name")->required();   } 
@@ -177,6 +203,29 @@ private:
     
     void addCols2Option(CLI::App* app, vector<string> &cols)
     {   app->add_option("-c,--column", cols, "Columns")->required();   }
+
+    void addWhere2Option(CLI::App* app, string &cond)
+    {   app->add_option("-w,--where", cond, "Filter condition: 'path op value'");   }
+
+    void addRange2Option(CLI::App* app, uint64_t &bgn, uint64_t &end)
+    {
+        app->add_option("--begin", bgn, "Begin record index to read");
+        app->add_option("--end",   end, "End record index to read, excluded");
+    } // addRange2Option
+
+    void addLimit2Option(CLI::App* app, uint64_t &offset, uint64_t &limit)
+    {
+        app->add_option("--offset",   offset, "Records to skip");
+        app->add_option("-n,--limit", limit,  "Max record number to output");
+    } // addLimit2Option
+
+    void addOut2Option(CLI::App* app, string &path, string &format)
+    {
+        app->add_option("-o,--output", path, "Output file path, stdout as default");
+        app->add_option("-f,--format", format,
+            "Output format: ndjson, json, csv, tsv or columnar")
+            ->check(CLI::IsMember({"ndjson", "json", "csv", "tsv", "columnar"}));
+    } // addOut2Option
     
 public:
     void output(void) const;
@@ -39,17 +39,53 @@ int CollectionWriter::flush(void)
         if (ctb == nullptr) { continue; } 
 
         ColumnWriter   *col = m_col_wts->get(ci);
+        DataType       *dt  = col->getDataType();
         uint32_t maxd = col->getMaxDefVal     ();
         uint64_t tnum = ctb->size(); 
+
+        // fixed size values are translated in one batch, then copied
+        uint32_t bsz  = dt->isFixedType() ? uint32_t(dt->getDefSize()) : 0;
+        uint64_t vi   = 0;
+        if ((bsz > 0) && (transValues(ctb, maxd, dt) < 0))
+        {   return -1;   }
+
         for (uint64_t ti = 0; ti < tnum; ++ti)
         {
             ColumnTextBuffer::Item &cti = ctb->get(ti);
             uint32_t     r = cti.getRep();
             uint32_t     d = cti.getDef();
             const char  *t = cti.getTxt();
-            bool    isnull = (d < maxd);
-            int s = isnull ? col->writeNull(r, d) : col->writeText(r, d, t);
-            if (s < 0)
+            if (d < maxd)
+            {
+                // nulls with the same rep and def are written in bulk
+                uint64_t nnum = 1;
+                while ((ti + nnum < tnum) &&
+                       (ctb->get(ti + nnum).getRep() == r) &&
+                       (ctb->get(ti + nnum).getDef() == d))
+                {   ++nnum;   }
+
+                if (col->writeNull(r, d, nnum) < 0)
+                {
+                    puts("CollectionWriter: writeNull failed!");
+                    return -1;
+                } // if 
+
+#ifdef _DEBUG_PARSER
+                printf("CollectionWriter::flush [%lu] rep[%u] def[%u] null #[%lu]\n", ci, r, d, nnum);
+#endif // _DEBUG_PARSER
+                ti += nnum - 1;
+                continue;
+            } // if 
+
+            if (bsz > 0)
+            {
+                if (col->writeBinVal(r, d, &m_val_bin[vi++ * bsz], bsz) < 0)
+                {
+                    puts("CollectionWriter: writeBinVal failed!");
+                    return -1;
+                } // if 
+            }
+            else if (col->writeText(r, d, t) < 0)
             {
                 puts("CollectionWriter: writeText failed!");
                 return -1;
@@ -67,6 +103,47 @@ int CollectionWriter::flush(void)
 
 
 
+int CollectionWriter::transValues(ColumnTextBuffer *ctb, uint32_t maxd, DataType *dt)
+{
+    m_val_txt.clear();
+    uint64_t tnum = ctb->size(); 
+    for (uint64_t ti = 0; ti < tnum; ++ti)
+    {
+        ColumnTextBuffer::Item &cti = ctb->get(ti);
+        if (cti.getDef() >= maxd) { m_val_txt.emplace_back(cti.getTxt()); }
+    } // for ti
+
+    uint64_t vnum = m_val_txt.size();
+    m_val_bin.resize(vnum * dt->getDefSize());
+    if (dt->transTxt2Bins(m_val_txt.data(), vnum, m_val_bin.data(), m_val_bin.size()) < 0)
+    {
+        puts("CollectionWriter: trans value texts failed!");
+        return -1;
+    } // if 
+
+    return 0;
+} // transValues
+
+
+
+int CollectionWriter::trim(void)
+{
+    uint64_t cnum = m_col_wts->size();
+    for (uint64_t ci = 0; ci < cnum; ++ci)
+    {
+        ColumnWriter *col = m_col_wts->get(ci);
+        if ((col != nullptr) && (col->trim() < 0))
+        {
+            puts("CollectionWriter: trim ColumnWriter failed!");
+            return -1;
+        } // if 
+    } // for 
+
+    return 0;
+} // trim
+
+
+
 
 
 int CollectionWriter::alignColumnWriter(SchemaSignature ls, TreeCounter &cnt)
@@ -52,6 +52,8 @@ protected:
     SchemaTree                  *m_tree   {nullptr}; /**< related tree */
     Container<ColumnWriter>     *m_col_wts{nullptr}; /**< mem columns  */
     Container<ColumnTextBuffer> *m_txt_buf{nullptr}; /**< text buffer  */ 
+    vector<const char*>          m_val_txt{};        /**< value texts  */
+    vector<char>                 m_val_bin{};        /**< value bins   */
 
 
 public:
@@ -126,6 +128,23 @@ public:
      */
     int flush(void);
 
+protected:
+    /**
+     * trans the value texts of a fixed size column to m_val_bin in a batch
+     * @param ctb   column text buffer to trans
+     * @param maxd  max def value of the column
+     * @param dt    column DataType
+     * @return 0 success; <0 failed
+     */
+    int transValues(ColumnTextBuffer *ctb, uint32_t maxd, DataType *dt);
+
+public:
+
+    /**
+     * free idle write-behind buffers of all ColumnWriters
+     * @return 0 success; <0 failed 
+     */
+    int trim (void);
 
 public:
     /** output 2 debug */
@@ -86,7 +86,7 @@ int CollectionWriter::init2append(TreeCounter *tc)
         bool isleaf = m_tree->isLeaf(ni);
         if (!isleaf)  { continue; }
 
-        first_leaf = (first_leaf != 0) ? ni : first_leaf;
+        first_leaf = (first_leaf == 0) ? ni : first_leaf;
 
         // init column to append 
         if (initColumnAppender(ni) < 0)
@@ -147,10 +147,9 @@ SchemaSignature ColumnItemGenerator::lookupSchema(JSONBinTree* bt,
     JSONBinField *cbf = bt ->getNode(cbf_idx);
     const char   *key = cbf->getKeyPtr     ();
 
-    string nd_name;
-    SchemaTree::getNameFromText(nd_name, key); 
-    const char      *nm = nd_name.c_str();
-    SchemaSignature got = m_tree->findNode(nm, psign, dt_id, vcate); 
+    uint32_t    len = 0;
+    const char *nm  = SchemaTree::getNameFromText(key, len);
+    SchemaSignature got = m_tree->findNode(nm, len, psign, dt_id, vcate); 
     return got; 
 } // lookupSchema
 
@@ -37,29 +37,17 @@ int ColumnParser::init (const string &db, const string &clt, istream *is)
     for (uint32_t i = 0; i < s_jtree_cap; ++i)
     {   m_jtree[i] = new JSONBinTree();   } 
 
-    // get SchemaTree from SchemaTreeMap
-    int status = SchemaTreeMap::getDefinedTree(db, clt, m_tree);
+    // get SchemaTree from SchemaTreeMap and hold it as the writer
+    int status = SchemaTreeMap::getWritableTree(db, clt, m_tree_ref);
     if (status < 0)
     {
         printf("ColumnParser: get SchemaTree failed!\n");
         return -1; 
-        DebugInfo::printStackAndExit();
-    } 
-    else if (status == 0)
-    {
-        m_append = false;
-
-        // create a new SchemaTree
-        m_tree = new SchemaTree(db, clt);
+    } // if 
 
-        // move the SchemaTree ownership to SchemaTreeMap
-        SchemaTreeMap::emplace(db, clt, m_tree);
-    }
-    else 
-    {
-        // status > 0, got a defined SchemaTree
-        m_append = true;
-    } // if
+    // status == 0: created a new SchemaTree; > 0: got a defined one
+    m_tree   = m_tree_ref.get();
+    m_append = (status > 0);
     
     m_clt_wt   = new CollectionWriter(m_tree);
     m_item_gen = new ColumnItemGenerator(m_tree, m_clt_wt);
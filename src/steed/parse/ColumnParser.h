@@ -34,11 +34,16 @@
 
 #include "Config.h"
 #include "DebugInfo.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Tracer.h"
+#include "MemTracker.h"
 #include "JSONRecordBuffer.h"
 #include "JSONRecordNaiveParser.h"
 
 #include "SchemaTree.h"
 #include "SchemaTreeMap.h"
+#include "CABCache.h"
 #include "CollectionWriter.h"
 #include "ColumnItemGenerator.h"
 
@@ -65,6 +70,7 @@ protected:
     array <JSONBinTree*, s_jtree_cap> m_jtree{};
     uint64_t             m_jtree_used  {0}; /**< m_jtree used number */
 
+    SchemaTreeRef        m_tree_ref{};        /**< held as the writer      */
     SchemaTree          *m_tree    {nullptr}; /**< inferred SchemaTree ins */
     CollectionWriter    *m_clt_wt  {nullptr}; /**< CollectionWriter write txt 2 bin*/
     ColumnItemGenerator *m_item_gen{nullptr}; /**< bond JSONBinField to SchemaTree */
@@ -132,6 +138,14 @@ public:
     int64_t parseOne(const char *recd, uint32_t len);
 
 protected:
+    /**
+     * backpressure of the memory budget: near the limit halve the batch 
+     *   and release idle memory, double the batch back when relieved 
+     * @param rnum    current batch record number
+     * @return batch record number to read 
+     */
+    uint32_t adjustBatch(uint32_t rnum);
+
     /**
      * read text records and trans to JSONBinTree in batch
      * @param fptr     read function pointer: read or sample  
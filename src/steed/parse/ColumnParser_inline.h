@@ -42,8 +42,9 @@ ColumnParser::~ColumnParser(void)
     delete m_item_gen; m_item_gen = nullptr;
     delete m_clt_wt  ; m_clt_wt   = nullptr;
 
-    // SchemaTree is managed by SchemaTreeMap, just release the pointer
+    // SchemaTree is managed by SchemaTreeMap, just release the handle
     m_tree = nullptr;
+    SchemaTreeMap::releaseWritableTree(m_tree_ref);
 
     for (uint32_t i = 0; i < s_jtree_cap; ++i)
     {
@@ -60,24 +61,32 @@ ColumnParser::~ColumnParser(void)
 inline
 int64_t ColumnParser::parseOne(void)
 {
+    MetricsTimer timer(Metrics::t_parse);
+
     // read samples
     uint32_t rnum = 1; 
     int bnum = readRecds2TreeInBatch( &JSONRecordReader::readRecord, rnum); 
     if (bnum < 0)
     {
-        printf("ColumnParser: parse got [%d]\n", bnum);
+        STEED_LOG(error, "ColumnParser: parse got [%d]", bnum);
         return bnum;
     } 
     else if (bnum == 0)
     {   return 0;   }
 
-    int s = m_item_gen->generate(m_jtree_used, m_jtree);
+    int s = 0;
+    {
+        TraceScope trace(Tracer::column_write);
+        std::lock_guard<std::mutex> lk(m_tree->getMutex()); // nodes may be added
+        s = m_item_gen->generate(m_jtree_used, m_jtree);
+    }
     if (s < 0)
     {
-        printf("ColumnParser: update SampleTree got [%d]\n", s);
+        STEED_LOG(error, "ColumnParser: update SampleTree got [%d]", s);
         return s;
     } // if 
 
+    Metrics::add(Metrics::recd_parsed);
     return 1;
 } // parseOne
 
@@ -90,29 +99,36 @@ int64_t ColumnParser::parseAll(void)
 {
     int64_t bat_cnt = 0, recd_cnt = 0;
     uint32_t rnum = s_jtree_cap;
+    MetricsTimer timer(Metrics::t_parse);
     do {
         // read samples
+        rnum = adjustBatch(rnum);
         int bnum = readRecds2TreeInBatch( &JSONRecordReader::readRecord, rnum); 
         if (bnum < 0)
         {
-            printf("ColumnParser: parse got [%d]\n", bnum);
+            STEED_LOG(error, "ColumnParser: parse got [%d]", bnum);
             return bnum;
         } 
         else if (bnum == 0)
         {   break;   }
         recd_cnt += bnum;
 
-        int s = m_item_gen->generate(m_jtree_used, m_jtree);
+        int s = 0;
+        {
+            TraceScope trace(Tracer::column_write);
+            std::lock_guard<std::mutex> lk(m_tree->getMutex()); // nodes may be added
+            s = m_item_gen->generate(m_jtree_used, m_jtree);
+        }
         if (s < 0)
         {
-            printf("ColumnParser: update SampleTree got [%d]\n", s);
+            STEED_LOG(error, "ColumnParser: update SampleTree got [%d]", s);
             return s;
         } // if 
+        Metrics::add(Metrics::recd_parsed, bnum);
 
         if (bat_cnt++ % 1000 == 0) 
         {
-            DebugInfo::printTime();
-            printf("ColumnParser parsed [%lu * %u] = %lu records\n",
+            STEED_LOG(info, "ColumnParser parsed [%lu * %u] = %lu records",
                 (bat_cnt - 1),  g_config.m_text_recd_num,
                 (bat_cnt - 1) * g_config.m_text_recd_num);
         } // if 
@@ -129,8 +145,9 @@ int64_t ColumnParser::parseOne(const char *recd, uint32_t len)
 {
     if (recd == nullptr) { return -1; }
 
+    MetricsTimer timer(Metrics::t_parse);
     m_jbuffer->reset();
-    m_jbuffer->appendOneRecd(recd, len);
+    if (m_jbuffer->appendOneRecd(recd, len) < 0) { return -1; }
 
     JSONBinTree* jtree = m_jtree[0];
     uint64_t recd_len = 0; 
@@ -144,33 +161,60 @@ int64_t ColumnParser::parseOne(const char *recd, uint32_t len)
     { return ps; }
     m_jtree_used = 1;
 
+    TraceScope trace(Tracer::column_write);
+    std::lock_guard<std::mutex> lk(m_tree->getMutex()); // nodes may be added
     int gs = m_item_gen->generate(m_jtree_used, m_jtree);
     if (gs < 0)
     { return gs; }
 
+    Metrics::add(Metrics::recd_parsed);
     return 1;
 } // parserOne
 
 
 
+inline
+uint32_t ColumnParser::adjustBatch(uint32_t rnum)
+{
+    if (!MemTracker::current()->pressured())
+    {   return (rnum * 2 < s_jtree_cap) ? (rnum * 2) : uint32_t(s_jtree_cap);   }
+
+    // CABs are flushed by record number: release what is not in use
+    if (m_clt_wt->trim() < 0)
+    {   STEED_LOG(warn, "ColumnParser: trim CollectionWriter failed!");   }
+    g_cab_cache.purge();
+    steedPoolTrim();
+
+    uint32_t got = (rnum > 1) ? (rnum / 2) : 1;
+    STEED_LOG(debug, "ColumnParser: memory pressured, batch [%u] -> [%u]", rnum, got);
+    return got;
+} // adjustBatch
+
+
+
 inline
 int ColumnParser::readRecds2TreeInBatch(ReadFPtr fptr, uint32_t rnum)
 {
     // read records in batch
     array<char*, s_jtree_cap> bgns;
-    int rs = m_jbuffer->readRecords(fptr, rnum, bgns);
-    if (rs <  0) { printf("ColumnParser: nextRecord got [%d]\n", rs); } 
+    int rs = 0;
+    {
+        TraceScope trace(Tracer::batch_read);
+        rs = m_jbuffer->readRecords(fptr, rnum, bgns);
+    }
+    if (rs <  0) { STEED_LOG(error, "ColumnParser: nextRecord got [%d]", rs); } 
     if (rs <= 0) { return rs; }
 //    m_jbuffer->output2debug();
 
     // parse records in batch  
+    TraceScope trace(Tracer::parse);
     uint32_t pidx = 0; 
     while (pidx < rnum)
     {
         int ps = m_jparser->parse(m_jtree[pidx], bgns[pidx]);
         if (ps < 0)
         {
-            printf("ColumnParser: parse got [%d]\n", ps);
+            STEED_LOG(error, "ColumnParser: parse got [%d]", ps);
             return ps;
         }
 
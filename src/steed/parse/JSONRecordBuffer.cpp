@@ -28,7 +28,7 @@
 
 namespace steed {
 
-const uint32_t JSONRecordBuffer::s_invalid_offset = UINT32_MAX; 
+const uint64_t JSONRecordBuffer::s_invalid_offset = UINT64_MAX; 
 
 
 void JSONRecordBuffer::clearOffsetArray(void)
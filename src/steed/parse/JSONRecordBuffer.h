@@ -49,7 +49,7 @@ protected:
 
 public:
     /** invalid offset value in m_offset_array  */ 
-    static const uint32_t s_invalid_offset; 
+    static const uint64_t s_invalid_offset; 
     static const uint32_t s_recd_num = 16; 
 
 protected:
@@ -62,7 +62,7 @@ protected:
     JSONRecordReader  *m_recd_rd{nullptr}; /**< json text record reader*/ 
 
     /** record begin offset in buffer */ 
-    array<uint32_t, s_recd_num> m_offset_array; 
+    array<uint64_t, s_recd_num> m_offset_array; 
     uint32_t    m_elem_idx {0};  /**< elements index visited */ 
     uint32_t    m_elem_used{0};  /**< elements used in array */ 
 
@@ -128,8 +128,9 @@ inline
 JSONRecordBuffer::JSONRecordBuffer (istream *i): m_strm(i)
 {
     uint64_t size = g_config.m_text_buffer_number * g_config.m_text_recd_avg_len;
-    m_buff = new Buffer(size);
+    m_buff = new Buffer(size, false); // text is read before parsed
     m_buff->initInMemory();  
+    m_buff->setBudget(true); // long records over the budget fail the read
 
     if (i != nullptr)
     {
@@ -191,7 +192,7 @@ int JSONRecordBuffer::
 
     for (m_elem_idx = 0; m_elem_idx < m_elem_used; ++m_elem_idx)
     {
-        uint32_t off = m_offset_array[m_elem_idx];
+        uint64_t off = m_offset_array[m_elem_idx];
         recds[m_elem_idx] = (char*)m_buff->getPosition(off);
     } // for
 
@@ -223,7 +224,7 @@ int JSONRecordBuffer::read2buffer (ReadFPtr fptr, uint32_t rnum)
     uint32_t rcap = (rnum < s_recd_num) ? rnum : s_recd_num;
     while (m_elem_used < rcap)
     {
-        uint32_t offset = m_buff->used();
+        uint64_t offset = m_buff->used();
         if ((m_recd_rd->*fptr)(rbgn, rlen) <= 0)
         {   break;   }
 
@@ -240,8 +241,8 @@ int JSONRecordBuffer::appendOneRecd(const char *recd, uint32_t len)
 {
     if (m_buff == nullptr) { return -1; }
 
-    uint32_t offset = m_buff->used();
-    m_buff->append(recd, len);
+    uint64_t offset = m_buff->used();
+    if (m_buff->append(recd, len) < 0) { return -1; }
     m_offset_array[m_elem_used++] = offset;
 
     return 1;
@@ -259,7 +260,7 @@ void JSONRecordBuffer::output2debug(void)
     for (uint32_t i = 0; i < m_elem_used; ++i)
     {
         printf("\n[%u] ----------------------------------------\n", i);
-        uint32_t off = m_offset_array[i];
+        uint64_t off = m_offset_array[i];
         char *recd = (char*)m_buff->getPosition(off);
         printf("%s", recd);
     } // for
@@ -34,6 +34,7 @@
 
 #include "Buffer.h"
 #include "Config.h"
+#include "Logger.h"
 #include "RandomValues.h"
 #include "InStreamSeeker.h"
 
@@ -178,7 +179,11 @@ int JSONRecordReader::readLine  (const char* &line_bgn, uint64_t &line_len)
         {
             uint64_t buf_cap = m_buff->capacity();
             m_buff->allocate(read_num, false); 
-            m_buff->reserve (buf_cap * 2);
+            if (m_buff->reserve(buf_cap * 2) < 0)
+            {
+                STEED_LOG(error, "JSONRecordReader: grow buffer for a long record failed!");
+                return -1;
+            } // if 
             m_strm->clear();
         }
         else if (m_strm->bad()) // failed 
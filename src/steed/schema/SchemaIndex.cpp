@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file SchemaIndex.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   SchemaIndex functions
+ */
+
+#include <stdio.h>
+
+#include "SchemaIndex.h"
+
+namespace steed {
+
+void SchemaIndex::growSymbols(void)
+{
+    uint64_t snum = m_sym_slots.empty() ? s_init_slots : m_sym_slots.size() * 2;
+    m_sym_slots.assign(snum, 0);
+
+    uint32_t num = m_syms.size();
+    for (uint32_t sym = 0; sym < num; ++sym)
+    {   putSymbol(sym);   }
+} // growSymbols
+
+
+
+void SchemaIndex::growEntries(void)
+{
+    uint64_t snum = m_ent_slots.empty() ? s_init_slots : m_ent_slots.size() * 2;
+    m_ent_slots.assign(snum, 0);
+
+    // put again in the insert order to keep the same key order
+    uint32_t num = m_entries.size();
+    for (uint32_t ent = 0; ent < num; ++ent)
+    {   putEntry(ent);   }
+} // growEntries
+
+
+
+void SchemaIndex::output2debug(void)
+{
+    printf("SchemaIndex: [%u] symbols in [%lu] slots, [%u] entries in [%lu] slots\n",
+        getSymbolNum(), m_sym_slots.size(), getEntryNum(), m_ent_slots.size());
+
+    for (auto &e : m_entries)
+    {
+        printf("[%s] parent@[%u] -> [%u]\n",
+            m_syms[e.m_sym].c_str(), e.m_pidx, e.m_sign);
+    } // for e
+} // output2debug
+
+} // namespace steed
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file SchemaIndex.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   name symbol table and child index of SchemaTree
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "SchemaSignature.h"
+
+
+namespace steed {
+
+using std::string;
+using std::vector;
+
+
+/**
+ * @class SchemaIndex
+ * @brief SchemaIndex interns the field names and indexes the children
+ * @details
+ * Field names are interned to symbol ids, and children are indexed by
+ * (parent signature, symbol id). Both tables are open addressing with
+ * linear probing on power of 2 slots, a slot holds the array index + 1
+ * and 0 for empty. Nothing is erased, so the children with the same key
+ * are met in the insert order along the probe sequence.
+ */
+class SchemaIndex {
+protected:
+    class Entry {
+    public:
+        SchemaSignature  m_pidx{0};  /**< parent signature */
+        uint32_t         m_sym {0};  /**< name symbol id   */
+        SchemaSignature  m_sign{0};  /**< child  signature */
+    }; // Entry
+
+    vector<string>    m_syms     {}; /**< interned name strings     */
+    vector<uint64_t>  m_sym_hash {}; /**< name hash of each symbol  */
+    vector<uint32_t>  m_sym_slots{}; /**< name slots: symbol id + 1 */
+
+    vector<Entry>     m_entries  {}; /**< children in insert order  */
+    vector<uint32_t>  m_ent_slots{}; /**< child slots: entry idx + 1 */
+
+public:
+    static const uint32_t  s_invalid_sym {uint32_t(-1)}; /**< invalid symbol */
+    static const uint32_t  s_invalid_sign{uint32_t(-1)}; /**< not found sign */
+    static const uint32_t  s_init_slots  {64};           /**< init slots num */
+
+public:
+    SchemaIndex (void) = default;
+    ~SchemaIndex(void) = default;
+
+public:
+    void     clear       (void);
+    uint32_t getSymbolNum(void)         { return m_syms.size(); }
+    uint32_t getEntryNum (void)         { return m_entries.size(); }
+    const string& getSymbol(uint32_t s) { return m_syms[s]; }
+
+    /**
+     * find the symbol id of the name
+     * @param n    name string, not '\0' ended
+     * @param len  name length
+     * @return symbol id; s_invalid_sym not interned
+     */
+    uint32_t findSymbol(const char *n, uint32_t len);
+
+    /**
+     * intern the name as a symbol
+     * @return symbol id of the name
+     */
+    uint32_t addSymbol (const char *n, uint32_t len);
+
+    /**
+     * add child to index
+     * @param pidx  parent signature
+     * @param sym   child name symbol
+     * @param sign  child signature
+     */
+    void     add (SchemaSignature pidx, uint32_t sym, SchemaSignature sign);
+
+    /**
+     * find the next child with the key in the insert order
+     * @param pidx  parent signature
+     * @param sym   child name symbol
+     * @param pos   probe position, 0 to begin and kept for next call
+     * @return child signature; s_invalid_sign no more
+     */
+    SchemaSignature find(SchemaSignature pidx, uint32_t sym, uint64_t &pos);
+
+protected:
+    static uint64_t hashName(const char *n, uint32_t len);
+    static uint64_t hashKey (SchemaSignature pidx, uint32_t sym)
+    { return ((uint64_t(pidx) << 32) | sym) * 0x9E3779B97F4A7C15ULL; }
+
+    /** slots number should keep load factor under 1/2 */
+    static bool     isCrowded(uint64_t used, uint64_t slots)
+    { return (used + 1) * 2 > slots; }
+
+    void  putSymbol(uint32_t sym);
+    void  putEntry (uint32_t ent);
+
+    /** double the slots and put the symbols or entries again */
+    void  growSymbols(void);
+    void  growEntries(void);
+
+public:
+    void output2debug(void);
+}; // SchemaIndex
+
+} // namespace steed
+
+
+#include "SchemaIndex_inline.h"
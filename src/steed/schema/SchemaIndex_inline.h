@@ -0,0 +1,148 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file SchemaIndex_inline.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   SchemaIndex inline functions
+ */
+
+#pragma once
+
+namespace steed {
+
+inline
+void SchemaIndex::clear(void)
+{
+    m_syms     .clear();
+    m_sym_hash .clear();
+    m_sym_slots.clear();
+    m_entries  .clear();
+    m_ent_slots.clear();
+} // clear
+
+
+
+inline
+uint64_t SchemaIndex::hashName(const char *n, uint32_t len)
+{
+    // FNV-1a
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (uint32_t i = 0; i < len; ++i)
+    {   h = (h ^ uint8_t(n[i])) * 0x100000001B3ULL;   }
+    return h;
+} // hashName
+
+
+
+inline
+uint32_t SchemaIndex::findSymbol(const char *n, uint32_t len)
+{
+    if (m_sym_slots.empty()) { return s_invalid_sym; }
+
+    uint64_t h    = hashName(n, len);
+    uint64_t mask = m_sym_slots.size() - 1;
+    for (uint64_t si = h & mask; m_sym_slots[si] != 0; si = (si + 1) & mask)
+    {
+        uint32_t sym = m_sym_slots[si] - 1;
+        const string &s = m_syms[sym];
+        if ((m_sym_hash[sym] == h) && (s.size() == len) &&
+            (memcmp(s.data(), n, len) == 0))
+        {   return sym;   }
+    } // for si
+
+    return s_invalid_sym;
+} // findSymbol
+
+
+
+inline
+uint32_t SchemaIndex::addSymbol(const char *n, uint32_t len)
+{
+    uint32_t sym = findSymbol(n, len);
+    if (sym != s_invalid_sym) { return sym; }
+
+    if (isCrowded(m_syms.size(), m_sym_slots.size())) { growSymbols(); }
+
+    sym = m_syms.size();
+    m_syms    .emplace_back(n, len);
+    m_sym_hash.emplace_back(hashName(n, len));
+    putSymbol(sym);
+    return sym;
+} // addSymbol
+
+
+
+inline
+void SchemaIndex::add(SchemaSignature pidx, uint32_t sym, SchemaSignature sign)
+{
+    if (isCrowded(m_entries.size(), m_ent_slots.size())) { growEntries(); }
+
+    uint32_t ent = m_entries.size();
+    m_entries.emplace_back();
+    Entry &e = m_entries.back();
+    e.m_pidx = pidx, e.m_sym = sym, e.m_sign = sign;
+    putEntry(ent);
+} // add
+
+
+
+inline
+SchemaSignature SchemaIndex::find(SchemaSignature pidx, uint32_t sym, uint64_t &pos)
+{
+    if (m_ent_slots.empty()) { return s_invalid_sign; }
+
+    uint64_t mask = m_ent_slots.size() - 1;
+    uint64_t home = hashKey(pidx, sym) >> 32;
+    for (uint64_t si = (home + pos) & mask; m_ent_slots[si] != 0; si = (si + 1) & mask)
+    {
+        ++pos;
+        const Entry &e = m_entries[m_ent_slots[si] - 1];
+        if ((e.m_pidx == pidx) && (e.m_sym == sym))
+        {   return e.m_sign;   }
+    } // for si
+
+    return s_invalid_sign;
+} // find
+
+
+
+inline
+void SchemaIndex::putSymbol(uint32_t sym)
+{
+    uint64_t mask = m_sym_slots.size() - 1;
+    uint64_t si   = m_sym_hash[sym] & mask;
+    while (m_sym_slots[si] != 0) { si = (si + 1) & mask; }
+    m_sym_slots[si] = sym + 1;
+} // putSymbol
+
+
+
+inline
+void SchemaIndex::putEntry(uint32_t ent)
+{
+    const Entry &e = m_entries[ent];
+    uint64_t mask = m_ent_slots.size() - 1;
+    uint64_t si   = (hashKey(e.m_pidx, e.m_sym) >> 32) & mask;
+    while (m_ent_slots[si] != 0) { si = (si + 1) & mask; }
+    m_ent_slots[si] = ent + 1;
+} // putEntry
+
+} // namespace steed
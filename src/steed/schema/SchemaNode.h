@@ -30,8 +30,6 @@
 
 #include <string>
 #include <vector>
-#include <functional>  // hash
-#include <unordered_map>
 
 #include "Row.h"
 #include "Config.h"
@@ -42,62 +40,12 @@
 
 namespace steed {
 
-using std::hash;  // hash template func 
-using std::pair;   
 using std::string; 
 using std::vector;
-using std::unordered_multimap; 
 
 
 
 class SchemaNode  {
-public: // Schema node hash table
-    class HashKey {
-    public:
-        string           m_name{""}; /**< field name string  */
-        SchemaSignature  m_pidx {0}; /**< parent Schema sign */
-    
-    public:
-        ~HashKey(void) = default; 
-        HashKey (void) = default; 
-        HashKey (const HashKey& h) : m_name(h.m_name), m_pidx(h.m_pidx) {}
-        HashKey (const string & n, SchemaSignature pidx) :
-                m_name(n), m_pidx(pidx) {}
-    
-        void output2debug(void) const
-        { printf("[%s] parent@[%u]", m_name.c_str(), m_pidx); }
-    }; // HashKey
-    
-    class Hasher {
-    protected:
-        hash<string>           m_hash_str ;
-        hash<SchemaSignature>  m_hash_sign;
-    
-    public:
-        Hasher (void) = default; 
-        ~Hasher(void) = default; 
-        size_t operator() (HashKey const& h) const
-        { return (m_hash_str(h.m_name) + m_hash_sign(h.m_pidx)); } 
-    }; // Hasher
-    
-    class KeyEqual {
-    public:
-        bool operator() (const HashKey & l, const HashKey & r) const
-        { return ((l.m_pidx == r.m_pidx) && (l.m_name.compare(r.m_name) == 0)); }
-    }; // KeyEqual
-    
-    /**
-     * Hash Table Define
-     * @param HashKey          hash key  : struct Key
-     * @param SchemaSignature  hash value: SampleNode index in tree 
-     * @param Hasher           hash func : use user default function 
-     * @param KeyEqual         overload operator () to calc key equal 
-     */
-    typedef unordered_multimap<HashKey, SchemaSignature, Hasher, KeyEqual> HashTable;
-    typedef HashTable::const_iterator   hash_citr;
-    typedef pair<hash_citr, hash_citr>  hash_crange;
-
-
 protected:
     DataType           *m_dt {nullptr};  /**< data type ins    */
     int                 m_dt_id{DataType::s_type_invalid}; /**< type id*/
@@ -179,7 +179,24 @@ int SchemaTree::flush(void)
         return -1; 
     } // if 
     
+    if (flush2buffer(fb) < 0)
+    {   return -1;   }
+
+    // flush content 2 file 
+    if (fb->flush2File() < 0)
+    {
+        printf("SchemaTree:: flush Buffer flush2File failed!\n");
+        return -1;
+    }
     
+    delete fb; fb = nullptr;
+    return 0;
+} // flush
+
+
+
+int SchemaTree::flush2buffer(Buffer *fb)
+{
     // block header 
     uint64_t blk_use = sizeof(block::Block); // block used size  
     fb->allocate(blk_use, false);
@@ -215,17 +232,8 @@ int SchemaTree::flush(void)
     // update size info 
     block::Block *blk = (block::Block*)fb->getPosition(0);
     blk->m_size = blk_use;
-
-    // flush content 2 file 
-    if (fb->flush2File() < 0)
-    {
-        printf("SchemaTree:: flush Buffer flush2File failed!\n");
-        return -1;
-    }
-    
-    delete fb; fb = nullptr;
     return 0;
-} // flush
+} // flush2buffer
 
 
 
@@ -233,12 +241,6 @@ int SchemaTree::flush(void)
 
 int SchemaTree::load(void)
 {
-    // clear this to prepare to load from file  
-    m_nodes->clear();
-    m_names .clear();
-    m_node_valid.clear();
-
-
     // begin to build from file  
     string path; 
     Utility::getSchemaPath(g_config, m_db_name, m_clt_name, path);
@@ -246,9 +248,26 @@ int SchemaTree::load(void)
     Buffer *lb = new Buffer();
     if (lb->init2read(path) < 0)
     {   return 0;   } 
-    
 
     block::load2Buffer(lb);
+    int status = load4buffer(lb);
+
+    delete lb; lb = nullptr;
+    return status; 
+} // load
+
+
+
+int SchemaTree::load4buffer(Buffer *lb)
+{
+    // clear this to prepare to load from buffer  
+    m_nodes->clear();
+    m_names .clear();
+    m_node_valid.clear();
+    m_index     .clear();
+    m_child_pos .clear();
+    m_last_child.clear();
+
     uint64_t rd_off = sizeof(block::Block);
 
     // SchemaNode array 
@@ -289,21 +308,44 @@ int SchemaTree::load(void)
     Row::ID tid = tail->getFieldID(); 
     m_next_fid = tid + 1;
 
-    // build the between relation of SchemaNode and its hashtable
+    // build the between relation of SchemaNode and its index
+    m_child_pos .emplace_back(0); // root 
+    m_last_child.emplace_back(0);
     for (uint32_t ni = 1; ni < nnum; ++ni) 
     {
         SchemaNode *sn = m_nodes->get(ni);
         uint32_t  pidx = sn->getParent();
         SchemaNode *pn = m_nodes->get(pidx);
         pn->addChild(ni);
-        
-        SchemaNode::HashKey h(m_names[ni], pidx);
-        m_name_map.emplace(h, ni);
+        indexNode(ni);
     } // for 
 
-    delete lb; lb = nullptr;
     return 1; 
-} // load
+} // load4buffer
+
+
+
+SchemaTree *SchemaTree::snapshot(void)
+{
+    Buffer *mb = new Buffer();
+    mb->initInMemory();
+
+    int fs = 0;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        fs = flush2buffer(mb);
+    }
+
+    SchemaTree *t = (fs < 0) ? nullptr : new SchemaTree(m_db_name, m_clt_name);
+    if ((t != nullptr) && (t->load4buffer(mb) < 0))
+    {
+        printf("SchemaTree: load snapshot failed!\n");
+        delete t; t = nullptr;
+    } // if 
+
+    delete mb; mb = nullptr;
+    return t;
+} // snapshot
 
 
 
@@ -341,15 +383,9 @@ void SchemaTree::output2debug(void)
 #endif 
 
 #if 0
-    printf("\n\n>> SchemaNode HashTable:");
+    printf("\n\n>> SchemaNode Index:");
     printf("\n2 ========================================\n");
-    for (auto & slot : m_name_map)
-    {
-        printf("[%u]\n", slot.second);
-        slot.first.output2debug();
-        puts("");
-        this->getNode(slot.second)->output2debug();
-    } // for 
+    m_index.output2debug();
     puts("\n\n\n");
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once 
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,7 @@
 #include "Config.h"
 #include "Container.h"
 #include "SchemaNode.h"
+#include "SchemaIndex.h"
 #include "Utility.h"
 
 
@@ -52,9 +54,14 @@ protected:
     vector   <string>        m_names       {}; /**< field name string   */
     vector   <uint8_t>       m_node_valid  {}; /**< SchemaNode is valid */
 
-    SchemaNode::HashTable    m_name_map {};    /**< name to index map   */
+    SchemaIndex              m_index    {};    /**< name and child index */
+    vector   <uint32_t>      m_child_pos   {}; /**< index in parent's children */
+    vector   <uint32_t>      m_last_child  {}; /**< last matched child index   */
     Row::ID                  m_next_fid{1};    /**< next field id */ 
 
+    std::mutex               m_mutex    {};    /**< writer and snapshot */
+    bool                     m_writing{false}; /**< held by a writer, see SchemaTreeMap */
+
 public:
     static const SchemaSignature s_invalid_sign{uint32_t(-1)}; /**< invalid sign */ 
     static const Row::ID         s_max_field_id{0xFFC0};       /**< max field id */ 
@@ -63,11 +70,15 @@ public:
 public:
     SchemaTree (const string &db, const string &col);
     ~SchemaTree(void);
+    SchemaTree (const SchemaTree&) = delete;
 
 public:
     Row::ID         getNextFieldID(void) { return m_next_fid; }
     const string&   getDBName     (void) { return m_db_name ; }
     const string&   getCltName    (void) { return m_clt_name; }
+    std::mutex&     getMutex      (void) { return m_mutex   ; }
+    bool            isWriting     (void) { return m_writing ; }
+    void            setWriting    (bool w) { m_writing = w  ; }
     uint64_t        getLeafNum    (void);
     uint64_t        getNodeNum    (void) { return m_nodes->size(); } 
     SchemaNode     *getRoot       (void) { return getNode     (0); }
@@ -139,10 +150,35 @@ public:
      * @param cate   this SchemaNode value category
      * @return 0 success; <0 failed since path mis-match 
      */
-    SchemaSignature findNode(const char *k, SchemaSignature psign, int dt_id, uint8_t cate);
+    SchemaSignature findNode(const char *k, SchemaSignature psign, int dt_id, uint8_t cate)
+    { return  findNode(k, strlen(k), psign, dt_id, cate); }
 
-    SchemaNode::hash_crange findNode(const char *k, SchemaSignature pidx)
-    { return  m_name_map.equal_range(SchemaNode::HashKey(k, pidx)); }
+    /**
+     * find the SchemaNode by the name with length:
+     *   records mostly repeat the same field order, so the child after the
+     *   last matched one of the parent is checked before the index.
+     *   The cache is updated, call it by the writer holding the tree only.
+     * @param len    key name length 
+     * @see findNode
+     */
+    SchemaSignature findNode(const char *k, uint32_t len,
+            SchemaSignature psign, int dt_id, uint8_t cate);
+
+    /**
+     * find all SchemaNodes with the name under the parent in defined order 
+     * @param k      key name string 
+     * @param psign  parent SchemaSignature
+     * @param signs  got SchemaSignatures appended 
+     * @return got number 
+     */
+    uint32_t findNodes(const char *k, SchemaSignature psign, vector<SchemaSignature> &signs);
+
+protected:
+    /** SchemaNode has the name and type */
+    bool isSameNode(SchemaSignature s, const char *k, uint32_t len, int dt_id, uint8_t cate);
+
+    /** add SchemaNode to the index and children info */
+    void indexNode (SchemaSignature s);
 
 public:
     /**
@@ -195,6 +231,14 @@ public:
      */
     static void getNameFromText(string &name, const char *text);
 
+    /**
+     * get node name in the const text string without copy 
+     * @param text    const char text string 
+     * @param len     name length returned
+     * @return name begin in text 
+     */
+    static const char *getNameFromText(const char *text, uint32_t &len);
+
     /**
      * append the node's name to str 
      * @param str       path string name result 
@@ -224,8 +268,29 @@ public:
      * @return 1 success; 0 not defined; <0 failed
      */
     int load(void);
+
+    /**
+     * copy the tree as a read-only snapshot:
+     *   the writer holds getMutex() while it adds nodes
+     * @return snapshot tree owned by caller; nullptr failed
+     */
+    SchemaTree *snapshot(void);
     
 protected:
+    /**
+     * flush block header and binary content to buffer
+     * @param fb    buffer to append
+     * @return 0 success; <0 failed
+     */
+    int flush2buffer(Buffer *fb);
+
+    /**
+     * load binary content in buffer got by flush2buffer
+     * @param lb    buffer with the block
+     * @return 1 success; <0 failed
+     */
+    int load4buffer (Buffer *lb);
+
     /**
      * get dir path from SchemaTree info 
      * @return 0 success; <0 failed
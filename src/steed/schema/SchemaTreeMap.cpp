@@ -27,7 +27,8 @@
 
 namespace steed {
 
-SymbolMap<SchemaTree*> SchemaTreeMap::s_map(16);
+SymbolMap<SchemaTreeRef> SchemaTreeMap::s_map(16);
+std::mutex               SchemaTreeMap::s_mutex;
 
 
 int SchemaTreeMap::
@@ -46,29 +47,49 @@ int SchemaTreeMap::
 
 void SchemaTreeMap::destory(void)
 {
-    // erase and return the next iterator 
-    for (auto itr = s_map.begin(); itr != s_map.end(); itr = s_map.erase(itr))   
-    {
-        delete itr->second;
-        itr->second = nullptr;
-    } // for  
+    std::lock_guard<std::mutex> lk(s_mutex);
+    s_map.clear();
 } // destory 
 
 
 
+void SchemaTreeMap::emplace(const string &db, const string &tb, SchemaTree *t)
+{
+    string sign;
+    getSign(db, tb, sign);
+
+    SchemaTreeRef ref(t);
+    std::lock_guard<std::mutex> lk(s_mutex);
+    s_map.insert(sign, ref);
+} // emplace
+
+
+
+void SchemaTreeMap::erase(const string &db, const string &tb)
+{
+    string sign;
+    getSign(db, tb, sign);
+
+    std::lock_guard<std::mutex> lk(s_mutex);
+    s_map.erase(sign);
+} // erase
+
+
+
 SchemaTree* SchemaTreeMap::lookup(const string &db, const string &tb)
 { 
     string sign;
     getSign(db, tb, sign);
 
+    std::lock_guard<std::mutex> lk(s_mutex);
     auto got = s_map.find(sign);
-    return (got != s_map.end()) ? got->second : nullptr;
+    return (got != s_map.end()) ? got->second.get() : nullptr;
 } // lookup
 
 
 
 int SchemaTreeMap::
-    getDefinedTree(const string &db, const string &tb, SchemaTree* &tree)
+    getLocked(const string &db, const string &tb, SchemaTreeRef &ref)
 {
     string sign;
     getSign(db, tb, sign);
@@ -76,14 +97,109 @@ int SchemaTreeMap::
     auto got =  s_map.find(sign);
     if  (got != s_map.end()) 
     {
-        tree = got->second;
+        ref = got->second;
         return 1;
+    } // if 
+
+    ref.reset(new SchemaTree(db, tb));
+    int status = ref->load();
+    if (status > 0) // success
+    {   s_map.insert(sign, ref);   }
+    else  // failed or not defined yet 
+    {   ref.reset();   }
+    return status;
+} // getLocked
+
+
+
+int SchemaTreeMap::
+    getDefinedTree(const string &db, const string &tb, SchemaTree* &tree)
+{
+    SchemaTreeRef ref;
+    int status = getDefinedTree(db, tb, ref);
+    tree = ref.get(); // still held by the map
+    return status;
+} // getDefinedTree
+
+
+
+int SchemaTreeMap::
+    getDefinedTree(const string &db, const string &tb, SchemaTreeRef &ref)
+{
+    std::lock_guard<std::mutex> lk(s_mutex);
+    return getLocked(db, tb, ref);
+} // getDefinedTree
+
+
+
+int SchemaTreeMap::
+    getSnapshot(const string &db, const string &tb, SchemaTreeRef &ref)
+{
+    std::lock_guard<std::mutex> lk(s_mutex);
+    int status = getLocked(db, tb, ref);
+    if ((status <= 0) || !ref->isWriting())
+    {   return status;   }
+
+    // the writer appends nodes to the shared one: query a copy
+    ref.reset(ref->snapshot());
+    if (ref == nullptr)
+    {
+        printf("SchemaTreeMap: snapshot [%s.%s] failed!\n", db.c_str(), tb.c_str());
+        return -1;
+    } // if 
+    return 1;
+} // getSnapshot
+
+
+
+int SchemaTreeMap::
+    getWritableTree(const string &db, const string &tb, SchemaTreeRef &ref)
+{
+    string sign;
+    getSign(db, tb, sign);
+
+    std::lock_guard<std::mutex> lk(s_mutex);
+    int status = getLocked(db, tb, ref);
+    if (status < 0) { return status; }
+
+    if (status == 0)
+    {
+        // not defined: create an empty one in the map
+        ref.reset(new SchemaTree(db, tb));
+        s_map.insert(sign, ref);
+    }
+    else if (ref->isWriting())
+    {
+        printf("SchemaTreeMap: [%s.%s] is held by another writer!\n", db.c_str(), tb.c_str());
+        ref.reset();
+        return -1;
     }
-    else
+    else if (ref.use_count() > 2) 
     {
-        return load(db, tb, tree);
+        // readers share the tree with the map: copy on write
+        ref.reset(ref->snapshot());
+        if (ref == nullptr)
+        {
+            printf("SchemaTreeMap: copy [%s.%s] failed!\n", db.c_str(), tb.c_str());
+            return -1;
+        } // if 
+        s_map.insert(sign, ref);
     } // if 
-} // getDefinedTree
+
+    ref->setWriting(true);
+    return status;
+} // getWritableTree
+
+
+
+void SchemaTreeMap::releaseWritableTree(SchemaTreeRef &ref)
+{
+    if (ref == nullptr) { return; }
+
+    std::lock_guard<std::mutex> lk(s_mutex);
+    ref->setWriting(false);
+    ref.reset();
+} // releaseWritableTree
 
 
 
@@ -91,12 +207,13 @@ void SchemaTreeMap::output2debug(void)
 {
     puts("STEED SchemaTreeMap::output2debug:");
 
+    std::lock_guard<std::mutex> lk(s_mutex);
     auto  cur_itr  = s_map.begin(), end_itr = s_map.end();
 
     while(cur_itr != end_itr)
     {
         const string &sign = cur_itr->first;
-        SchemaTree   *tree = cur_itr->second; 
+        SchemaTree   *tree = cur_itr->second.get(); 
         printf("[%s] @ [%p]\n", sign.c_str(), tree);
         ++cur_itr;
     } // while  
@@ -26,6 +26,8 @@
 
 #pragma once 
 
+#include <mutex>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -42,12 +44,22 @@ using std::unordered_map;
 using std::string;
 using std::vector;
 
+/** reference-counted SchemaTree handle */
+typedef std::shared_ptr<SchemaTree> SchemaTreeRef;
+
 
 /**
  * @class SchemaTreeMap
  * @brief SchemaTreeMap is a map from database name and collection name to SchemaTree
  * @details
- * SchemaTreeMap is a map from database name and collection name to SchemaTree
+ * SchemaTreeMap is a map from database name and collection name to SchemaTree.
+ * The map is guarded by a mutex and holds SchemaTreeRef handles, a tree is
+ * deleted when the map and the last handle release it. One writer may hold
+ * a table at the same time, readers get read-only snapshots of it:
+ *   getWritableTree: the tree to append, a copy is swapped into the map
+ *                    first if readers hold the old one
+ *   getSnapshot    : the shared tree if no writer holds it, or a copy
+ * The raw pointer functions are kept for single thread tools.
  */
 
 class SchemaTreeMap {
@@ -63,7 +75,10 @@ private:
      * key: database name + Config::s_schema_map_sign_delim + collection name
      * value: SchemaTree pointer
      */
-    static SymbolMap<SchemaTree*>  s_map;
+    static SymbolMap<SchemaTreeRef>  s_map;
+
+    /** guard s_map and SchemaTree::m_writing */
+    static std::mutex  s_mutex;
 
     /**
      * use database and collection name to get sign
@@ -74,6 +89,12 @@ private:
     static void getSign (const string &db, const string &tb, string &sign)
     { sign.assign(db).append(1, Config::s_schema_map_sign_delim).append(tb); }
 
+    /**
+     * lookup SchemaTree in map, or load it from file, s_mutex is held 
+     * @return 1 success; 0 not defined; <0 failed
+     */
+    static int  getLocked(const string &db, const string &tb, SchemaTreeRef &ref);
+
 
 public:
     /**
@@ -83,17 +104,17 @@ public:
     static int  load   (const string &db, const string &tb, SchemaTree* &t);
 
     /**
-     * destory all SchemaTree in the map
+     * destory all SchemaTree in the map, 
+     *   the ones held by handles are deleted when released 
      * @return void
      */
     static void destory(void);
 
 public:
-    static void emplace(const string &db, const string &tb, SchemaTree *t)
-    { string sign; getSign(db, tb, sign); s_map.insert(sign,t); }
+    /** move the SchemaTree ownership to the map */
+    static void emplace(const string &db, const string &tb, SchemaTree *t);
 
-    static void erase  (const string &db, const string &tb)
-    { string sign; getSign(db, tb, sign); s_map.erase (sign)  ; }
+    static void erase  (const string &db, const string &tb);
 
     static SchemaTree* lookup(const string &db, const string &tb); 
 
@@ -111,6 +132,32 @@ public:
      */
     static int getDefinedTree(const string &db, const string &tb, SchemaTree* &tree);
 
+    /**
+     * get SchemaTree handle as getDefinedTree
+     * @return 1 success; 0 not find SchemaTree; <0 failed
+     */
+    static int getDefinedTree(const string &db, const string &tb, SchemaTreeRef &ref);
+
+    /**
+     * get read-only SchemaTree to query: 
+     *   the shared one if no writer holds it, otherwise a snapshot copy 
+     * @return 1 success; 0 not find SchemaTree; <0 failed
+     */
+    static int getSnapshot   (const string &db, const string &tb, SchemaTreeRef &ref);
+
+    /**
+     * get SchemaTree to append records and hold it as the writer,
+     *   an empty one is created if it is not defined 
+     * @return 1 got defined one; 0 created; <0 failed or held by another writer
+     */
+    static int getWritableTree(const string &db, const string &tb, SchemaTreeRef &ref);
+
+    /**
+     * release the SchemaTree got by getWritableTree 
+     * @param ref    handle to release, reset after released
+     */
+    static void releaseWritableTree(SchemaTreeRef &ref);
+
 public: 
     static void output2debug(void);
 }; // SchemaTreeMap
@@ -27,6 +27,7 @@
 #pragma once 
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -35,6 +36,8 @@
 namespace steed {
 namespace SchemaTreePrinter {
 
+using std::pair;
+
 // Debug 
 /** output to debug SchemaTree */
 void output2debug(SchemaTree *tree);
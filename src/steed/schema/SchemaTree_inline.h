@@ -45,9 +45,11 @@ SchemaTree::SchemaTree (const string &db, const string &clt) :
     SchemaSignature rss = SchemaSignature( 0); // root   signature
     r->set(pss, rlvl, rss, rdtid, rfid, rvcat);
 
-    // no need to add root to m_name_map
+    // no need to add root to m_index
     m_names     .emplace_back("");
     m_node_valid.emplace_back(1);
+    m_child_pos .emplace_back(0);
+    m_last_child.emplace_back(0);
 } // ctor 
 
 
@@ -60,7 +62,9 @@ SchemaTree::~SchemaTree(void)
 
     m_names     .clear();
     m_node_valid.clear();
-    m_name_map  .clear();
+    m_index     .clear();
+    m_child_pos .clear();
+    m_last_child.clear();
 } // dtor
 
 
@@ -160,35 +164,73 @@ int SchemaTree::addNode(const char *k, SchemaSignature pidx, int dt_id, uint8_t
     string &nd_name = m_names.back();
     SchemaTree::getNameFromText(nd_name, k);
 
-    SchemaNode::HashKey h(nd_name, pidx);
-    m_name_map.emplace (h, idx);
-
     SchemaNode *p = this->getNode(pidx);
     n->set(p, idx, dt_id, m_next_fid++, vcate);
+    indexNode(idx);
 
     return 0;
 } // addNode
 
 
 
-inline SchemaSignature
-    SchemaTree::findNode(const char *k, SchemaSignature psign, int dt_id, uint8_t cate)
+inline
+void SchemaTree::indexNode(SchemaSignature s)
 {
-    SchemaSignature got_sign(-1); 
-    auto range = this->findNode(k, psign);
-    auto   cur = range.first; 
-    auto   end = range.second; 
-    while (cur != end)
+    const string   &nm  = m_names[s];
+    SchemaSignature pidx = getNode(s)->getParent();
+    uint32_t        sym  = m_index.addSymbol(nm.data(), nm.size());
+    m_index.add(pidx, sym, s);
+
+    // children are appended in signature order 
+    m_child_pos .emplace_back(getNode(pidx)->getChildNum() - 1);
+    m_last_child.emplace_back(0);
+} // indexNode
+
+
+
+inline
+bool SchemaTree::isSameNode(SchemaSignature s, const char *k, uint32_t len,
+        int dt_id, uint8_t cate)
+{
+    SchemaNode   *sn = getNode(s);
+    const string &nm = m_names[s];
+    bool same_dt = (sn->getDataTypeID() == dt_id);
+    bool same_ct = (sn->getCategory() == cate);
+    bool same_nm = (nm.size() == len) && (memcmp(nm.data(), k, len) == 0);
+    return same_dt && same_ct && same_nm;
+} // isSameNode
+
+
+
+inline SchemaSignature SchemaTree::findNode(const char *k, uint32_t len,
+        SchemaSignature psign, int dt_id, uint8_t cate)
+{
+    // try the next child of the last matched one, then itself 
+    SchemaNode *pn   = getNode(psign);
+    uint32_t    cnum = pn->getChildNum();
+    uint32_t    last = m_last_child[psign];
+    uint32_t    next = (last + 1 < cnum) ? (last + 1) : 0;
+    if ((next < cnum) && isSameNode(pn->getChild(next), k, len, dt_id, cate))
+    {   m_last_child[psign] = next; return pn->getChild(next);   }
+    if ((last < cnum) && isSameNode(pn->getChild(last), k, len, dt_id, cate))
+    {   return pn->getChild(last);   }
+
+    uint32_t sym = m_index.findSymbol(k, len);
+    if (sym == SchemaIndex::s_invalid_sym) { return s_invalid_sign; }
+
+    uint64_t pos = 0;
+    SchemaSignature got_sign = m_index.find(psign, sym, pos);
+    while (got_sign != SchemaIndex::s_invalid_sign)
     {
-        SchemaNode* sn = getNode(cur->second);
-        bool same_dt = ((int)sn->getDataTypeID() == dt_id);
+        SchemaNode* sn = getNode(got_sign);
+        bool same_dt = (sn->getDataTypeID() == dt_id);
         bool same_ct = (sn->getCategory() == cate);
         if  (same_dt && same_ct)
         {
-            got_sign = cur->second;
+            m_last_child[psign] = m_child_pos[got_sign];
             break;
         } // if 
-        ++cur;
+        got_sign = m_index.find(psign, sym, pos);
     } // while 
  
     return got_sign; 
@@ -196,6 +238,23 @@ inline SchemaSignature
 
 
 
+inline
+uint32_t SchemaTree::findNodes(const char *k, SchemaSignature psign,
+        vector<SchemaSignature> &signs)
+{
+    uint32_t sym = m_index.findSymbol(k, strlen(k));
+    if (sym == SchemaIndex::s_invalid_sym) { return 0; }
+
+    uint32_t got = 0;
+    uint64_t pos = 0;
+    SchemaSignature s = m_index.find(psign, sym, pos);
+    for (; s != SchemaIndex::s_invalid_sign; s = m_index.find(psign, sym, pos), ++got)
+    {   signs.emplace_back(s);   }
+    return got;
+} // findNodes
+
+
+
 
 inline
 uint32_t SchemaTree::getLowestRepeatedNodeIndex(SchemaPath &path)
@@ -214,10 +273,19 @@ uint32_t SchemaTree::getLowestRepeatedNodeIndex(SchemaPath &path)
 inline
 void SchemaTree::getNameFromText(string &name, const char *text)
 {
-    uint32_t  len = strlen(text);
-    if (*text == '"')  { ++text; len -= 2; }
+    uint32_t    len = 0;
+    const char *nm  = getNameFromText(text, len);
+    name.assign(nm, len);
+} // getNameFromText
+
+
 
-    name.assign(text, len);
+inline
+const char *SchemaTree::getNameFromText(const char *text, uint32_t &len)
+{
+    len = strlen(text);
+    if (*text == '"')  { ++text; len -= 2; }
+    return text;
 } // getNameFromText
 
 
@@ -22,6 +22,9 @@
  * @version 1.0
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <string>
 #include <cstring>
 #include <fstream>
@@ -31,8 +34,12 @@
 
 #include "Config.h"
 #include "Utility.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "ColumnParser.h"
 #include "ColumnAssembler.h"
+#include "OutputSink.h"
 #include "RecordOutput.h"
 #include "SchemaTreeMap.h"
 
@@ -47,12 +54,29 @@ Config g_config;
 
 
 
+// init steed runtime by the loaded g_config
+int initRuntime(void)
+{
+    if (Logger::init(g_config.m_log_level, g_config.m_log_file, g_config.m_log_rate) < 0)
+    {   return -1;   }
+    Metrics::enable(g_config.m_metrics);
+    steedPoolSetCache(g_config.m_mem_pool_cache);
+    MemTracker::process().setLimit(g_config.m_mem_limit);
+    if (!g_config.m_trace_file.empty() &&
+        (Tracer::start(g_config.m_trace_file, g_config.m_trace_format) < 0))
+    {   return -1;   }
+    DataType::initStatic();
+    JSONRecordParser::initStatic();
+    return 0;
+} // initRuntime
+
+
+
 // init steed static data and load config file
 void init(const string &cfile)
 {
     g_config.init(cfile);
-    DataType::initStatic();
-    JSONRecordParser::initStatic();
+    initRuntime();
 } // initStatic
 
 
@@ -60,6 +84,16 @@ void init(const string &cfile)
 // uninit steed static data
 void uninit(void)
 {
+    if (Metrics::enabled())
+    {
+        Metrics::output(stderr);
+        AllocStats as;
+        steedAllocStats(as);
+        as.output(stderr);
+        MemTracker::process().output(stderr);
+    } // if
+    if (Tracer::enabled())  { Tracer::stop(); }
+
     SchemaTreeMap::destory();
     JSONRecordParser::uninitStatic();
     DataType::uninitStatic();
@@ -160,6 +194,7 @@ int dropTable  (const string &db, const string &table)
     string schema_path;
     Utility::getSchemaPath(g_config, db, table, schema_path);
     Utility::removeFile(schema_path);
+    SchemaTreeMap::erase(db, table);
 
     return 1;
 } // dropTable
@@ -200,7 +235,7 @@ void free_string(char *str)
 
 void init(const char *cfile)
 {
-    printf("STEED: init static data\n"); 
+    STEED_LOG(info, "STEED: init static data"); 
     const std::string conf_file(cfile); 
     steed::init(conf_file);    
 } // init
@@ -208,14 +243,14 @@ void init(const char *cfile)
 
 void uninit(void)
 {
-    printf("STEED: uninit static data\n");
+    STEED_LOG(info, "STEED: uninit static data");
     steed::uninit();
 } // uninit
 
 
 int create_database(const char *db)
 {
-    printf("STEED: create database [%s]\n", db);
+    STEED_LOG(info, "STEED: create database [%s]", db);
     const std::string database(db);
     return steed::createDatabase(database);
 } // create_database
@@ -223,7 +258,7 @@ int create_database(const char *db)
 
 int drop_database  (const char *db)
 {
-    printf("STEED: drop database [%s]\n", db);
+    STEED_LOG(info, "STEED: drop database [%s]", db);
     const std::string database(db);
     return steed::dropDatabase(database);
 } // drop_database
@@ -231,7 +266,7 @@ int drop_database  (const char *db)
 
 int create_table(const char *db, const char *table)
 {
-    printf("STEED: create table [%s.%s]\n", db, table);
+    STEED_LOG(info, "STEED: create table [%s.%s]", db, table);
     const std::string database(db), tname(table);
     return steed::createTable(database, tname);
 } // create_table
@@ -239,7 +274,7 @@ int create_table(const char *db, const char *table)
 
 int drop_table  (const char *db, const char *table)
 {
-    printf("STEED: drop table [%s.%s]\n", db, table);
+    STEED_LOG(info, "STEED: drop table [%s.%s]", db, table);
     const std::string database(db), tname(table);
     return steed::dropTable(database, tname);
 } // drop_table
@@ -247,12 +282,12 @@ int drop_table  (const char *db, const char *table)
 
 int parse_file(const char *db, const char *table, const char *jpath)
 {
-    printf("STEED: parse json [%s.%s] from [%s]\n", db, table, jpath);
+    STEED_LOG(info, "STEED: parse json [%s.%s] from [%s]", db, table, jpath);
     const std::string database(db), tname(table), jfile(jpath);
     std::ifstream ifs(jfile);
     if (!ifs.is_open())
     {
-        printf("STEED: cannot open [%s]!\n", jfile.c_str());
+        STEED_LOG(error, "STEED: cannot open [%s]!", jfile.c_str());
         return -1;
     } // ifs
 
@@ -260,7 +295,7 @@ int parse_file(const char *db, const char *table, const char *jpath)
     std::istream *is = &ifs;
     if (cp->init(database, tname, is) < 0)
     {
-        printf("STEED: ColumnParser init failed!\n");
+        STEED_LOG(error, "STEED: ColumnParser init failed!");
         return -1;
     } // if
 
@@ -269,7 +304,7 @@ int parse_file(const char *db, const char *table, const char *jpath)
     {
         ++cnt;
         if (cnt % 100000 == 0)
-        {   printf("STEED: parsed %d records\n", cnt);   }
+        {   STEED_LOG(info, "STEED: parsed %d records", cnt);   }
     } // while
 
     delete cp; cp = nullptr;
@@ -277,28 +312,23 @@ int parse_file(const char *db, const char *table, const char *jpath)
 
     if (status < 0)
     {
-        printf("STEED: insert failed!\n");
+        STEED_LOG(error, "STEED: insert failed!");
         return -1;
     } 
     else
     {
-        printf("STEED: parsed %d records\n", cnt);
+        STEED_LOG(info, "STEED: parsed %d records", cnt);
     } // if
 
     return 1;
 } // parse_file
 
 
-int assemble_to_file(const char *db, const char *table, char **cols, int ncol, const char *jpath)
+// init the assembler on the columns, nullptr if failed
+static steed::ColumnAssembler *openAssembler(const char *db, const char *table,
+    const char **cols, int ncol)
 {
-    printf("STEED: assemble json [%s.%s] to [%s]\n", db, table, jpath);
-    const std::string database(db), tname(table), jfile(jpath);
-    std::ofstream ofs(jfile);
-    if (!ofs.is_open())
-    {
-        printf("STEED: cannot open [%s]!\n", jfile.c_str());
-        return -1;
-    } // ofs
+    const std::string database(db), tname(table);
 
     std::vector< std::string > cols_vec;
     for (int ci = 0; ci < ncol; ++ci)
@@ -307,72 +337,145 @@ int assemble_to_file(const char *db, const char *table, char **cols, int ncol, c
     steed::ColumnAssembler *ca = new steed::ColumnAssembler();
     if (ca->init(database, tname, cols_vec) < 0)
     {
-        printf("STEED: ColumnAssembler init failed!\n");
-        return -1;
+        STEED_LOG(error, "STEED: ColumnAssembler init failed!");
+        delete ca; ca = nullptr;
     } // if
 
+    return ca;
+} // openAssembler
+
+
+// assemble the records as JSON lines to the sink, the assembler is deleted
+static int assemble2Sink(steed::ColumnAssembler *ca, steed::OutputSink *sink)
+{
+    int   ret  = 1;
     char *rbgn = nullptr;
-    std::ostream *ostrm = &ofs;
     steed::RecordOutput ro( ca->getSchemaTree() );
     while (ca->getNext(rbgn) > 0)
-    {   ro.outJSON2Strm(ostrm, rbgn);   } // while
+    {
+        if (ro.outJSON2Sink(sink, rbgn) < 0)
+        {
+            STEED_LOG(error, "STEED: output record failed!");
+            ret = -1;
+            break;
+        } // if
+    } // while
 
     delete ca; ca = nullptr;
-    ofs.close();
-
-    return 1;
-} // assemble_to_file 
+    return ((sink->flush() < 0) ? -1 : ret);
+} // assemble2Sink
 
 
-const char *assemble_to_string(const char *db, const char *table, const char **cols, int ncol)
+int assemble_to_fd(const char *db, const char *table, const char **cols, int ncol, int fd)
 {
-    printf("STEED: assemble json [%s.%s] to string\n", db, table);
-    const std::string database(db), tname(table);
+    STEED_LOG(info, "STEED: assemble json [%s.%s] to fd [%d]", db, table, fd);
+    steed::ColumnAssembler *ca = openAssembler(db, table, cols, ncol);
+    if (ca == nullptr) { return -1; }
 
-    std::vector< std::string > cols_vec;
-    for (int ci = 0; ci < ncol; ++ci)
-    {   cols_vec.emplace_back(cols[ci]);   } // for ci
+    steed::FDSink sink(fd, steed::g_config.m_out_batch_size);
+    return assemble2Sink(ca, &sink);
+} // assemble_to_fd
 
-    steed::ColumnAssembler *ca = new steed::ColumnAssembler();
-    if (ca->init(database, tname, cols_vec) < 0)
+
+int assemble_to_file(const char *db, const char *table, const char **cols, int ncol, const char *jpath)
+{
+    STEED_LOG(info, "STEED: assemble json [%s.%s] to [%s]", db, table, jpath);
+    int fd = ::open(jpath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
     {
-        printf("STEED: ColumnAssembler init failed!\n");
-        return nullptr;
+        STEED_LOG(error, "STEED: cannot open [%s]!", jpath);
+        return -1;
     } // if
 
+    int ret = assemble_to_fd(db, table, cols, ncol, fd);
+    if (::close(fd) < 0)
+    {
+        STEED_LOG(error, "STEED: close [%s] failed!", jpath);
+        ret = -1;
+    } // if
+
+    return ret;
+} // assemble_to_file 
+
+
+int assemble_to_callback(const char *db, const char *table, const char **cols, int ncol,
+    int (*cb)(const char *data, uint64_t len, void *arg), void *arg)
+{
+    STEED_LOG(info, "STEED: assemble json [%s.%s] to callback", db, table);
+    steed::ColumnAssembler *ca = openAssembler(db, table, cols, ncol);
+    if (ca == nullptr) { return -1; }
+
+    steed::CallbackSink sink(cb, arg, steed::g_config.m_out_batch_size);
+    return assemble2Sink(ca, &sink);
+} // assemble_to_callback
+
 
+// assemble the records in a JSON array string, the assembler is deleted
+static const char *assemble2String(steed::ColumnAssembler *ca)
+{
     char *rbgn = nullptr;
     steed::RecordOutput ro( ca->getSchemaTree() );
 
-    bool first = true;
-    std::stringstream ss;
-    ss << "[";
-    while (ca->getNext(rbgn) > 0)
+    bool first = true, ok = true;
+    steed::MemorySink sink;
+    sink.put('[');
+    while (ok && (ca->getNext(rbgn) > 0))
     {
         if (first) { first = false; }
-        else { ss << ","; }
+        else { sink.put(','); }
 
-        ro.outJSON2Strm(&ss, rbgn);
+        ok = (ro.outJSON2Sink(&sink, rbgn) >= 0);
     } 
-    ss << "]";
+    sink.put(']');
 
     delete ca; ca = nullptr;
 
-    std::string str = ss.str();
-    char* cstr = new char[str.length() + 1];
-    strcpy(cstr, str.c_str());
-    return cstr; // NOTE: free this memory in PYTHON
+    if (!ok || !sink.good())
+    {
+        STEED_LOG(error, "STEED: output record failed!");
+        return nullptr; // the sink frees its buffer
+    } // if
+
+    uint64_t len = 0;
+    return sink.release(len); // NOTE: free this memory in PYTHON
+} // assemble2String
+
+
+const char *assemble_to_string(const char *db, const char *table, const char **cols, int ncol)
+{
+    STEED_LOG(info, "STEED: assemble json [%s.%s] to string", db, table);
+    steed::ColumnAssembler *ca = openAssembler(db, table, cols, ncol);
+    return (ca == nullptr) ? nullptr : assemble2String(ca);
 } // assemble_to_string
 
 
+const char *assemble_range_to_string(const char *db, const char *table, const char **cols, int ncol,
+    uint64_t begin, uint64_t end, uint64_t offset, uint64_t limit)
+{
+    STEED_LOG(info, "STEED: assemble json [%s.%s] records [%lu, %lu) offset %lu limit %lu to string",
+        db, table, begin, end, offset, limit);
+    steed::ColumnAssembler *ca = openAssembler(db, table, cols, ncol);
+    if (ca == nullptr) { return nullptr; }
+
+    if ((ca->setRecordRange(begin, end) < 0) || (ca->setLimit(offset, limit) < 0))
+    {
+        STEED_LOG(error, "STEED: ColumnAssembler set range failed!");
+        delete ca; ca = nullptr;
+        return nullptr;
+    } // if
+
+    return assemble2String(ca);
+} // assemble_range_to_string
+
+
 steed::ColumnParser *open_parser(const char *db, const char *table)
 {
-    printf("STEED: open column parser [%s.%s]\n", db, table);
+    STEED_LOG(info, "STEED: open column parser [%s.%s]", db, table);
     const std::string database(db), tname(table);
     steed::ColumnParser *cp = new steed::ColumnParser();
     if (cp->init(database, tname) < 0)
     {
-        printf("STEED: ColumnParser init failed!\n");
+        STEED_LOG(error, "STEED: ColumnParser init failed!");
         return nullptr;
     } // if
 
@@ -387,11 +490,11 @@ int insert_parser(steed::ColumnParser *cp, const char *recd, uint32_t len)
     int64_t s = cp->parseOne(recd, len);
     if (s < 0)
     {
-        printf("STEED: insert record failed!\n");
+        STEED_LOG(error, "STEED: insert record failed!");
         return -1;
     } // if
 
-    printf("STEED: insert record success!\n");
+    STEED_LOG(debug, "STEED: insert record success!");
 
     return 1;
 } // insert_parser
@@ -399,11 +502,85 @@ int insert_parser(steed::ColumnParser *cp, const char *recd, uint32_t len)
 
 void close_parser(steed::ColumnParser *cp)
 {
-    printf("STEED: close column parser\n");
+    STEED_LOG(info, "STEED: close column parser");
     delete cp; cp = nullptr;
 } // close_parser
 
 
+void metrics_enable(int on)
+{
+    steed::Metrics::enable(on != 0);
+} // metrics_enable
+
+
+void metrics_reset(void)
+{
+    steed::Metrics::reset();
+} // metrics_reset
+
+
+uint64_t metrics_counter(const char *name)
+{
+    steed::MetricsSnapshot snap;
+    steed::Metrics::snapshot(snap);
+    for (uint32_t i = 0; i < steed::Metrics::counter_max; ++i)
+    {
+        if (strcmp(name, steed::Metrics::s_counter_name[i]) == 0)
+        {   return snap.m_cnt[i];   }
+    } // for i
+
+    return 0;
+} // metrics_counter
+
+
+const char *metrics_to_string(void)
+{
+    std::string str;
+    steed::Metrics::output2JSON(str);
+
+    char* cstr = new char[str.length() + 1];
+    strcpy(cstr, str.c_str());
+    return cstr; // NOTE: free this memory by free_string
+} // metrics_to_string
+
+
+int log_set_level(const char *level)
+{
+    int l = steed::Logger::getLevel(level);
+    if (l < 0) { return -1; }
+
+    steed::Logger::setLevel(steed::Logger::Level(l));
+    return 0;
+} // log_set_level
+
+
+int log_set_file(const char *path)
+{
+    const std::string fn((path == nullptr) ? "" : path);
+    return steed::Logger::setFile(fn);
+} // log_set_file
+
+
+void log_set_callback(void (*cb)(int level, const char *msg))
+{
+    steed::Logger::setCallback(cb);
+} // log_set_callback
+
+
+int trace_start(const char *path, const char *format)
+{
+    if (path == nullptr) { return -1; }
+    const std::string fn(path), fmt((format == nullptr) ? "json" : format);
+    return steed::Tracer::start(fn, fmt);
+} // trace_start
+
+
+int64_t trace_stop(void)
+{
+    return steed::Tracer::stop();
+} // trace_stop
+
+
 } // extern "C
 
 
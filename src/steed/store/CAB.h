@@ -85,7 +85,7 @@ protected:
 
     CABItemUnit*         m_cur_unit   {nullptr}; /**< current item uint */
     CABItemInfo          m_item_info  { };       /**< current item info */
-    uint32_t             m_bva_bgn_off{0};       /**< bin begin offset  */ 
+    uint64_t             m_bva_bgn_off{0};       /**< bin begin offset  */ 
 
 public: 
     const uint32_t m_align_size{0};
@@ -142,6 +142,14 @@ protected:
      */
     uint64_t getValueUsed (bool tail);
 
+public:
+    /**
+     * calc min and max of fixed size values written in this CAB
+     * @param info    value info to update
+     * @return <0 failed; >=0 non-null value number
+     */
+    int64_t calcValueRange(ColumnValueInfo *info);
+
 
 public:
     /**
@@ -159,6 +167,15 @@ public:
      */
     int writeNull(uint32_t rep, uint32_t def);
 
+    /**
+     * write null items with the same rep and def
+     * @param rep    max repetition value
+     * @param def    max definition value 
+     * @param num    null item number
+     * @return <0 failed; 0 CAB is full; >0 written number, maybe less than num
+     */
+    int64_t writeNull(uint32_t rep, uint32_t def, uint64_t num);
+
     /**
      * write next text item
      * @param rep    max repetition value
@@ -252,6 +269,18 @@ public:
      */
     BitVector *getRepBitsVec(void);
 
+    /**
+     * get rep values unpacked in init2read 
+     * @return rep values array: nullptr when not unpacked 
+     */
+    const uint8_t *getRepLevels(void);
+
+    /**
+     * get def values unpacked in init2read 
+     * @return def values array: nullptr when not unpacked 
+     */
+    const uint8_t *getDefLevels(void);
+
     /**
      * get binary value array to compare in predicates 
      * @return BinaryValueArray ins: nullptr when all items are null 
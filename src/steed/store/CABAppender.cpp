@@ -38,19 +38,26 @@ int CABAppender::init2append(const string &base, SchemaTree* tree, SchemaPath &p
         printf("CABAppender: init base 2 append failed!\n");
         return -1;
     } // init
+    m_cab_cap = cap;
 
 
     // CAB content file
     string cab_bin(base);
     cab_bin.append(".cab");
-    m_cont_buf = new Buffer(0); // buffer to read and modify 
-    if (m_cont_buf->init2modify(cab_bin) < 0) // init as InMemory
+    g_cab_cache.erase(cab_bin); // offset of an empty tail is reused
+    m_cont_buf = new Buffer(0); // buffer to write behind the tail 
+    if (m_cont_buf->init2modify(cab_bin, g_config.m_direct_io) < 0) // init as InMemory
     {
         printf("CABAppender: init Content Buffer 2 modify for append failed!\n");
         return -1;
     } // if 
     m_file_io = m_cont_buf->getFileIO();
     m_layouter = new CABLayouter(m_cont_buf, m_cmp_type);
+    if (initWriteBehind() < 0)
+    {
+        printf("CABAppender: init background writer failed!\n");
+        return -1;
+    } // if 
 
 
     // CAB info file
@@ -64,77 +71,34 @@ int CABAppender::init2append(const string &base, SchemaTree* tree, SchemaPath &p
     } // if 
 
 
-    // check tail CAB is full or not
-    m_cur_info = m_info_buf->getTailInfo2Append();
-    m_recd_num = m_cur_info->getBeginRecdID() + m_cur_info->getRecordNum();
-    m_file_off = m_cur_info->m_file_off;
+    // new CABs are written behind the tail CAB, which is never rewritten:
+    //   the first new CAB ends at the next aligned record 
+    CABInfo *tail = m_info_buf->getTailInfo2Append();
+    if (tail == nullptr)
+    {
+        printf("CABAppender: get tail CABInfo 2 append failed!\n");
+        return -1;
+    } // if 
+    m_recd_num = tail->getBeginRecdID() + tail->getRecordNum();
+    m_file_off = tail->m_file_off + tail->m_strg_size;
+
+    // the empty tail is replaced by the next CAB 
+    if (m_info_buf->popEmptyTail() < 0)
+    {
+        printf("CABAppender: pop empty tail CABInfo failed!\n");
+        return -1;
+    } // if 
 
-    uint32_t tail_cab_recd_num = m_cur_info->getRecordNum();
-    bool cab_is_full = ((tail_cab_recd_num % m_cab_meta.m_recd_cap) == 0);
-    if  (cab_is_full) 
+    if (m_file_io->seekContent(m_file_off, SEEK_SET) == (uint64_t)-1)
     {
-        // tail CAB is full:
-        // seek to the end of CAB content file
-        m_file_off += m_cur_info->m_strg_size;
-        m_file_io->seekContent(m_file_off, SEEK_SET);
-
-        if (prepareCAB2write() < 0)
-        {
-            printf("CABAppender: prepare CAB 2 write failed!\n");
-            return -1;
-        } // if 
-
-        return 0;
-    } 
-    else
+        printf("CABAppender: seek CAB content failed!\n");
+        return -1;
+    } // if 
+
+    if (prepareCAB2write() < 0)
     {
-        // tail CAB is not full, load the tail CAB content
-        if (m_file_io->seekContent(m_file_off, SEEK_SET) == (uint64_t)-1)
-        {
-            printf("CABReader: seek CAB content failed!\n");
-            return -1;
-        } // if 
-
-        m_layouter->clear();
-        if (m_layouter->load(m_cur_info) < 0)
-        {
-            printf("CABReader::  load CAB content failed!\n");
-            return -1;
-        } // if 
-
-        CABInfo info = *m_cur_info;
-        CABMeta meta = m_cab_meta;
-        int buf_used = m_cont_buf->used();
-        Buffer *buf = new Buffer();
-        buf->initInMemory();
-        void* dstbgn = buf->allocate(buf_used, false);
-        void* srcbgn = m_cont_buf->getPosition(0);
-        memcpy(dstbgn, srcbgn, buf_used);
-        m_layouter->clear(); // m_layouter->m_mem_buf is m_cont_buf (@ init)
-
-        BinaryValueArray *bva = BinaryValueArray::create(buf, meta.m_dt);
-        meta.m_buf = buf;
-        meta.m_bva = bva;
-
-        CABItemInfo::Type type = m_cur_info->getType();
-        CAB *tail_cab = new CAB(&meta, &info, buf);
-        int s = tail_cab->init2read(type);
-        if (s < 0)
-        {
-            puts("CABReader: init to read next CAB failed!");
-            return -1;
-        } // if 
-
-        m_cur_cab = new CAB(&m_cab_meta, m_cur_info);
-        m_cur_cab->init2write(m_cur_info->m_item_info.m_bgn_recd);
-        m_cur_cab->copyContent(tail_cab);
-
-        delete tail_cab; tail_cab = nullptr;
-        delete buf; buf = nullptr;
-        delete bva; bva = nullptr;
-
-        // overwrite the tail CAB binary content 
-        m_file_io->seekContent(m_file_off, SEEK_SET);
+        printf("CABAppender: prepare CAB 2 write failed!\n");
+        return -1;
     } // if 
 
     return 0;
@@ -41,7 +41,9 @@ public:
 
 public:
     /**
-     * init ins to append
+     * init ins to append: the tail CAB is kept as it is, and new CABs
+     *   are written behind it, so only the tail CABInfo and the footer
+     *   of the info file are loaded and written back 
      * @param base   data storage base name string
      * @param tree   SchemaTree instance
      * @param path   path in SchemaTree
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file CABCache.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   CABCache functions definitions
+ */
+
+#include "CABCache.h"
+
+namespace steed {
+
+CABCache g_cab_cache;
+
+
+CABCache::~CABCache(void)
+{
+    for (auto &e : m_lru)
+    {   delete e; e = nullptr;   }
+    m_lru.clear();
+    m_index.clear();
+    m_used = 0;
+} // dtor
+
+
+
+std::string CABCache::makeKey(const std::string &file, uint64_t idx, const CABInfo *info)
+{
+    char tail[96] = {0};
+    snprintf(tail, sizeof(tail), "#%lu#%lu#%u#%u", idx,
+        info->m_file_off, info->m_mem_size, info->m_item_info.m_item_num);
+
+    std::string key(file);
+    key.append(tail);
+    return key;
+} // makeKey
+
+
+
+CABCache::Entry *CABCache::lookup(const std::string &key)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+
+    auto found = m_index.find(key);
+    if (found == m_index.end())
+    {
+        ++m_miss;
+        Metrics::add(Metrics::cache_miss);
+        return nullptr;
+    } // if
+
+    // move to front as the most recently used
+    LRUList::iterator it = found->second;
+    m_lru.splice(m_lru.begin(), m_lru, it);
+
+    Entry *ent = *it;
+    ++ent->m_ref;
+    ++m_hit;
+    Metrics::add(Metrics::cache_hit);
+    return ent;
+} // lookup
+
+
+
+CABCache::Entry *CABCache::insert(const std::string &key, const void *cont, uint64_t size)
+{
+    uint64_t budget = g_config.m_cab_cache_size;
+    if ((size == 0) || (size > budget)) { return nullptr; }
+    if (MemTracker::process().pressured()) { return nullptr; }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+
+    // inserted by another reader already
+    auto found = m_index.find(key);
+    if (found != m_index.end())
+    {
+        Entry *ent = *(found->second);
+        ++ent->m_ref;
+        return ent;
+    } // if
+
+    MemTracker::process().consume(steedPoolSize(size), true);
+    char *bin = (char*)steedPoolAlloc(size, false);
+    memcpy(bin, cont, size);
+
+    Entry *ent  = new Entry();
+    ent->m_key  = key;
+    ent->m_cont = bin;
+    ent->m_size = size;
+    ent->m_ref  = 1;
+
+    m_lru.push_front(ent);
+    m_index[key] = m_lru.begin();
+    m_used += size;
+
+    evict();
+    return ent;
+} // insert
+
+
+
+void CABCache::release(Entry *ent)
+{
+    if (ent == nullptr) { return; }
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    assert(ent->m_ref > 0);
+    if ((--ent->m_ref == 0) && ent->m_drop)
+    {   delete ent; return;   } // erased while pinned
+
+    evict();
+} // release
+
+
+
+void CABCache::erase(const std::string &file)
+{
+    std::string prefix(file);
+    prefix.append("#");
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (LRUList::iterator it = m_lru.begin(); it != m_lru.end(); )
+    {
+        LRUList::iterator cur = it++;
+        if ((*cur)->m_key.compare(0, prefix.size(), prefix) == 0)
+        {   remove(cur);   }
+    } // for
+} // erase
+
+
+
+void CABCache::clear(void)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (LRUList::iterator it = m_lru.begin(); it != m_lru.end(); )
+    {   remove(it++);   }
+    m_hit = m_miss = m_evict = 0;
+} // clear
+
+
+
+void CABCache::purge(void)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (LRUList::iterator it = m_lru.begin(); it != m_lru.end(); )
+    {
+        LRUList::iterator cur = it++;
+        if ((*cur)->m_ref > 0) { continue; } // pinned
+
+        remove(cur);
+        ++m_evict;
+    } // for
+} // purge
+
+
+
+void CABCache::evict(void)
+{
+    uint64_t    budget = g_config.m_cab_cache_size;
+    MemTracker &proc   = MemTracker::process();
+    LRUList::iterator it = m_lru.end(); // next to the checking one 
+    while (((m_used > budget) || proc.pressured()) && (it != m_lru.begin()))
+    {
+        LRUList::iterator cur = std::prev(it);
+        if ((*cur)->m_ref > 0) { it = cur; continue; } // pinned
+
+        remove(cur);
+        ++m_evict;
+    } // while
+} // evict
+
+
+
+void CABCache::remove(LRUList::iterator it)
+{
+    Entry *ent = *it;
+    m_used -= ent->m_size;
+    m_index.erase(ent->m_key);
+    m_lru.erase(it);
+
+    // the pinned entry is deleted by the last release
+    if (ent->m_ref > 0) { ent->m_drop = true; }
+    else                { delete ent; }
+} // remove
+
+
+
+void CABCache::output2debug(void)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    printf("CABCache: entry[%lu] used[%lu] budget[%lu] hit[%lu] miss[%lu] evict[%lu]\n",
+        m_lru.size(), m_used, g_config.m_cab_cache_size, m_hit, m_miss, m_evict);
+} // output2debug
+
+} // namespace steed
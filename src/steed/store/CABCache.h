@@ -0,0 +1,166 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file CABCache.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   process-wide LRU cache of decoded CAB content shared by CABReaders
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <list>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+#include "Config.h"
+#include "Allocator.h"
+#include "MemTracker.h"
+#include "Metrics.h"
+#include "CABInfo.h"
+
+namespace steed {
+
+extern Config g_config;
+
+/**
+ * CABCache keeps the decoded (decompressed) CAB content in memory:
+ *   the key is made by the CAB file name, CAB index and CAB info,
+ *   the byte budget is g_config.m_cab_cache_size (0 disables the cache).
+ *   Entries in use are pinned by reference number and never evicted.
+ *   Entries are charged to the process MemTracker: nothing is cached and
+ *   unpinned entries are evicted while the process is pressured.
+ */
+class CABCache {
+public:
+    /** cached decoded CAB content */
+    class Entry {
+    public:
+        std::string m_key {};        /**< cache key string    */
+        char       *m_cont{nullptr}; /**< decoded CAB content */
+        uint64_t    m_size{0};       /**< content size        */
+        uint32_t    m_ref {0};       /**< pinned ref number   */
+        bool        m_drop{false};   /**< erased while pinned */
+
+    public:
+        Entry (void) = default;
+        ~Entry(void)
+        {
+            MemTracker::process().release(steedPoolSize(m_size));
+            steedPoolFree(m_cont, m_size); m_cont = nullptr;
+        } // dtor
+    }; // Entry
+
+protected:
+    typedef std::list<Entry*> LRUList; /**< front is the most recently used */
+
+    LRUList     m_lru  {};  /**< entries in LRU order */
+    std::unordered_map<std::string, LRUList::iterator> m_index{}; /**< key 2 entry */
+
+    uint64_t    m_used {0}; /**< cached content bytes */
+    uint64_t    m_hit  {0}; /**< lookup hit  number   */
+    uint64_t    m_miss {0}; /**< lookup miss number   */
+    uint64_t    m_evict{0}; /**< evicted entry number */
+    std::mutex  m_mutex{};  /**< protect members above */
+
+public:
+    CABCache (void) = default;
+    ~CABCache(void);
+    CABCache (const CABCache&) = delete;
+
+public:
+    bool     enabled    (void) { return g_config.m_cab_cache_size > 0; }
+    uint64_t getUsed    (void) { std::lock_guard<std::mutex> lk(m_mutex); return m_used ; }
+    uint64_t getHitNum  (void) { std::lock_guard<std::mutex> lk(m_mutex); return m_hit  ; }
+    uint64_t getMissNum (void) { std::lock_guard<std::mutex> lk(m_mutex); return m_miss ; }
+    uint64_t getEvictNum(void) { std::lock_guard<std::mutex> lk(m_mutex); return m_evict; }
+
+    /**
+     * make the cache key of a CAB,
+     *   the CAB info part avoids hitting a tail CAB changed by appending
+     * @param file    CAB content file name
+     * @param idx     CAB index in file
+     * @param info    CAB info
+     * @return key string
+     */
+    static std::string makeKey(const std::string &file, uint64_t idx, const CABInfo *info);
+
+public:
+    /**
+     * lookup and pin the cached CAB content
+     * @param key    cache key
+     * @return pinned entry; nullptr as miss
+     */
+    Entry *lookup (const std::string &key);
+
+    /**
+     * copy the decoded CAB content into cache and pin it
+     * @param key     cache key
+     * @param cont    decoded CAB content
+     * @param size    content size
+     * @return pinned entry; nullptr as not cached (larger than the budget
+     *         or the process memory is pressured)
+     */
+    Entry *insert (const std::string &key, const void *cont, uint64_t size);
+
+    /**
+     * unpin the entry got from lookup or insert
+     * @param ent    pinned entry
+     */
+    void   release(Entry *ent);
+
+    /**
+     * drop all cached CABs of the file, called when the file is rewritten
+     * @param file    CAB content file name
+     */
+    void   erase  (const std::string &file);
+
+    /** drop all entries and reset counters, pinned ones are deleted when released */
+    void   clear  (void);
+
+    /** drop all unpinned entries to release memory under pressure */
+    void   purge  (void);
+
+protected:
+    /**
+     * evict unpinned entries from LRU tail until in budget 
+     *   and the process is not pressured, m_mutex is held 
+     */
+    void   evict  (void);
+
+    /** remove entry from LRU and index, m_mutex is held */
+    void   remove (LRUList::iterator it);
+
+public:
+    void output2debug(void);
+}; // CABCache
+
+
+/** the process-wide CAB cache */
+extern CABCache g_cab_cache;
+
+} // namespace steed
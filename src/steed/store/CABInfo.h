@@ -126,6 +126,9 @@ protected:
     uint8_t          m_io_tp{inmem};   /**< buffer init mode   */
     bool             m_got_tail{false};/**< got the tail for append */
 
+    uint64_t         m_info_bgn {0};   /**< index of m_infos[0], tail to append */
+    uint64_t         m_info_off {0};   /**< m_infos[0] offset in file to append */
+
 public: // m_io_tp
     typedef enum Type {
         invalid = 0, 
@@ -155,7 +158,10 @@ public:
     uint64_t getNextIndex(void)       { return m_next_idx; }
     CABInfo* getNextInfo (void)       { return getCABInfo(m_next_idx++); }
     CABInfo* getCABInfo  (uint64_t i)
-    { return (i < m_foot.m_info_used) ? (m_infos + i) : nullptr; }
+    {
+        bool in = (i >= m_info_bgn) && (i < m_foot.m_info_used);
+        return in ? (m_infos + (i - m_info_bgn)) : nullptr;
+    } // getCABInfo
 
     int emplaceTailBack(void);
 
@@ -195,13 +201,16 @@ public: // read
     /**
      * read CAB infos from file 
      * @param n    CAB Info array file name string 
+     * @param mmap view CAB infos in file mapping without copying 
      * @return >0 success; ==0 EOF; <0 failed  
      */
-    int init2read(const string &n);
+    int init2read(const string &n, bool mmap = false);
 
 public: // append
     /**
-     * append more CABinfos to files  
+     * append more CABinfos to files:
+     *   only the footer and the tail CABInfo are loaded, and they are
+     *   written back in place with the appended CABInfos at last 
      * @param n    CAB Info array file name string 
      * @return >0 success; <0 failed 
      */
@@ -213,13 +222,25 @@ public: // append
      */
     CABInfo* getTailInfo2Append(void);
 
+    /**
+     * drop the tail CABInfo without any record, its slot is reused by
+     *   the next CABInfo, the caller must write at least one CABInfo
+     * @return 1 dropped; 0 tail is not empty; <0 failed
+     */
+    int popEmptyTail(void);
+
 private:
     /**
      * read CAB infos from file 
-     * @param n    CAB Info array file name string 
-     * @return >0 success; ==0 EOF; <0 failed  
+     * @param tail   read the tail CABInfo only
+     */
+    void readFile(bool tail = false);
+
+    /**
+     * write the loaded CABInfos and footer back to file in place
+     * @return >0 write bytes as success; <0 failed
      */
-    void readFile(void);
+    int64_t writeBack(void);
 
 public:
     void output2debug (void);
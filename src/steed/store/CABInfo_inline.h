@@ -51,13 +51,18 @@ void CABInfo::output2debug (void)
 inline
 CABInfoBuffer::~CABInfoBuffer(void)
 {
-    for (uint32_t i = 0; i < m_foot.m_info_used; ++i)
-    {   m_infos[i].~CABInfo();   }
+    for (uint64_t i = m_info_bgn; i < m_foot.m_info_used; ++i)
+    {   getCABInfo(i)->~CABInfo();   }
 
-    if ((m_io_tp == write) || (m_io_tp == modify))
+    if (m_io_tp == write)
     {
         appendFooter();
         m_buf->flush2File();
+    }
+    else if (m_io_tp == modify)
+    {
+        appendFooter();
+        writeBack();
     } // if 
 
     delete m_buf; m_buf = nullptr;
@@ -147,9 +152,9 @@ int CABInfoBuffer::appendFooter(void)
 
 
 inline
-int CABInfoBuffer::init2read(const string &n) 
+int CABInfoBuffer::init2read(const string &n, bool mmap) 
 {
-    m_buf = new Buffer(s_init_size); 
+    m_buf = new Buffer(s_init_size, false); // loaded from file
     if (m_buf->init2read(n) < 0)
     {
         printf("CABInfoBuffer: init buffer 2 read failed!\n");
@@ -157,6 +162,13 @@ int CABInfoBuffer::init2read(const string &n)
     } // if 
     m_io_tp = read;
 
+    // CAB infos are read as a whole 
+    if (mmap && (m_buf->mapFile(MADV_WILLNEED) < 0))
+    {
+        printf("CABInfoBuffer: map file 2 read failed!\n");
+        return -1;
+    } // if 
+
     // read CABInfo file
     this->readFile();
 
@@ -180,8 +192,8 @@ int CABInfoBuffer::init2append(const string &n)
     } // if 
     m_io_tp = modify;
 
-    // read CABInfo file
-    this->readFile();
+    // read footer and the tail CABInfo
+    this->readFile(true);
 
     // prepare to read blooming content @ the beginning of file in the future
     FileIO *fb = m_buf->getFileIO();
@@ -209,7 +221,44 @@ CABInfo *CABInfoBuffer::getTailInfo2Append(void)
 
 
 inline
-void CABInfoBuffer::readFile(void)
+int CABInfoBuffer::popEmptyTail(void)
+{
+    CABInfo *tail = getTailInfo();
+    if ((tail == nullptr) || (tail->getRecordNum() > 0)) { return 0; }
+
+    if (m_buf->deallocate(s_info_size) < 0)
+    {
+        printf("CABInfoBuffer: popEmptyTail deallocate failed!\n");
+        return -1;
+    } // if
+
+    tail->~CABInfo();
+    m_foot.m_info_used -= 1;
+    m_next_idx = m_foot.m_info_used;
+    return 1;
+} // popEmptyTail
+
+
+
+inline
+int64_t CABInfoBuffer::writeBack(void)
+{
+    // CABInfos before m_info_bgn are not changed
+    FileIO *fb = m_buf->getFileIO();
+    int64_t got = fb->writeContentAt(m_info_off, m_buf->used(), (const char*)m_buf->data());
+    if (got < 0)
+    {
+        printf("CABInfoBuffer: writeBack @ [%lu] failed!\n", m_info_off);
+        return -1;
+    } // if 
+
+    return got;
+} // writeBack
+
+
+
+inline
+void CABInfoBuffer::readFile(bool tail)
 {
     // load Footer from file tail 
     uint64_t foot_off = uint64_t(-s_foot_size); // man lseek: off_t is a signed integer
@@ -222,11 +271,13 @@ void CABInfoBuffer::readFile(void)
 
 
     // seek and load CABInfo array 
-    uint64_t info_size = s_info_size * m_foot.m_info_used;
+    uint64_t used = m_foot.m_info_used;
+    m_info_bgn = (tail && (used > 0)) ? (used - 1) : 0;
+    uint64_t info_size = s_info_size * (used - m_info_bgn);
     uint64_t info_off  = uint64_t( -(s_foot_size + info_size) );
-    fb->seekContent(info_off, SEEK_END);
+    m_info_off = fb->seekContent(info_off, SEEK_END);
 
-    m_buf->load2Buffer(info_size, true);
+    m_buf->view2Buffer(info_size); // load if not mapped 
     this ->updateMemberPtr();
 } // readFile
 
@@ -245,8 +296,8 @@ void CABInfoBuffer::output2debug (void)
     m_buf->output2debug();
     printf("info @ [%p] next idx:%lu\n", m_infos, m_next_idx);
     printf("------------------------------------------------------------\n");
-    for (uint64_t i = 0; i < m_foot.m_info_used; ++i)
-    {   m_infos[i].output2debug();   }
+    for (uint64_t i = m_info_bgn; i < m_foot.m_info_used; ++i)
+    {   getCABInfo(i)->output2debug();   }
     printf("------------------------------------------------------------\n");
 
     printf("CABInfoBuffer::Footer {valid:%lu, used #:%lu}\n",
@@ -69,6 +69,15 @@ public:
      */ 
     void update (uint32_t rep, uint32_t def, uint32_t max_def);
 
+    /**
+     * update item info by items with the same rep and def
+     * @param rep      ColumnItem rep value 
+     * @param def      ColumnItem def value 
+     * @param max_def  column max def value
+     * @param num      ColumnItem number 
+     */ 
+    void update (uint32_t rep, uint32_t def, uint32_t max_def, uint64_t num);
+
 public:
     void output2debug(void);
 }; // CABItemInfo
@@ -103,6 +112,19 @@ void CABItemInfo::update(uint32_t rep, uint32_t def, uint32_t max_def)
 
 
 
+inline
+void CABItemInfo::update(uint32_t rep, uint32_t def, uint32_t max_def, uint64_t num)
+{
+    assert(rep <= def);
+
+    m_item_num += num; 
+    m_recd_num += (rep == 0) ? num : 0; 
+    m_null_num += (def <  max_def) ? num : 0;
+    m_triv_num +=((def == 0) && (rep == 0)) ? num : 0;
+} // update
+
+
+
 inline
 void CABItemInfo::output2debug(void)
 {
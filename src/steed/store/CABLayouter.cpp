@@ -38,12 +38,29 @@ const uint64_t CABLayouter::s_buf_init_size = 1024 * 1024;
 int64_t CABLayouter::
     flush(bool tail, CABInfo *info, CAB *cab)
 {
+    int64_t dsk_size = encode(tail, info, cab);
+    if (dsk_size <= 0) { return dsk_size; } // failed or trivial
+
+    // flush all content in m_dsk_buf to file 
+    int64_t flushed = m_dsk_buf->flush2File(); 
+    assert(dsk_size == flushed);
+    return flushed;
+} // flush
+
+
+
+int64_t CABLayouter::
+    encode(bool tail, CABInfo *info, CAB *cab)
+{
+    MetricsTimer timer(Metrics::t_encode);
+
     // calc merged CAB binary content to m_mem_buf
     uint64_t mem_size = cab->getMergedUsed(tail);
     bool trivial = (mem_size == 0);
     if  (trivial)
     {
-        // trivial cab flush nothing 
+        // trivial cab flush nothing but its item info 
+        cab->updateInfo();
         info->m_strg_size = 0;
         info->m_dsk_size  = 0;
         info->m_mem_size  = 0;
@@ -84,11 +101,14 @@ int64_t CABLayouter::
         uint32_t cab_bgn_offset = 0;
         void *mem_cab = m_mem_buf->getPosition(cab_bgn_offset); // org cont
         void *dsk_cab = m_dsk_buf->getPosition(cab_bgn_offset); // cmp cont
+        MetricsTimer cmp_timer(Metrics::t_compress);
+        TraceScope   cmp_trace(Tracer::compress);
         if (m_cmp->compress(mem_cab, mem_size, dsk_cab, dsk_size) <= 0)
         {
             printf("CABLayouter: reserve disk buffer failed!\n");
             return -1;
         } // if 
+        Metrics::add(Metrics::bytes_compressed, mem_size);
 
         // m_cmp->compress update dsk_size 
         void  *got =  m_dsk_buf->allocate(dsk_size, false);
@@ -104,11 +124,8 @@ int64_t CABLayouter::
     info->m_dsk_size  = dsk_size; 
     info->m_mem_size  = mem_size; 
 
-    // flush all content in m_dsk_buf to file 
-    int64_t flushed = m_dsk_buf->flush2File(); 
-    assert(dsk_size == uint64_t(flushed));
-    return int64_t(flushed);
-} // flush
+    return int64_t(dsk_size);
+} // encode
 
 
 
@@ -123,9 +140,9 @@ int64_t CABLayouter::load(CABInfo *info)
     // trivial cab has no content
     if (info->m_strg_size == 0) { return 0; }
 
-    // load m_dsk_buf from file and prepare m_mem_buf 
-    int got = m_dsk_buf->load2Buffer(dsk_size, true);
-    if (uint32_t(got) != dsk_size)
+    // load m_dsk_buf from file (or view it in mapping) and prepare m_mem_buf 
+    int64_t got = m_dsk_buf->view2Buffer(dsk_size);
+    if (uint64_t(got) != dsk_size)
     {
         puts("CABLayouter:: load disk content failed!");
         return -1;
@@ -151,12 +168,15 @@ int64_t CABLayouter::load(CABInfo *info)
         uint32_t cab_bgn_offset = 0;
         void   *dsk_cab = m_dsk_buf->getPosition(cab_bgn_offset); // cmp cont 
         void   *mem_cab = m_mem_buf->allocate   (mem_size, false); // org cont 
+        MetricsTimer dec_timer(Metrics::t_decompress);
+        TraceScope   dec_trace(Tracer::decompress);
         int64_t got = m_cmp->decompress(dsk_cab, dsk_size, mem_cab, mem_size); 
         if  (got <= 0)
         {
             printf("CABLayouter: reserve disk buffer failed!\n");
             return -1;
         } // if 
+        Metrics::add(Metrics::bytes_decompressed, mem_size);
     } // if 
 
     return mem_size; 
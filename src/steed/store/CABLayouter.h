@@ -33,6 +33,8 @@
 
 #include "Config.h"
 #include "Buffer.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "CompressorFactory.h"
 
 #include "CAB.h"
@@ -69,9 +71,19 @@ public:
 
     uint64_t getMemoryUsed(void)  { return m_mem_buf->used(); }
     uint64_t getDiskUsed  (void)  { return m_dsk_buf->used(); }
+    Buffer  *getDiskBuffer(void)  { return m_dsk_buf; }
  
 
 public: 
+    /**
+     * encoding memory content to disk layout in m_dsk_buf 
+     * @param tail    tail cab flag  
+     * @param info    cab info to update 
+     * @param cab     cab ins  to encode 
+     * @return >=0 success, disk layout bytes; <0 failed
+     */
+    int64_t encode(bool tail, CABInfo *info, CAB *cab);
+
     /**
      * encoding memory content to disk layout and flush 2 file
      * @param tail    tail cab flag  
@@ -35,7 +35,7 @@ CABLayouter(Buffer *buf, Compressor::Type t) : m_mem_buf(buf), m_dsk_buf(buf)
     m_cmp = CompressorFactory::create(t); 
     if (!m_cmp->noCompressBuf()) 
     {
-        m_dsk_buf = new Buffer(s_buf_init_size);
+        m_dsk_buf = new Buffer(s_buf_init_size, false); // compressed or loaded
         m_dsk_buf->initInMemory ();
 
         FileIO *fio = m_mem_buf->getFileIO();
@@ -40,12 +40,20 @@ int CABReader::init2read(const string &base, SchemaTree* tree, SchemaPath &path,
     // CAB content file
     string cab_bin(base);
     cab_bin.append(".cab");
+    m_cab_file = cab_bin;
+    bool mmap  = g_config.m_mmap_read; // mapping is preferred to O_DIRECT
     m_cont_buf = m_cab_meta.m_buf; // need one Buffer during read  
-    if  (m_cont_buf->init2read(cab_bin) < 0) // init InMemory to read is OK
+    if  (m_cont_buf->init2read(cab_bin, g_config.m_direct_io && !mmap) < 0) // init InMemory to read is OK
     {
         printf("CABReader: init Buffer 2 read failed!\n");
         return -1;
     } // if 
+
+    if  (mmap && (m_cont_buf->mapFile(MADV_SEQUENTIAL) < 0))
+    {
+        printf("CABReader: map CAB file 2 read failed!\n");
+        return -1;
+    } // if 
     m_file_io = m_cab_meta.m_buf->getFileIO();
     m_layouter = new CABLayouter(m_cont_buf, m_cmp_type);
 
@@ -54,7 +62,7 @@ int CABReader::init2read(const string &base, SchemaTree* tree, SchemaPath &path,
     string cab_info(cab_bin);
     cab_info.append(".info");
     m_info_buf = new CABInfoBuffer();
-    if  (m_info_buf->init2read(cab_info) < 0)
+    if  (m_info_buf->init2read(cab_info, mmap) < 0)
     {
         printf("CABReader: init CABInfo 2 write failed!\n");
         return -1; 
@@ -89,6 +97,10 @@ int CABReader::prepareNextCAB(void)
         delete m_cur_cab  ;  m_cur_cab = nullptr;
     } // if 
 
+    // unpin the cached CAB after the content is cleared 
+    g_cab_cache.release(m_cache_ent);
+    m_cache_ent = nullptr;
+
     int s = prepareCABInfo();
     if (s <= 0) { return s; } // failed or EOF
 
@@ -111,6 +123,7 @@ int CABReader::prepareNextCAB(void)
     } // if 
 
     m_rep_vec = m_cur_cab->getRepBitsVec(); 
+    m_rep_lvl = m_cur_cab->getRepLevels (); 
 
     return 1;
 } // prepareNextCAB
@@ -120,6 +133,38 @@ int CABReader::prepareNextCAB(void)
 
 
 int CABReader::prepareBinCont(void)
+{
+    Metrics::add(Metrics::cab_read);
+    TraceScope trace(Tracer::cab_load);
+    if (!g_cab_cache.enabled()) { return loadBinCont(); }
+
+    // decoded CAB in cache: view it without IO and decoding 
+    string key = CABCache::makeKey(m_cab_file, m_cab_idx - 1, m_cur_info);
+    m_cache_ent = g_cab_cache.lookup(key);
+    if (m_cache_ent != nullptr)
+    {
+        m_layouter->clear();
+        char    *cont = m_cache_ent->m_cont;
+        uint64_t size = m_cache_ent->m_size;
+        return (m_cont_buf->view2Buffer(cont, size) < 0) ? -1 : 0;
+    } // if 
+
+    if (loadBinCont() < 0) { return -1; }
+
+    // content viewed in file mapping is shared already 
+    if (!m_cont_buf->isView())
+    {
+        void    *cont = m_cont_buf->data();
+        uint64_t size = m_cont_buf->used();
+        g_cab_cache.release( g_cab_cache.insert(key, cont, size) );
+    } // if 
+
+    return 0;
+} // prepareBinCont
+
+
+
+int CABReader::loadBinCont(void)
 {
     // seek 2 storage content  
     uint64_t off = m_cur_info->m_file_off;
@@ -139,7 +184,7 @@ int CABReader::prepareBinCont(void)
 
 
     return 0;
-} // prepareBinCont
+} // loadBinCont
 
 
 
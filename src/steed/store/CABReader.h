@@ -27,6 +27,7 @@
 #pragma once 
 
 #include "Config.h"
+#include "CABCache.h"
 #include "CABOperator.h"
 
 
@@ -36,7 +37,10 @@ namespace steed {
 class CABReader : virtual public CABOperator {
 protected:
     BitVector         *m_rep_vec{nullptr}; /**< rep bit value vector */
+    const uint8_t     *m_rep_lvl{nullptr}; /**< rep values unpacked  */
     uint32_t           m_cab_idx{0};       /**< CAB (info) read idx  */
+    string             m_cab_file {};      /**< CAB content file     */
+    CABCache::Entry   *m_cache_ent{nullptr}; /**< pinned cached CAB */
 
 
 public:
@@ -128,12 +132,21 @@ public:
     
 protected:
     /**
-     * calc CAB Index 
+     * calc CAB Index: 
+     *    step to the neighbour CAB in sequential reads, 
+     *    binary search CABInfos to seek the far ones
      * @param ridx    record index  
      * @return <0 failed; =0 EOF; >0 success 
      */ 
     int calcCABIndex(uint64_t ridx);
 
+    /**
+     * binary search CAB index in all CABInfos
+     * @param ridx    record index  
+     * @return 1 got; 0 EOF
+     */
+    int searchCABIndex(uint64_t ridx);
+
     /**
      * compare CAB index using record id  
      * @param ridx    record index  
@@ -155,11 +168,18 @@ protected:
     int prepareNextCAB(void); 
 
     /**
-     * get bin content for CAB
+     * get bin content for CAB: view the decoded CAB in g_cab_cache,
+     *   or load it from file and put it into the cache
      * @return 0 success; <0 failed 
      */ 
     int prepareBinCont(void);
 
+    /**
+     * load CAB content from file
+     * @return 0 success; <0 failed 
+     */ 
+    int loadBinCont(void);
+
 //    /**
 //     * load CAB content from file
 //     * @return 1 success; <0 failed
@@ -34,6 +34,12 @@ inline
 CABReader::~CABReader(void)
 {
     m_rep_vec  = nullptr;
+    m_rep_lvl  = nullptr;
+
+    // CAB content may view the cached one 
+    delete m_cur_cab ; m_cur_cab  = nullptr;
+    if (m_cont_buf != nullptr) { m_cont_buf->clear(); }
+    g_cab_cache.release(m_cache_ent); m_cache_ent = nullptr;
 
     m_cont_buf = nullptr;
     m_file_io  = nullptr;
@@ -41,7 +47,6 @@ CABReader::~CABReader(void)
 
     delete m_layouter; m_layouter = nullptr;
     delete m_info_buf; m_info_buf = nullptr;
-    delete m_cur_cab ; m_cur_cab  = nullptr;
 } // dtor
 
 
@@ -121,6 +126,14 @@ void CABReader::getRecdRange(uint64_t bgn, uint64_t &end)
 
     uint32_t bnd = m_rept->encode(0); // 0 is record boundary
     uint64_t cap = getItemNumber  ();
+    if (m_rep_lvl != nullptr)
+    {
+        // unpacked rep values: search the boundary byte
+        const void *got = (end < cap) ? memchr(m_rep_lvl + end, int(bnd), cap - end) : nullptr;
+        end = (got == nullptr) ? cap : uint64_t((const uint8_t*)got - m_rep_lvl);
+        return;
+    } // if 
+
     while  ((end < cap) && (m_rep_vec->get(end) != bnd))
     {   ++end;   } 
 } // getRecdRange
@@ -165,7 +178,9 @@ uint64_t CABReader::getSpecificItemIdx(uint64_t bgn, vector<uint32_t> &vidx)
         while   (cnt < tgt)
         {
             // at least skip 1 item  
-            uint64_t bit =  m_rep_vec->get(++bgn);
+            ++bgn;
+            bool     lvl = (m_rep_lvl != nullptr) && (bgn < getItemNumber());
+            uint64_t bit = lvl ? m_rep_lvl[bgn] : m_rep_vec->get(bgn);
             uint64_t rep =  m_rept->decode(bit);
             if      (rep <  exp)  // no more enough item 
             {   return uint64_t(-1);   } 
@@ -195,16 +210,43 @@ uint64_t CABReader::
 inline
 int CABReader::calcCABIndex(uint64_t ridx)
 {
-    int cmp = 0, got = 0;
-    do {
+    // current or next CAB in sequential reads
+    int cmp = 0;
+    int got = compareCABIndex4Record(ridx, cmp); 
+    if ((got == 1) && (cmp == 0)) { return 1; }
+
+    if ((got == 1) && (cmp > 0))
+    {
+        ++m_cab_idx;
         got = compareCABIndex4Record(ridx, cmp); 
-        m_cab_idx = int64_t(m_cab_idx) + cmp; 
-    } while ((got == 1) && (cmp != 0));
-    return got;
+        if ((got == 1) && (cmp == 0)) { return 1; }
+    } // if 
+
+    return (got < 0) ? got : searchCABIndex(ridx);
 } // calcCABIndex
 
 
 
+inline
+int CABReader::searchCABIndex(uint64_t ridx)
+{
+    uint64_t lo = 0, hi = m_info_buf->getUsedNumber();
+    while (lo < hi)
+    {
+        uint64_t mid  = lo + (hi - lo) / 2;
+        CABInfo *info = m_info_buf->getCABInfo(mid);
+        uint64_t rbgn = info->getBeginRecdID();
+        if      (ridx <  rbgn)                        { hi = mid;     }
+        else if (ridx >= rbgn + info->getRecordNum()) { lo = mid + 1; }
+        else { m_cab_idx = mid; return 1; }
+    } // while 
+
+    m_cab_idx = m_info_buf->getUsedNumber(); // EOF
+    return 0;
+} // searchCABIndex
+
+
+
 inline
 int CABReader::compareCABIndex4Record(uint64_t ridx, int &cmp)
 {
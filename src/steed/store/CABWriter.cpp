@@ -36,19 +36,26 @@ int CABWriter::init2write(const string &base, SchemaTree* tree, SchemaPath &path
         printf("CABWriter: init base 2 write failed!\n");
         return -1;
     } // init 
+    m_cab_cap = cap;
 
 
     // CAB content file
     string cab_bin(base);
     cab_bin.append(".cab");
+    g_cab_cache.erase(cab_bin); // cached CABs are stale
     m_cont_buf = new Buffer(0); // buffered full content 
-    if (m_cont_buf->init2write(cab_bin) < 0)
+    if (m_cont_buf->init2write(cab_bin, g_config.m_direct_io) < 0)
     {
         printf("CABWriter: init buffer @ [%s] 2 write failed!\n", cab_bin.c_str());
         return -1;
     }
     m_file_io = m_cont_buf->getFileIO();
     m_layouter = new CABLayouter(m_cont_buf, m_cmp_type);
+    if (initWriteBehind() < 0)
+    {
+        printf("CABWriter: init background writer failed!\n");
+        return -1;
+    } // if 
     
 
     // CAB info file  
@@ -83,17 +90,36 @@ int CABWriter::init2write(const string &base, SchemaTree* tree, SchemaPath &path
 
 int CABWriter::writeNull(uint32_t rep, uint32_t def, uint64_t nnum)
 {
-    int got = 0;
-    for (uint64_t ni = 0; ni < nnum; ++ni)
+    // update repetition to storage
+    rep = m_rept->encode(rep);
+
+    // nulls are written in bulk until the CAB is full 
+    bool fresh = false;
+    while (nnum > 0)
     {
-        if ((got = writeNull(rep, def)) < 0)
+        int64_t got = m_cur_cab->writeNull(rep, def, nnum);
+        if ((got < 0) || ((got == 0) && fresh))
         {
             puts("CABWriter:: write null failed!\n");
-            break;
+            return -1;
         } // if 
-    } // for 
 
-    return got;
+        if (got == 0)
+        {
+            // CAB is full  
+            bool istail = false;
+            if (flush           (istail) < 0) { return -1; }
+            if (prepareCAB2write()       < 0) { return -1; }
+            fresh = true;
+            continue;
+        } // if 
+
+        m_recd_num += ((rep == 0) ? uint64_t(got) : 0);
+        nnum -= uint64_t(got);
+        fresh = false;
+    } // while 
+
+    return 1;
 } // writeNull
 
 
@@ -138,9 +164,6 @@ int CABWriter::writeText(uint32_t rep, uint32_t def, const char* txt)
     if (retval == 0)
     {
         // CAB is full  
-        mergeValueInfo(
-            &(m_cur_info->m_value_info), m_info_buf->getValueInfo());
-
         bool istail = false; 
         if ((retval = flush     (istail)) < 0) { return retval; }
         if ((retval = prepareCAB2write()) < 0) { return retval; }
@@ -154,9 +177,6 @@ int CABWriter::writeText(uint32_t rep, uint32_t def, const char* txt)
         } // if 
     } // if 
     
-    // write success: update value info 
-    updateValueInfo(bin, &(m_cur_info->m_value_info)); // CAB
-
 #if DEFINE_BLM
     if (m_bloom)
     {   updateBloom(bin, len);   } 
@@ -178,9 +198,6 @@ int CABWriter::writeBinVal(uint32_t rep, uint32_t def, const void* bin, uint32_t
     if (retval == 0)
     {
         // CAB is full  
-        mergeValueInfo(
-            &(m_cur_info->m_value_info), m_info_buf->getValueInfo());
-
         bool istail = false;  
         if ((retval = flush     (istail)) < 0) { return retval; }
         if ((retval = prepareCAB2write()) < 0) { return retval; }
@@ -193,10 +210,7 @@ int CABWriter::writeBinVal(uint32_t rep, uint32_t def, const void* bin, uint32_t
             return -1;
         } // if 
     } // if 
-    
 
-    // write success: update value info 
-    updateValueInfo(bin, &(m_cur_info->m_value_info)); // CAB
 
 #if DEFINE_BLM
     if (m_bloom)
@@ -210,14 +224,59 @@ int CABWriter::writeBinVal(uint32_t rep, uint32_t def, const void* bin, uint32_t
 
 
 
+int CABWriter::initWriteBehind(void)
+{
+    uint32_t pend = g_config.m_write_behind_num;
+    if (pend == 0) { return 0; } // write inline 
+
+    m_bg_writer = new BackgroundWriter();
+    return m_bg_writer->init(m_file_io, pend);
+} // initWriteBehind
+
+
+
+int CABWriter::flushBehind(bool tail)
+{
+    int64_t dsk_size = m_layouter->encode(tail, m_cur_info, m_cur_cab);
+    if (dsk_size <= 0) { return int(dsk_size); } // failed or trivial
+
+    // take the encoded content and leave an empty one to the layouter
+    Buffer *buf = m_bg_writer->acquire();
+    if (buf == nullptr)
+    {
+        puts("CABWriter:: acquire background buffer failed!");
+        return -1;
+    } // if 
+
+    buf->swapContent( *(m_layouter->getDiskBuffer()) );
+    return m_bg_writer->submit(buf, m_cur_info->m_file_off);
+} // flushBehind
+
+
+
 int CABWriter::flush(bool tail)
 {
+    TraceScope trace(Tracer::cab_flush);
+
+    // CAB value info in one batch, then merge to the file's
+    ColumnValueInfo *cab_info = &(m_cur_info->m_value_info);
+    if (updateValueInfo(cab_info) < 0)
+    {
+        puts("CABWriter:: update CAB value info failed!");
+        return -1;
+    } // if
+    mergeValueInfo(cab_info, m_info_buf->getValueInfo());
+
     // flush CAB from mem 2 disk
-    if (m_layouter->flush(tail, m_cur_info, m_cur_cab) < 0)
+    int64_t got = (m_bg_writer == nullptr) ?
+        m_layouter->flush(tail, m_cur_info, m_cur_cab) : flushBehind(tail);
+    if (got < 0)
     {
         puts("CABWriter:: CABLayouter flush CAB failed!");
         return -1;
     } // flush
+    if ((got > 0) && (m_bg_writer == nullptr))
+    {   Metrics::add(Metrics::cab_written);   } // or counted by m_bg_writer
     
 #if DEFINE_BLM
     // flush blooming content of CABInfo file 
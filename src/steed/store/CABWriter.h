@@ -29,6 +29,8 @@
 #include <string>
 
 #include "Utility.h"
+#include "BackgroundWriter.h"
+#include "CABCache.h"
 #include "CABOperator.h"
 
 namespace steed {
@@ -37,6 +39,10 @@ using std::string;
 class CABWriter : virtual public CABOperator {
 public:
     uint64_t    m_file_off{0};  /**< write file offset */
+    uint64_t    m_cab_cap {0};  /**< full CAB record capacity */
+
+protected:
+    BackgroundWriter *m_bg_writer{nullptr}; /**< write-behind CAB content */
 
 public:
     CABWriter (void) = default;
@@ -92,9 +98,30 @@ public:
      */
     int writeBinVal(uint32_t rep, uint32_t def, const void *bin, uint32_t len);
 
+    /**
+     * barrier: wait until flushed CABs are written to file
+     * @return 0 success; <0 failed
+     */
+    int sync(void)
+    {   return (m_bg_writer == nullptr) ? 0 : m_bg_writer->sync();   }
+
+    /**
+     * sync and free the idle write-behind buffers to release memory
+     * @return 0 success; <0 failed
+     */
+    int trim(void)
+    {   return (m_bg_writer == nullptr) ? 0 : m_bg_writer->trim();   }
+
 protected:
     /**
-     * prepare next CAB to write 
+     * start the background writer if write-behind is configured
+     * @return 0 success; <0 failed
+     */
+    int initWriteBehind(void);
+
+    /**
+     * prepare next CAB to write, the CAB ends at the next record aligned
+     *   to m_cab_cap, so it is shorter behind an appended partial CAB 
      * @return <0 failed; =0 EOF; >0 success 
      */ 
     int prepareCAB2write(void); 
@@ -112,6 +139,13 @@ protected:
      */
     int flush(bool tail);
 
+    /**
+     * encode CAB content and hand it over to the background writer
+     * @param tail    flush the tail CAB
+     * @return 0 succes; <0 failed
+     */
+    int flushBehind(bool tail);
+
 protected:
     /**
      * init value info to null content 
@@ -121,12 +155,11 @@ protected:
     int initValueInfo  (ColumnValueInfo *info);
 
     /**
-     * update value info by binary value  
-     * @param bin    bin value used to update
-     * @param info   ColumnValueInfo in CAB or Column 
+     * update value info by the binary values in current CAB
+     * @param info   ColumnValueInfo in CAB
      * @return 0 succes; <0 failed
      */
-    int updateValueInfo(const void *bin, ColumnValueInfo *info); 
+    int updateValueInfo(ColumnValueInfo *info); 
 
     /**
      * merge value info by binary value  
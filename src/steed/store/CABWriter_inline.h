@@ -33,7 +33,13 @@ namespace steed {
 inline
 CABWriter::~CABWriter(void)
 {
-    flush(true);
+    // tail CAB is never reloaded by CABAppender, flush it as the others
+    flush(false);
+
+    // barrier: pending CABs are written before closing the file
+    if ((m_bg_writer != nullptr) && (m_bg_writer->close() < 0))
+    {   printf("CABWriter: background writer close failed!\n");   }
+    delete m_bg_writer; m_bg_writer = nullptr;
 
     m_cur_info = nullptr;
     m_file_io  = nullptr;
@@ -50,11 +56,11 @@ inline
 int CABWriter::prepareCAB2write(void)
 {
     assert (m_cur_cab == nullptr);
-    assert (m_recd_num % g_config.m_cab_recd_num == 0);
 
     // prepare CAB meta 
     m_cab_meta.m_buf->clear ();
     m_cab_meta.m_bva->uninit();
+    m_cab_meta.m_recd_cap = m_cab_cap - m_recd_num % m_cab_cap;
 
     // prepare CAB info  
     int retval = getInfo2Write();
@@ -129,29 +135,10 @@ int CABWriter::initValueInfo  (ColumnValueInfo *info)
 
 
 inline
-int CABWriter::updateValueInfo(const void *bin, ColumnValueInfo *info)
+int CABWriter::updateValueInfo(ColumnValueInfo *info)
 {
-    // fixed size DataType only 
-    DataType* dt = m_cur_cab->getDataType();
-    if (dt->getDefSize() == 0) { return 0; }
-
-    // null OR less tham min 
-    void *min = &(info->m_min);
-    if (!(info->m_has_min) || (dt->compareLess(bin, min) > 0))
-    {
-        info->m_has_min = true;
-        dt->copy(bin, min);
-    } // if 
-
-    // null OR less tham max 
-    void *max = &(info->m_max);
-    if (!(info->m_has_max) || (dt->compareGreater(bin, max) > 0))
-    {
-        info->m_has_max = true;
-        dt->copy(bin, max); 
-    } // if 
-
-    return 0;
+    // fixed size DataType only, once for the whole CAB
+    return (m_cur_cab->calcValueRange(info) < 0) ? -1 : 0;
 } // updateValueInfo 
 
 
@@ -97,6 +97,7 @@ CAB(CABMeta *mt, CABInfo *info, Buffer *buf):
     uint64_t info_num = m_info->m_item_info.m_item_num; 
     uint64_t meta_cap = m_meta->m_recd_cap; /** expecting item num (== rnum) */
     uint32_t cap = info_num > meta_cap ? info_num : meta_cap;
+    cap = Utility::calcAlignSize(cap, 8); // units are merged in whole bytes
     BinaryValueArray *bva = m_meta->m_bva;
     ColumnItemArray  *cia = createCIA(buf, bva, cap);
 
@@ -200,6 +201,34 @@ uint64_t CAB::getValueUsed(bool tail)
 
 
 
+inline
+int64_t CAB::calcValueRange(ColumnValueInfo *info)
+{
+    // fixed size DataType only: min and max are kept in 8 bytes
+    DataType *dt = m_meta->m_dt;
+    int       fs = dt->getDefSize();
+    if ((fs == 0) || (fs > int(sizeof(info->m_min)))) { return 0; }
+
+    // one batch for each unit: bin null slots are skipped
+    int64_t total = 0;
+    for (uint64_t ui = 0; ui <= m_minor_units.size(); ++ui)
+    {
+        CABItemUnit      *u   = (ui == 0) ? m_major_unit : m_minor_units[ui - 1];
+        BinaryValueArray *bva = u->m_cia->getValueArray();
+
+        bool    has = (info->m_has_min != 0);
+        int64_t got = dt->updateMinMax(bva->getContentBegin(),
+            bva->getValueNumber(), &(info->m_min), &(info->m_max), has);
+        if (got < 0) { return got; }
+        if (got > 0) { info->m_has_min = info->m_has_max = true; }
+        total += got;
+    } // for ui
+
+    return total;
+} // calcValueRange
+
+
+
 
 
 inline
@@ -243,6 +272,40 @@ int CAB::writeNull(uint32_t rep, uint32_t def)
 
 
 
+inline
+int64_t CAB::writeNull(uint32_t rep, uint32_t def, uint64_t num)
+{
+    uint64_t done = 0;
+    while ((done < num) && !checkFull(rep))
+    {
+        // each item begins a record when rep is 0
+        uint64_t left = num - done;
+        uint64_t room = m_meta->m_recd_cap - m_item_info.m_recd_num;
+        uint64_t wnum = ((rep == 0) && (room < left)) ? room : left;
+
+        int64_t got = m_cur_unit->m_cia->writeNull(rep, def, wnum);
+        if (got == 0) // current is full 
+        {
+            m_cur_unit = createMinorUnit();
+            m_minor_units.emplace_back(m_cur_unit);
+            got = m_cur_unit->m_cia->writeNull(rep, def, wnum);
+        } // if  
+
+        if (got <= 0)
+        {
+            printf("CAB: writeNull failed!\n");
+            return -1; 
+        } // if 
+
+        m_item_info.update(rep, def, m_meta->m_max_def, uint64_t(got));
+        done += uint64_t(got);
+    } // while
+
+    return int64_t(done);
+} // writeNull
+
+
+
 inline
 int CAB::writeText(uint32_t rep, uint32_t def, const char *txt, const void* &bin)
 {
@@ -381,6 +444,18 @@ BitVector* CAB::getRepBitsVec(void)
 
 
 
+inline
+const uint8_t *CAB::getRepLevels(void)
+{   return m_major_unit->m_cia->getRepLevels();   }
+
+
+
+inline
+const uint8_t *CAB::getDefLevels(void)
+{   return m_major_unit->m_cia->getDefLevels();   }
+
+
+
 inline
 BinaryValueArray* CAB::getBinValueArray(void)
 {   return m_major_unit->m_cia->getValueArray();   }
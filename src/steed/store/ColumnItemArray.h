@@ -59,6 +59,9 @@ protected:
     uint64_t          m_item_cap    {0}; /**< item vector capacity*/
     uint64_t          m_item_num    {0}; /**< item number used    */
 
+    vector<uint8_t>   m_rep_lvls    {};  /**< rep values unpacked to read */
+    vector<uint8_t>   m_def_lvls    {};  /**< def values unpacked to read */
+
     /** ColumnItemArray bin content type */
     CABItemInfo::Type m_type{CABItemInfo::crucial}; 
 
@@ -74,6 +77,14 @@ public:
     BinaryValueArray *getValueArray(void) { return m_values; }
     uint64_t          getItemNumber(void) { return m_item_num; }
 
+    /** @return rep values unpacked by init2read, nullptr as not unpacked */
+    const uint8_t    *getRepLevels (void)
+    { return (m_rep_lvls.size() == m_item_num) ? m_rep_lvls.data() : nullptr; }
+
+    /** @return def values unpacked by init2read, nullptr as not unpacked */
+    const uint8_t    *getDefLevels (void)
+    { return (m_def_lvls.size() == m_item_num) ? m_def_lvls.data() : nullptr; }
+
     /**
      * get rep and def array bytes used 
      * @return rep and def array size
@@ -130,6 +141,13 @@ public: // read
     int read(uint64_t idx, ColumnItem &ci);
 
 
+protected:
+    /**
+     * unpack rep and def values for the reads after init2read
+     */
+    void unpackLevels(void);
+
+
 public: // write 
     /**
      * write null as next value 
@@ -139,6 +157,15 @@ public: // write
      */
     int writeNull(uint32_t rep, uint32_t def);
 
+    /**
+     * write nulls with the same rep and def 
+     * @param rep    next rep  value 
+     * @param def    next def  value 
+     * @param num    null number to write
+     * @return >0 written number; 0 array is full; <0 failed  
+     */
+    int64_t writeNull(uint32_t rep, uint32_t def, uint64_t num);
+
     /**
      * write next ColumnItem: value is text 
      * @param rep    next rep  value 
@@ -139,6 +139,8 @@ int ColumnItemArray::init2read(CABItemInfo::Type type,
     m_defs->init2read(m_item_num, def_size, cbin);
     offset += def_size;
 
+    unpackLevels();
+
 
     // all null CAB read rep and def array  
     if (m_type == CABItemInfo::allnull)  { return 0; }
@@ -156,11 +158,36 @@ int ColumnItemArray::init2read(CABItemInfo::Type type,
 
 
 
+inline
+void ColumnItemArray::unpackLevels(void)
+{
+    m_rep_lvls.clear();
+    m_def_lvls.clear();
+
+    // levels in more than 8 bits are read one by one
+    if ((m_reps->getMaskSize() > 8) || (m_defs->getMaskSize() > 8)) { return; }
+
+    m_rep_lvls.resize(m_item_num);
+    m_def_lvls.resize(m_item_num);
+    if ((m_reps->unpack(0, m_item_num, m_rep_lvls.data()) < 0) ||
+        (m_defs->unpack(0, m_item_num, m_def_lvls.data()) < 0))
+    {
+        m_rep_lvls.clear();
+        m_def_lvls.clear();
+    } // if
+} // unpackLevels
+
+
+
 inline
 int64_t ColumnItemArray::copyContent (ColumnItemArray *cia)
 {
     if (this == cia) { return 0; }
 
+    // unpacked levels are for reading the source content only
+    m_rep_lvls.clear();
+    m_def_lvls.clear();
+
     // clear previous Buffer usage  
     m_buffer->clear();
 
@@ -253,9 +280,18 @@ int ColumnItemArray::read(uint64_t idx, ColumnItem &ci)
                 [[fallthrough]];
         
         case CABItemInfo::allnull: 
-                rep = m_reps-> get(idx);
-                def = m_defs-> get(idx);
-                nrep = (nidx < m_item_num) ? m_reps->get(nidx) : 0; 
+                if (m_def_lvls.size() == m_item_num)
+                {
+                    rep = m_rep_lvls[idx];
+                    def = m_def_lvls[idx];
+                    nrep = (nidx < m_item_num) ? m_rep_lvls[nidx] : 0; 
+                }
+                else
+                {
+                    rep = m_reps-> get(idx);
+                    def = m_defs-> get(idx);
+                    nrep = (nidx < m_item_num) ? m_reps->get(nidx) : 0; 
+                } // if
                 [[fallthrough]];
         
         case CABItemInfo::trivial: 
@@ -296,6 +332,35 @@ int ColumnItemArray::writeNull(uint32_t rep, uint32_t def)
 
 
 
+inline
+int64_t ColumnItemArray::writeNull(uint32_t rep, uint32_t def, uint64_t num)
+{
+    uint64_t left = m_item_cap - m_item_num;
+    uint64_t wnum = (num < left) ? num : left;
+    if (wnum == 0) { return 0; }
+
+    if ((m_reps->append(rep, wnum) < 0) || (m_defs->append(def, wnum) < 0))
+    {
+        printf("ColumnItemArray: write rep and def failed!\n");
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < wnum; ++i)
+    {
+        if (m_values->writeNull() < 0)
+        {
+            printf("ColumnItemArray: write null failed!\n");
+            return -1;
+        }
+    } // for i
+
+    m_item_num += wnum; 
+    
+    return int64_t(wnum);
+} // writeNull
+
+
+
 inline
 int ColumnItemArray::
     writeText(uint32_t rep, uint32_t def, const char *txt, const void* &bin)
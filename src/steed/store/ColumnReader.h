@@ -55,6 +55,9 @@ protected:
     uint64_t           m_recd_idx  {0};  /**< read record index */
     uint64_t           m_item_idx  {0};  /**< read item   index */
 
+    vector<uint64_t>   m_cmp_bits  {};   /**< compared value bits */
+    vector<uint8_t>    m_def_lvls  {};   /**< def values read one by one */
+
 
 public:
     ColumnReader (void) = default;
@@ -141,6 +144,24 @@ public:
      */
     void prepareItemBitmap(BitMap *bitmap);
 
+    /**
+     * compare the items in current CAB with a const, nulls are never true:
+     *   the value array is compared in one batch, then the value bits
+     *   are mapped to the items by the def levels
+     * @param cmp_op_id  compare operation id
+     * @param cst        const binary value to compare
+     * @param bitmap     set bit for each true item
+     * @return >=0 true item number; <0 failed
+     */
+    int64_t compareItems(int cmp_op_id, const void *cst, BitMap *bitmap);
+
+protected:
+    /**
+     * get def values of the items in current CAB
+     * @return def values array; nullptr as failed
+     */
+    const uint8_t *getDefLevels(void);
+
 public:
     void output2debug(void);
 }; // ColumnReader
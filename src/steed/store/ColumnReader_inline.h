@@ -150,6 +150,83 @@ void ColumnReader::prepareItemBitmap(BitMap *bitmap)
 
 
 
+inline
+int64_t ColumnReader::compareItems(int cmp_op_id, const void *cst, BitMap *bitmap)
+{
+    prepareItemBitmap(bitmap);
+    CABItemInfo::Type type = m_read->getType();
+    if (type != CABItemInfo::crucial) { return 0; } // no value stored
+
+    const uint8_t *defs = getDefLevels();
+    if (defs == nullptr) { return -1; }
+
+    // fixed size values are stored for all items, others for leaf items
+    BinaryValueArray *bva = m_read->getBinValueArray();
+    DataType *dt  = m_read->getDataType();
+    bool      fix = dt->isFixedType();
+    uint32_t  def = getPathDepth(); // only the leaf value is compared
+    uint64_t  num = m_read->getItemNumber();
+    uint64_t  vnum = num, vbgn = 0;
+    if (!fix)
+    {
+        vnum = 0;
+        for (uint64_t ii = 0; ii < num; ++ii) { vnum += (defs[ii] == def); }
+        while ((vbgn < num) && (defs[vbgn] != def)) { ++vbgn; }
+    } // if 
+    if (vnum == 0) { return 0; }
+
+    const void *bins = bva->read(vbgn);
+    m_cmp_bits.resize((vnum + 63) / 64);
+    if ((bins == nullptr) ||
+        (dt->compareConst(cmp_op_id, bins, vnum, cst, m_cmp_bits.data()) < 0))
+    {
+        printf("ColumnReader: compare [%lu] values failed!\n", vnum);
+        return -1;
+    } // if 
+
+    // map the value bits to the items by def levels
+    uint64_t vi = 0;
+    for (uint64_t ii = 0; ii < num; ++ii)
+    {
+        bool     leaf = (defs[ii] == def);
+        uint64_t bi   = fix ? ii : vi;
+        if (leaf && ((m_cmp_bits[bi / 64] >> (bi % 64)) & 1))
+        {   bitmap->setByBit(ii, 1);   }
+        vi += leaf;
+    } // for ii
+
+    return bitmap->getSetBitNum();
+} // compareItems
+
+
+
+inline
+const uint8_t *ColumnReader::getDefLevels(void)
+{
+    const uint8_t *defs = m_read->getCurCAB()->getDefLevels();
+    if (defs != nullptr) { return defs; }
+
+    // levels in more than 8 bits are not unpacked by the CAB
+    ColumnItem ci;
+    uint64_t   num = m_read->getItemNumber();
+    m_def_lvls.resize(num);
+    for (uint64_t ii = 0; ii < num; ++ii)
+    {
+        if (m_read->read(ii, ci) <= 0)
+        {
+            printf("ColumnReader: read item [%lu] failed!\n", ii);
+            return nullptr;
+        } // if 
+        m_def_lvls[ii] = uint8_t(ci.getDef() < UINT8_MAX ? ci.getDef() : UINT8_MAX);
+    } // for ii
+
+    return m_def_lvls.data();
+} // getDefLevels
+
+
+
+
+
 inline
 void ColumnReader::output2debug(void)
 {
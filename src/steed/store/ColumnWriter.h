@@ -63,6 +63,7 @@ public:
     SchemaPath       &getLeafPath (void) { return m_leaf_path; } 
     const string     &getFileName (void) { return m_file_name; }
     CAB              *getCurCAB   (void) { return m_cab_op->getCurCAB (); }
+    DataType         *getDataType (void) { return m_cab_op->getDataType(); }
 
     uint64_t  getValidRecdIdx(void) { return m_cab_op->getValidRecdIdx(); }
 
@@ -110,6 +111,17 @@ public:
     int writeText  (uint32_t rep, uint32_t def, const char* txt)
     { return m_cab_op->writeText(rep, def, txt); }
 
+    int writeBinVal(uint32_t rep, uint32_t def, const void* bin, uint32_t len)
+    { return m_cab_op->writeBinVal(rep, def, bin, len); }
+
+    /** wait until flushed CABs are written, see CABWriter::sync */
+    int sync       (void)
+    { return m_cab_op->sync(); }
+
+    /** free idle write-behind buffers, see CABWriter::trim */
+    int trim       (void)
+    { return m_cab_op->trim(); }
+
 public:
     void output2debug(void);
 }; // ColumnWriter
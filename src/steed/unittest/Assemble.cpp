@@ -16,3 +16,831 @@
 
 
 
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include "Config.h"
+#include "Utility.h"
+////// Below is the test for steed assemble 
+namespace steed {
+// define global config
+steed::Config g_config;
+} // namespace steed
+
+static const std::string test_db("demo");
+
+
+#include "ColumnParser.h"
+/**
+ * parse JSON text behind the records of a parsed table
+ * @param tb     table name
+ * @param json   JSON records one by line
+ * @return parsed record number; <0 failed
+ */
+static int64_t appendTestTable(const std::string &tb, const std::string &json)
+{
+    using namespace steed;
+    std::istringstream is(json);
+    ColumnParser *cp = new ColumnParser();
+    int64_t got = (cp->init(test_db, tb, &is) < 0) ? -1 : 0;
+    int64_t s   = 0;
+    while ((got >= 0) && ((s = cp->parseOne()) > 0)) { ++got; }
+    delete cp; cp = nullptr; // flush all CABs
+    return (s < 0) ? s : got;
+} // appendTestTable
+
+
+/**
+ * parse JSON text into a new table for the assemble tests,
+ *   16 records in each CAB to cross the CAB boundaries
+ * @param tb     table name
+ * @param json   JSON records one by line
+ * @return parsed record number; <0 failed
+ */
+static int64_t parseTestTable(const std::string &tb, const std::string &json)
+{
+    using namespace steed;
+    g_config.m_store_base   = "/tmp/steed_assemble_test";
+    g_config.m_cab_recd_num = 16;
+
+    std::string schema, data;
+    Utility::getSchemaDir(g_config, test_db, schema);
+    Utility::getDataDir  (g_config, test_db, tb, data);
+    if (Utility::checkFileExisted(data)) { Utility::removeDir(data); }
+    Utility::makeDir(schema);
+    Utility::makeDir(data);
+
+    std::string path;
+    Utility::getSchemaPath(g_config, test_db, tb, path);
+    Utility::removeFile(path);
+    return appendTestTable(tb, json);
+} // parseTestTable
+
+
+
+#include "ColumnAssembler.h"
+/** @return nested records with repeated objects in repeated objects */
+static std::string makeNestedJSON(void)
+{
+    std::string json;
+    for (int i = 0; i < 8; ++i)
+    {
+        std::string id = std::to_string(i);
+        json += "{\"id\":" + id + ",\"r\":[";
+        for (int j = 0; j <= i % 3; ++j)
+        {
+            json += (j == 0) ? "" : ",";
+            json += "{\"x\":" + id + ",\"s\":[{\"y\":1},{\"y\":2,\"z\":3}]}";
+        } // for j
+        json += "],\"o\":{\"p\":" + id + ",\"q\":[1,2,3],\"t\":{\"u\":[4,5]}}}\n";
+    } // for i
+    return json;
+} // makeNestedJSON
+
+
+#include "FSMTable.h"
+/** FSMTable getting levels by the neighbour loop as before the level tables */
+class StepFSMTable : public steed::FSMTable {
+public:
+    int initByStep(steed::SchemaTree *tree, steed::QueryPathes &path)
+    {
+        m_tree = tree;
+        initCommonLevel(tree, path);
+        std::vector< std::vector<uint32_t> > trans;
+        if (initTransTable(path, trans) < 0) { return -1; }
+        initFSMTable(trans);
+        return 0;
+    } // initByStep
+}; // StepFSMTable
+
+
+TEST(steedAssembleTest, testFSMTable)
+{
+    using namespace steed;
+    std::string tb("testFSMTable");
+    ASSERT_EQ(parseTestTable(tb, makeNestedJSON()), 8);
+
+    std::vector<std::string> cols{"id", "r.x", "r.s.y", "r.s.z", "o.p", "o.q", "o.t.u"};
+    ColumnAssembler ca;
+    ASSERT_EQ(ca.init(test_db, tb, cols), 0);
+    EXPECT_FALSE(ca.isFlat());
+
+    QueryPathes path(*ca.getQueryPathes());
+    path.sortByParent();
+    uint32_t cnum = path.size();
+    ASSERT_EQ(cnum, cols.size());
+
+    // every prefix of the columns as one projection
+    SchemaTree *tree = ca.getSchemaTree();
+    for (uint32_t pnum = 1; pnum <= cnum; ++pnum)
+    {
+        QueryPathes sub;
+        for (uint32_t pi = 0; pi < pnum; ++pi) { sub.emplace_back(path[pi]); }
+
+        FSMTable tab;
+        StepFSMTable step;
+        ASSERT_EQ(tab.init(tree, sub), 0);
+        ASSERT_EQ(step.initByStep(tree, sub), 0);
+        ASSERT_EQ(tab.m_com_rep_tab .size(), pnum * pnum);
+        ASSERT_EQ(tab.m_low_same_tab.size(), pnum * pnum);
+        EXPECT_TRUE(step.m_com_rep_tab.empty());
+        EXPECT_EQ(tab.getMaxPathSize(), step.getMaxPathSize());
+
+        // transition table
+        for (uint32_t col = 0; col < pnum; ++col)
+        {
+            for (uint32_t rep = 0; rep < tab.getMaxPathSize(); ++rep)
+            {   EXPECT_EQ(tab.get(col, rep), step.get(col, rep)) << col << ":" << rep;   }
+        } // for col
+
+        // return level tables
+        for (uint32_t tgt = 0; tgt < pnum; ++tgt)
+        {
+            SchemaPath &tsp = sub[tgt];
+            for (uint32_t cur = 0; cur <= tgt; ++cur)
+            {
+                EXPECT_EQ(tab.getCommonReptLevel(tgt, tsp, cur),
+                         step.getCommonReptLevel(tgt, tsp, cur)) << tgt << ":" << cur;
+                EXPECT_EQ(tab.getLowestSameLevel(tgt, tsp, cur),
+                         step.getLowestSameLevel(tgt, tsp, cur)) << tgt << ":" << cur;
+            } // for cur
+        } // for tgt
+    } // for pnum
+
+    // some repeated levels are shared and some are not
+    FSMTable tab;
+    ASSERT_EQ(tab.init(tree, path), 0);
+    std::vector<uint32_t> reps(tab.m_com_rep_tab);
+    std::sort(reps.begin(), reps.end());
+    EXPECT_GT(std::unique(reps.begin(), reps.end()) - reps.begin(), 2);
+} // testFSMTable
+
+
+
+/**
+ * 40 records: id is the record index,
+ *   name is missing in every 5th record, opt is in 20 ~ 23 only
+ */
+static std::string makeFilterJSON(void)
+{
+    std::string json;
+    for (int i = 0; i < 40; ++i)
+    {
+        json += "{\"id\": " + std::to_string(i);
+        if (i % 5 != 4)            { json += ", \"name\": \"n" + std::to_string(i) + "\""; }
+        if ((i >= 20) && (i < 24)) { json += ", \"opt\": " + std::to_string(i); }
+        json += ", \"tags\": [1, 2]}\n";
+    } // for i
+    return json;
+} // makeFilterJSON
+
+
+/**
+ * assemble all records of the projection into binary rows
+ * @param tb     table name
+ * @param cols   projected column names
+ * @param flat   use RecordFlatAssembler or RecordNestedAssembler
+ * @param rows   assembled binary rows
+ * @return assembled record number; <0 failed
+ */
+static int64_t assembleAll(const std::string &tb, const std::vector<std::string> &cols,
+    bool flat, std::string &rows)
+{
+    using namespace steed;
+    ColumnAssembler ca; // parse and sort the column names
+    if (ca.init(test_db, tb, cols) < 0) { return -1; }
+    if (ca.isFlat() != true)            { return -1; }
+
+    SchemaTree *tree = ca.getSchemaTree();
+    QueryPathes path(*ca.getQueryPathes());
+    string dir;
+    Utility::getDataDir(g_config, test_db, tb, dir);
+
+    vector<ColumnReader*> crds;
+    for (uint32_t i = 0; i < path.size(); ++i)
+    {
+        crds.emplace_back(new ColumnReader());
+        crds.back()->init2read(dir, tree, path[i]);
+    } // for i
+
+    AssembleColumn acol;
+    acol.init(&path, crds);
+    acol.updateColumn(0);
+
+    Buffer buf(1 << 20, false);
+    RecordFlatAssembler   *fa = flat ? new RecordFlatAssembler  (&buf, tree) : nullptr;
+    RecordNestedAssembler *na = flat ? nullptr : new RecordNestedAssembler(&buf, tree);
+    int got = flat ? fa->init(&acol) : na->init(&acol);
+
+    uint64_t ridx = 0;
+    while (got >= 0)
+    {
+        if (acol.need2update(ridx))
+        {
+            acol.updateColumn(ridx);
+            got = flat ? fa->reinit(&acol) : na->reinit(&acol);
+            if (got < 0) { break; }
+        } // if
+
+        for (auto &rd : acol.getCurrentColRead())
+        {
+            got = rd->prepare2ReadRecord(ridx);
+            if (got <= 0) { break; }
+        } // for rd
+        if (got <= 0) { break; }
+
+        got = flat ? fa->assemble() : na->assemble();
+        if (got <= 0) { break; }
+        ridx += got;
+    } // while
+
+    rows.assign((const char*)buf.getPosition(0), buf.used());
+    delete fa; delete na; // clear buf
+    for (auto &rd : crds) { delete rd; }
+    return (got < 0) ? got : int64_t(ridx);
+} // assembleAll
+
+
+TEST(steedAssembleTest, testFlatAssembler)
+{
+    using namespace steed;
+    std::string ftb("testFlatAssembler"), ntb("testFlatAssemblerNested");
+    ASSERT_EQ(parseTestTable(ftb, makeFilterJSON()), 40);
+    ASSERT_EQ(parseTestTable(ntb, makeNestedJSON()), 8);
+
+    std::vector< std::pair<std::string, std::vector<std::string>> > projs{
+        {ftb, {"id"}}, {ftb, {"id", "name"}}, {ftb, {"name", "opt"}},
+        {ftb, {"opt", "id", "name"}}, {ntb, {"id", "o.p"}}, {ntb, {"o.p"}}};
+    for (auto &pj : projs)
+    {
+        std::string flat, nest;
+        int64_t rnum = (pj.first == ftb) ? 40 : 8;
+        EXPECT_EQ(assembleAll(pj.first, pj.second, true , flat), rnum);
+        EXPECT_EQ(assembleAll(pj.first, pj.second, false, nest), rnum);
+        EXPECT_FALSE(flat.empty());
+        EXPECT_TRUE (flat == nest) << pj.first << ":" << pj.second[0];
+    } // for pj
+} // testFlatAssembler
+
+
+
+#include "SchemaTreeMap.h"
+#include "ColumnFilter.h"
+/**
+ * select records by the filter 
+ * @param tb     table name
+ * @param cond   filter condition
+ * @param sel    selected record indexes
+ * @return 0 success; <0 failed
+ */
+static int selectByFilter(const std::string &tb, const std::string &cond,
+    std::vector<uint64_t> &sel)
+{
+    using namespace steed;
+    SchemaTreeRef ref;
+    if (SchemaTreeMap::getSnapshot(test_db, tb, ref) <= 0) { return -1; }
+
+    std::string dir;
+    Utility::getDataDir(g_config, test_db, tb, dir);
+    ColumnFilter filter;
+    if (filter.init(dir, ref.get(), cond) < 0) { return -1; }
+
+    sel.clear();
+    uint64_t ridx = 0;
+    int      got  = 0;
+    while ((got = filter.next(ridx)) > 0) { sel.emplace_back(ridx++); }
+    EXPECT_EQ(filter.getSelectedNum(), sel.size());
+    return got;
+} // selectByFilter
+
+
+TEST(steedAssembleTest, testColumnFilter)
+{
+    using namespace steed;
+    std::string tb("testColumnFilter");
+    ASSERT_EQ(parseTestTable(tb, makeFilterJSON()), 40);
+
+    // condition parsing: blanks around path, op and value
+    std::vector<uint64_t> sel, exp;
+    EXPECT_EQ(selectByFilter(tb, "  id   <  3 ", sel), 0);
+    EXPECT_EQ(sel, (std::vector<uint64_t>{0, 1, 2}));
+
+    // bad conditions, ops, consts and repeated pathes are rejected
+    EXPECT_LT(selectByFilter(tb, "id <", sel), 0);
+    EXPECT_LT(selectByFilter(tb, "id ~ 3", sel), 0);
+    EXPECT_LT(selectByFilter(tb, "id like 3", sel), 0);
+    EXPECT_LT(selectByFilter(tb, "id == abc", sel), 0);
+    EXPECT_LT(selectByFilter(tb, "nokey == 3", sel), 0);
+    EXPECT_LT(selectByFilter(tb, "tags == 1", sel), 0);
+
+    // selections across the CAB boundaries at 16 and 32
+    EXPECT_EQ(selectByFilter(tb, "id >= 14", sel), 0);
+    exp.clear();
+    for (uint64_t i = 14; i < 40; ++i) { exp.emplace_back(i); }
+    EXPECT_EQ(sel, exp);
+
+    EXPECT_EQ(selectByFilter(tb, "id != 20", sel), 0);
+    EXPECT_EQ(sel.size(), 39);
+
+    // missing values are never selected 
+    EXPECT_EQ(selectByFilter(tb, "name != \"n13\"", sel), 0);
+    exp.clear();
+    for (uint64_t i = 0; i < 40; ++i)
+    {   if ((i % 5 != 4) && (i != 13)) { exp.emplace_back(i); }   }
+    EXPECT_EQ(sel, exp);
+
+    EXPECT_EQ(selectByFilter(tb, "name == \"n33\"", sel), 0);
+    EXPECT_EQ(sel, (std::vector<uint64_t>{33}));
+
+    // the column is all missing in the first CAB
+    EXPECT_EQ(selectByFilter(tb, "opt >= 0", sel), 0);
+    EXPECT_EQ(sel, (std::vector<uint64_t>{20, 21, 22, 23}));
+    EXPECT_EQ(selectByFilter(tb, "opt < 21", sel), 0);
+    EXPECT_EQ(sel, (std::vector<uint64_t>{20}));
+} // testColumnFilter
+
+
+
+#include "RecordOutput.h"
+/**
+ * read the record ids in the JSON records got by the ColumnAssembler
+ * @param ca     ColumnAssembler inited with the id column
+ * @param ids    got record ids
+ * @return got record number; <0 failed
+ */
+static int64_t readRecordIds(steed::ColumnAssembler &ca, std::vector<uint64_t> &ids)
+{
+    using namespace steed;
+    RecordOutput ro(ca.getSchemaTree());
+
+    ids.clear();
+    char   *rbgn = nullptr;
+    int32_t got  = 0;
+    while ((got = ca.getNext(rbgn)) > 0)
+    {
+        std::ostringstream os;
+        if (ro.outJSON2Strm(&os, rbgn) < 0) { return -1; }
+
+        std::string recd = os.str();
+        size_t pos = recd.find("\"id\"");
+        if (pos == std::string::npos) { return -1; }
+        pos = recd.find_first_not_of(": ", pos + 4);
+        ids.emplace_back(strtoull(recd.c_str() + pos, nullptr, 10));
+    } // while
+
+    return (got < 0) ? got : int64_t(ids.size());
+} // readRecordIds
+
+
+/** @return record number got by getNext */
+static int64_t countRecords(steed::ColumnAssembler &ca)
+{
+    char   *rbgn = nullptr;
+    int64_t num  = 0;
+    int32_t got  = 0;
+    while ((got = ca.getNext(rbgn)) > 0) { ++num; }
+    return (got < 0) ? got : num;
+} // countRecords
+
+
+TEST(steedAssembleTest, testRecordRange)
+{
+    using namespace steed;
+    std::string tb("testRecordRange");
+    ASSERT_EQ(parseTestTable(tb, makeFilterJSON()), 40);
+
+    std::vector<uint64_t> ids, exp;
+    {
+        // a range across the CAB boundaries at 16 and 32
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id"}), 0);
+        EXPECT_LT(ca.setRecordRange(20, 10), 0);
+        EXPECT_EQ(ca.setRecordRange(10, 35), 0);
+        EXPECT_EQ(readRecordIds(ca, ids), 25);
+        for (uint64_t i = 10; i < 35; ++i) { exp.emplace_back(i); }
+        EXPECT_EQ(ids, exp);
+        EXPECT_LT(ca.setRecordRange(0), 0); // after reading
+        EXPECT_LT(ca.setLimit(0), 0);
+    }
+
+    {
+        // offset and limit without range, the limit passes the tail
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id", "name"}), 0);
+        EXPECT_EQ(ca.setLimit(30, 20), 0);
+        EXPECT_EQ(countRecords(ca), 10);
+    }
+
+    {
+        // offset is not less than the range size
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(ca.setRecordRange(10, 20), 0);
+        EXPECT_EQ(ca.setLimit(10), 0);
+        EXPECT_EQ(readRecordIds(ca, ids), 0);
+
+        ColumnAssembler cb;
+        ASSERT_EQ(cb.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(cb.setRecordRange(10, 20), 0);
+        EXPECT_EQ(cb.setLimit(15), 0);
+        EXPECT_EQ(countRecords(cb), 0);
+    }
+
+    {
+        // limit 0 reads nothing
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(ca.setLimit(0, 0), 0);
+        EXPECT_EQ(readRecordIds(ca, ids), 0);
+
+        ColumnAssembler cb;
+        ASSERT_EQ(cb.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(cb.setLimit(0, 0), 0);
+        EXPECT_EQ(countRecords(cb), 0);
+    }
+
+    {
+        // range and filter: offset and limit count the selected ones
+        std::string cond("name != \"n13\"");
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id"}, cond), 0);
+        EXPECT_EQ(ca.setRecordRange(10, 20), 0);
+        EXPECT_EQ(readRecordIds(ca, ids), 7);
+        EXPECT_EQ(ids, (std::vector<uint64_t>{10, 11, 12, 15, 16, 17, 18}));
+
+        ColumnAssembler cb;
+        ASSERT_EQ(cb.init(test_db, tb, {"id"}, cond), 0);
+        EXPECT_EQ(cb.setRecordRange(10, 20), 0);
+        EXPECT_EQ(cb.setLimit(1, 3), 0);
+        EXPECT_EQ(readRecordIds(cb, ids), 3);
+        EXPECT_EQ(ids, (std::vector<uint64_t>{11, 12, 15}));
+    }
+} // testRecordRange
+
+
+TEST(steedAssembleTest, testMissingTable)
+{
+    using namespace steed;
+    // a missing table fails the init instead of reading nothing
+    ColumnAssembler ca;
+    EXPECT_LT(ca.init(test_db, "testMissingTable", {"id"}), 0);
+} // testMissingTable
+
+
+
+/**
+ * read the record ids in the column items got by the ColumnAssembler
+ * @param ca     ColumnAssembler inited with the id column first
+ * @param ids    got record ids
+ * @return got record number; <0 failed
+ */
+static int64_t readItemIds(steed::ColumnAssembler &ca, std::vector<uint64_t> &ids)
+{
+    using namespace steed;
+    SchemaPath &sp = ca.getQueryPathes()->get(0);
+    DataType   *dt = ca.getSchemaTree()->getDataType(sp[sp.size() - 1]);
+
+    ids.clear();
+    char txt[64] = {0};
+    std::vector<ColumnItem> items;
+    int got = 0;
+    while ((got = ca.getNextItems(items)) > 0)
+    {
+        if (dt->transBin2Txt(items[0].getBin(), txt, sizeof(txt)) < 0) { return -1; }
+        ids.emplace_back(strtoull(txt, nullptr, 10));
+    } // while
+
+    return (got < 0) ? got : int64_t(ids.size());
+} // readItemIds
+
+
+TEST(steedAssembleTest, testColumnItems)
+{
+    using namespace steed;
+    std::string tb("testColumnItems"), ntb("testColumnItemsNested");
+    ASSERT_EQ(parseTestTable(tb , makeFilterJSON()), 40);
+    ASSERT_EQ(parseTestTable(ntb, makeNestedJSON()), 8);
+
+    std::vector<uint64_t> ids, exp;
+    {
+        // one item for each column, def 0 as missing
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id", "opt"}), 0);
+        std::vector<ColumnItem> items;
+        int64_t rnum = 0, onum = 0;
+        int32_t got  = 0;
+        while ((got = ca.getNextItems(items)) > 0)
+        {
+            ASSERT_EQ(items.size(), 2);
+            bool has = (rnum >= 20) && (rnum < 24);
+            EXPECT_EQ(items[1].getDef() > 0, has) << rnum;
+            onum += has;
+            ++rnum;
+        } // while
+        EXPECT_EQ(got , 0);
+        EXPECT_EQ(rnum, 40);
+        EXPECT_EQ(onum, 4);
+    }
+
+    {
+        // range, filter and limit are applied to the items
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(ca.setRecordRange(10, 35), 0);
+        EXPECT_EQ(readItemIds(ca, ids), 25);
+        for (uint64_t i = 10; i < 35; ++i) { exp.emplace_back(i); }
+        EXPECT_EQ(ids, exp);
+
+        ColumnAssembler cb;
+        ASSERT_EQ(cb.init(test_db, tb, {"id"}, "name != \"n13\""), 0);
+        EXPECT_EQ(cb.setRecordRange(10, 20), 0);
+        EXPECT_EQ(cb.setLimit(1, 3), 0);
+        EXPECT_EQ(readItemIds(cb, ids), 3);
+        EXPECT_EQ(ids, (std::vector<uint64_t>{11, 12, 15}));
+
+        ColumnAssembler cc;
+        ASSERT_EQ(cc.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(cc.setLimit(0, 0), 0);
+        EXPECT_EQ(readItemIds(cc, ids), 0);
+    }
+
+    {
+        // repeated fields have no single item for each record
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, ntb, {"id", "r.x"}), 0);
+        std::vector<ColumnItem> items;
+        EXPECT_LT(ca.getNextItems(items), 0);
+    }
+} // testColumnItems
+
+
+
+#include "OutputSink.h"
+#include "ColumnOutput.h"
+/**
+ * output the projection by ColumnOutput
+ * @param fmt    "csv", "tsv" or "columnar"
+ * @param cap    record number in each binary batch
+ * @param out    output content
+ * @return 0 success; <0 failed
+ */
+static int outputColumns(const std::string &tb, const std::vector<std::string> &cols,
+    const std::string &fmt, uint64_t cap, std::string &out)
+{
+    using namespace steed;
+    ColumnAssembler ca;
+    if (ca.init(test_db, tb, cols) < 0) { return -1; }
+
+    MemorySink   sink;
+    ColumnOutput co(ca.getSchemaTree(), ca.getQueryPathes(), cap);
+    bool bin   = (fmt == "columnar");
+    char delim = (fmt == "tsv") ? '\t' : ',';
+    int  got   = bin ? co.outBinHeader(&sink) : co.outCSVHeader(&sink, delim);
+
+    std::vector<ColumnItem> items;
+    while ((got >= 0) && ((got = ca.getNextItems(items)) > 0))
+    {   got = bin ? co.appendBin(&sink, items) : co.outCSV2Sink(&sink, items, delim);   }
+    if ((got >= 0) && bin) { got = co.outBinFooter(&sink); }
+
+    out.assign(sink.getData(), sink.size());
+    return got;
+} // outputColumns
+
+
+/** @return strings need quoting and JSON escapes */
+static std::string makeStringJSON(void)
+{
+    return "{\"id\":0,\"s\":\"plain\"}\n"
+           "{\"id\":1,\"s\":\"a,b\"}\n"
+           "{\"id\":2,\"s\":\"say \\\"hi\\\"\"}\n"
+           "{\"id\":3,\"s\":\"l1\\nl2\\t\\u00e9\\/\"}\n"
+           "{\"id\":4}\n";
+} // makeStringJSON
+
+
+/** read a value of T from out at off and move off after it */
+template <typename T>
+static T readValue(const std::string &out, uint64_t &off)
+{
+    T val{};
+    if (off + sizeof(T) <= out.size()) { memcpy(&val, out.data() + off, sizeof(T)); }
+    off += sizeof(T);
+    return val;
+} // readValue
+
+
+/** read a buffer led by its byte length and padded to 8 bytes */
+static std::string readBuffer(const std::string &out, uint64_t &off)
+{
+    uint64_t len = readValue<uint64_t>(out, off);
+    std::string buf = out.substr(std::min(off, uint64_t(out.size())), len);
+    off += len + (8 - len % 8) % 8;
+    return buf;
+} // readBuffer
+
+
+TEST(steedAssembleTest, testColumnOutputCSV)
+{
+    using namespace steed;
+    std::string tb("testColumnOutputCSV"), out;
+    ASSERT_EQ(parseTestTable(tb, makeStringJSON()), 5);
+    ASSERT_EQ(outputColumns(tb, {"s"}, "csv", 0, out), 0);
+    EXPECT_EQ(out, "s\nplain\n\"a,b\"\n\"say \"\"hi\"\"\"\n\"l1\nl2\t\xc3\xa9/\"\n\n");
+
+    // TSV: the comma is plain, the tab is quoted
+    ASSERT_EQ(outputColumns(tb, {"id", "s"}, "tsv", 0, out), 0);
+    EXPECT_EQ(out, "id\ts\n0.000000\tplain\n1.000000\ta,b\n"
+                   "2.000000\t\"say \"\"hi\"\"\"\n3.000000\t\"l1\nl2\t\xc3\xa9/\"\n"
+                   "4.000000\t\n");
+
+    // JSON numbers are doubles in the "%lf" text, missing ones are empty
+    std::string ntb("testColumnOutputCSVNum"), exp("id,opt\n");
+    ASSERT_EQ(parseTestTable(ntb, makeFilterJSON()), 40);
+    ASSERT_EQ(outputColumns(ntb, {"id", "opt"}, "csv", 0, out), 0);
+    for (int i = 0; i < 40; ++i)
+    {
+        std::string val = std::to_string(double(i)); // "%f"
+        bool        has = (i >= 20) && (i < 24);
+        exp += val + "," + (has ? val : "") + "\n";
+    } // for i
+    EXPECT_EQ(out, exp);
+} // testColumnOutputCSV
+
+
+TEST(steedAssembleTest, testColumnOutputBinary)
+{
+    using namespace steed;
+    std::string tb("testColumnOutputBinary"), out;
+    ASSERT_EQ(parseTestTable(tb, makeStringJSON()), 5);
+    ASSERT_EQ(outputColumns(tb, {"id", "s"}, "columnar", 2, out), 0);
+
+    // header
+    uint64_t off = 0;
+    ASSERT_GT(out.size(), 8);
+    EXPECT_EQ(out.substr(0, 8), "STEEDCOL");  off += 8;
+    EXPECT_EQ(readValue<uint32_t>(out, off), 1);  // version
+    EXPECT_EQ(readValue<uint32_t>(out, off), 2);
+    const char *names[] = {"id", "s"};
+    uint32_t    tids [2] = {0};
+    for (uint32_t ci = 0; ci < 2; ++ci)
+    {
+        tids[ci] = readValue<uint32_t>(out, off);
+        uint32_t nlen = readValue<uint32_t>(out, off);
+        EXPECT_EQ(out.substr(off, nlen), names[ci]);  off += nlen;
+    } // for ci
+    EXPECT_EQ(tids[1], uint32_t(DataType::s_type_string));
+    int idsz = DataType::s_type_ins[tids[0]]->getDefSize();
+
+    // batches of 2, 2 and 1 records, the last s is missing
+    std::vector<std::string> strs{"plain", "a,b", "say \"hi\"", "l1\nl2\t\xc3\xa9/"};
+    uint64_t rbgn = 0, rnum = 0;
+    while ((rnum = readValue<uint64_t>(out, off)) > 0)
+    {
+        ASSERT_EQ(rnum, std::min(uint64_t(2), 5 - rbgn));
+
+        // id: validity and fixed size values
+        uint64_t    vo    = 0;
+        std::string valid = readBuffer(out, off);
+        std::string data  = readBuffer(out, off);
+        EXPECT_EQ(readValue<uint64_t>(valid, vo), (uint64_t(1) << rnum) - 1);
+        ASSERT_EQ(data.size(), rnum * idsz);
+        for (uint64_t ri = 0; ri < rnum; ++ri)
+        {
+            char txt[64] = {0};
+            DataType::s_type_ins[tids[0]]->transBin2Txt(&data[ri * idsz], txt, sizeof(txt));
+            EXPECT_EQ(strtoull(txt, nullptr, 10), rbgn + ri);
+        } // for ri
+
+        // s: validity, i32 offsets and chars
+        vo    = 0;
+        valid = readBuffer(out, off);
+        std::string offs = readBuffer(out, off);
+        data  = readBuffer(out, off);
+        uint64_t bits = readValue<uint64_t>(valid, vo);
+        ASSERT_EQ(offs.size(), (rnum + 1) * sizeof(int32_t));
+        const int32_t *oa = (const int32_t*)offs.data();
+        EXPECT_EQ(oa[0], 0);
+        EXPECT_EQ(uint64_t(oa[rnum]), data.size());
+        for (uint64_t ri = 0; ri < rnum; ++ri)
+        {
+            bool has = (rbgn + ri < strs.size());
+            EXPECT_EQ((bits >> ri) & 1, has ? 1 : 0);
+            std::string str = data.substr(oa[ri], oa[ri + 1] - oa[ri]);
+            EXPECT_EQ(str, has ? strs[rbgn + ri] : "");
+        } // for ri
+        rbgn += rnum;
+    } // while
+
+    EXPECT_EQ(rbgn, 5);
+    EXPECT_EQ(off , out.size()); // ended by record number 0
+} // testColumnOutputBinary
+
+
+
+
+#include "ColumnReader.h"
+/**
+ * records in [bgn, end): id is the record index,
+ *   extra is in every 3rd record of 16 ~ 31 only
+ */
+static std::string makeAppendJSON(int bgn, int end)
+{
+    std::string json;
+    for (int i = bgn; i < end; ++i)
+    {
+        json += "{\"id\": " + std::to_string(i) + ", \"name\": \"n" + std::to_string(i) + "\"";
+        if ((i >= 16) && (i < 32) && (i % 3 == 1)) { json += ", \"extra\": " + std::to_string(i); }
+        json += "}\n";
+    } // for i
+    return json;
+} // makeAppendJSON
+
+
+TEST(steedAssembleTest, testAppend)
+{
+    using namespace steed;
+    std::string tb("testAppend");
+
+    // the tail CAB is not full, new CABs are written behind it:
+    //   10 ~ 15 end at the aligned record, 32 leaves an empty tail CABInfo
+    ASSERT_EQ(parseTestTable (tb, makeAppendJSON( 0, 10)), 10);
+    ASSERT_EQ(appendTestTable(tb, makeAppendJSON(10, 32)), 22);
+    ASSERT_EQ(appendTestTable(tb, makeAppendJSON(32, 35)),  3);
+
+    {
+        // all records are assembled back in order,
+        //   extra is missing in the CAB before it appeared
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id", "extra"}), 0);
+        SchemaPath &sp = ca.getQueryPathes()->get(1);
+        DataType   *dt = ca.getSchemaTree()->getDataType(sp[sp.size() - 1]);
+
+        char txt[64] = {0};
+        std::vector<ColumnItem> items;
+        uint64_t rid  = 0;
+        int64_t  hnum = 0;
+        int32_t  got  = 0;
+        while ((got = ca.getNextItems(items)) > 0)
+        {
+            ASSERT_EQ(items.size(), 2);
+            bool has = (rid >= 16) && (rid < 32) && (rid % 3 == 1);
+            ASSERT_EQ(items[1].getDef() > 0, has) << rid;
+            if (has)
+            {
+                ASSERT_GE(dt->transBin2Txt(items[1].getBin(), txt, sizeof(txt)), 0);
+                EXPECT_EQ(strtod(txt, nullptr), double(rid));
+                ++hnum;
+            } // if
+            ++rid;
+        } // while
+        EXPECT_EQ(got , 0);
+        EXPECT_EQ(rid , 35);
+        EXPECT_EQ(hnum, 6);
+
+        std::vector<uint64_t> ids, exp;
+        ColumnAssembler cb;
+        ASSERT_EQ(cb.init(test_db, tb, {"id"}), 0);
+        EXPECT_EQ(readRecordIds(cb, ids), 35);
+        for (uint64_t i = 0; i < 35; ++i) { exp.emplace_back(i); }
+        EXPECT_EQ(ids, exp);
+    }
+
+    {
+        // CABs of the old column and of the appended one
+        ColumnAssembler ca;
+        ASSERT_EQ(ca.init(test_db, tb, {"id", "extra"}), 0);
+        QueryPathes *path = ca.getQueryPathes();
+        std::string dir;
+        Utility::getDataDir(g_config, test_db, tb, dir);
+
+        ColumnReader id, extra;
+        ASSERT_EQ(id   .init2read(dir, ca.getSchemaTree(), path->get(0)), 0);
+        ASSERT_EQ(extra.init2read(dir, ca.getSchemaTree(), path->get(1)), 0);
+
+        // the empty tail CABInfo is replaced, the others are kept
+        CABInfoBuffer info;
+        ASSERT_GT(info.init2read(id.getFileName() + ".cab.info"), 0);
+        std::vector<uint64_t> rbgn{0, 10, 16, 32}, rnum{10, 6, 16, 3};
+        ASSERT_EQ(info.getUsedNumber(), rbgn.size());
+        for (uint64_t i = 0; i < rbgn.size(); ++i)
+        {
+            EXPECT_EQ(info.getCABInfo(i)->getBeginRecdID(), rbgn[i]) << i;
+            EXPECT_EQ(info.getCABInfo(i)->getRecordNum  (), rnum[i]) << i;
+        } // for i
+
+        // extra starts at the CAB of its first value, and has no value
+        //   in the appended tail
+        CABReader *rd = extra.getCABReader();
+        ASSERT_GT(extra.loadCAB4Record(16), 0);
+        EXPECT_EQ(rd->getCABBeginRid(), 16);
+        EXPECT_EQ(rd->getItemNumber (), 16);
+        ASSERT_GT(extra.loadCAB4Record(32), 0);
+        EXPECT_TRUE(rd->isAllNullCAB() || rd->isTrivialCAB());
+        EXPECT_EQ(rd->getCABBeginRid(), 32);
+        EXPECT_EQ(rd->getItemNumber (),  3);
+    }
+} // testAppend
@@ -36,6 +36,65 @@ TEST(steedBaseTest, testDataTypeString)
 } // testConfig
 
 
+TEST(steedBaseTest, testDataTypeBatch)
+{
+    using namespace steed;
+    DataType *dt = DataType::getDataType(DataType::s_type_int_32);
+    const char *txts[] = {"7", nullptr, "-12", "40", "3"};
+    int32_t  bins[5] = {0};
+    uint64_t bits[1] = {0};
+    char     txt [64] = {0};
+
+    EXPECT_EQ(dt->transTxt2Bins(txts, 5, bins, sizeof(bins)), 20);
+    EXPECT_EQ(dt->transTxt2Bins(txts, 5, bins, sizeof(bins) - 1), -1);
+    EXPECT_EQ(bins[1], INT32_MIN); // bin null
+    EXPECT_EQ(dt->transBin2Txts(bins, 5, txt, sizeof(txt), ','), 15);
+    EXPECT_STREQ(txt, "7,null,-12,40,3");
+
+    const void *cst = dt->trans2BinConst("5");
+    EXPECT_EQ(dt->compareConst(DataType::s_cmp_less, bins, 5, cst, bits), 2);
+    EXPECT_EQ(bits[0], 0x14u);
+    EXPECT_EQ(dt->compareConst(DataType::s_cmp_not_equal, bins, 5, cst, bits), 4);
+    EXPECT_EQ(dt->compareConst(DataType::s_cmp_like, bins, 5, cst, bits), -1);
+    free((void*)cst); cst = nullptr;
+
+    int32_t min = 0, max = 0;
+    EXPECT_EQ(dt->updateMinMax(bins, 5, &min, &max, false), 4);
+    EXPECT_EQ(min, -12);
+    EXPECT_EQ(max,  40);
+
+    // string walks the values by '\0'
+    dt = DataType::getDataType(DataType::s_type_string);
+    const char *strs[] = {"\"ab\"", "\"b\"", "\"abc\""};
+    char sbin[16] = {0};
+    EXPECT_EQ(dt->transTxt2Bins(strs, 3, sbin, sizeof(sbin)), 9);
+    EXPECT_EQ(dt->transBin2Txts(sbin, 3, txt, sizeof(txt), '\t'), 14);
+    EXPECT_STREQ(txt, "\"ab\"\t\"b\"\t\"abc\"");
+    EXPECT_EQ(dt->compareConst(DataType::s_cmp_greater, sbin, 3, "ab", bits), 2);
+    EXPECT_EQ(bits[0], 0x6u);
+    EXPECT_EQ(dt->compareConst(DataType::s_cmp_substr, sbin, 3, "bc", bits), 1);
+    EXPECT_EQ(bits[0], 0x4u);
+
+    // out of range integers fail instead of wrapping
+    dt = DataType::getDataType(DataType::s_type_int_8);
+    const char *i8s[] = {"127", "-127", "128"};
+    int8_t i8b[3] = {0};
+    EXPECT_EQ(dt->transTxt2Bins(i8s, 2, i8b, sizeof(i8b)), 2);
+    EXPECT_EQ(i8b[1], -127);
+    EXPECT_EQ(dt->transTxt2Bins(i8s, 3, i8b, sizeof(i8b)), -1);
+    EXPECT_EQ(dt->transTxt2Bin ("-129", i8b, sizeof(i8b)), -1);
+
+    dt = DataType::getDataType(DataType::s_type_int_16);
+    int16_t i16 = 0;
+    EXPECT_EQ(dt->transTxt2Bin ("32767", &i16, sizeof(i16)), 2);
+    EXPECT_EQ(dt->transTxt2Bin ("70000", &i16, sizeof(i16)), -1);
+
+    dt = DataType::getDataType(DataType::s_type_int_64);
+    int64_t i64 = 0;
+    EXPECT_EQ(dt->transTxt2Bin ("99999999999999999999", &i64, sizeof(i64)), -1);
+} // testDataTypeBatch
+
+
 #include "BinaryValueArray.h"
 namespace steed {
 // define global config
@@ -49,6 +108,23 @@ TEST(steedBaseTest, testBinaryValueArray)
     Buffer *buf = new Buffer(4096);
     BinaryValueArray *bva = new VarLengthValueArray(buf, dt);
     EXPECT_EQ(bva->inited(), false);
+    EXPECT_EQ(bva->getOffsetSize(), sizeof(uint32_t));
+    delete bva; bva = nullptr;
+
+    bva = BinaryValueArray::create(buf, dt);
+
+    const int cap = 4;
+    char offs[cap * sizeof(uint32_t)] = {0};
+    EXPECT_EQ(bva->init2write(sizeof(offs), offs), 0);
+    const void *bin = nullptr;
+    uint32_t    len = 0;
+    EXPECT_EQ(bva->writeText("\"var\"", bin), 1);
+    EXPECT_EQ(bva->writeNull(), 1);
+    EXPECT_EQ(bva->getOffsetArrayUsed(), 2 * sizeof(uint32_t));
+    EXPECT_EQ(((uint32_t*)offs)[0], 0);
+    EXPECT_EQ(((uint32_t*)offs)[1], uint32_t(-1));
+    EXPECT_EQ(dt->compareEqual(bin, "var"), 1);
+    EXPECT_EQ(bva->read(1, bin, len), 0);
     delete bva; bva = nullptr;
     delete buf; buf = nullptr;
 } // testBinaryValueArray
@@ -125,3 +125,121 @@ TEST(steedSchemaTest, testSchemaTree)
     delete t;
     t = nullptr;
 } // testSchemaTree 
+
+
+
+TEST(steedSchemaTest, testSchemaIndex)
+{
+    using namespace steed;
+    std::string db("debug"), col("idx"); 
+    SchemaTree *t  = new SchemaTree(db, col);
+    int    dt = DataType::s_type_int_64;
+    uint8_t vc = SchemaNode::s_vcat_single;
+
+    // wide object: grow the slots several times
+    const uint32_t  wide = 300;
+    char name[32];
+    for (uint32_t i = 0; i < wide; ++i)
+    {
+        snprintf(name, sizeof(name), "\"f%u\"", i);
+        EXPECT_EQ (t->addNode(name, 0, dt, vc), 0);
+    } // for i
+
+    // the same field order and the shuffled order get the same nodes 
+    for (uint32_t r = 0; r < 3; ++r)
+    {
+        for (uint32_t i = 0; i < wide; ++i)
+        {
+            uint32_t fi = (r == 2) ? (i * 7 % wide) : i;
+            snprintf(name, sizeof(name), "f%u", fi);
+            EXPECT_EQ (t->findNode(name, 0, dt, vc), fi + 1);
+        } // for i
+    } // for r
+    SchemaSignature miss = SchemaTree::s_invalid_sign;
+    EXPECT_EQ (t->findNode("f1", 0, DataType::s_type_string, vc), miss);
+    EXPECT_EQ (t->findNode("f1", 1, dt, vc), miss);
+    EXPECT_EQ (t->findNode("none", 0, dt, vc), miss);
+    EXPECT_EQ (t->findNode("f12", 2, 0, dt, vc), 2); // "f1" in length 2
+
+    // the same name under parents and types, found in defined order 
+    EXPECT_EQ (t->addNode("f0", 1, dt, vc), 0);
+    EXPECT_EQ (t->addNode("f0", 0, DataType::s_type_string, vc), 0);
+    EXPECT_EQ (t->addNode("f0", 0, DataType::s_type_double, vc), 0);
+    vector<SchemaSignature> signs;
+    EXPECT_EQ (t->findNodes("f0", 0, signs), 3);
+    EXPECT_EQ (signs, vector<SchemaSignature>({1, wide + 2, wide + 3}));
+    EXPECT_EQ (t->findNode("f0", 0, DataType::s_type_double, vc), wide + 3);
+    EXPECT_EQ (t->findNode("f0", 1, dt, vc), wide + 1);
+
+    // snapshot rebuilds the index 
+    SchemaTree *s = t->snapshot();
+    ASSERT_NE (s, nullptr);
+    signs.clear();
+    EXPECT_EQ (s->findNodes("f0", 0, signs), 3);
+    EXPECT_EQ (signs, vector<SchemaSignature>({1, wide + 2, wide + 3}));
+    EXPECT_EQ (s->findNode("f299", 0, dt, vc), wide);
+
+    delete s;
+    delete t;
+} // testSchemaIndex
+
+
+
+#include <thread>
+#include "SchemaTreeMap.h"
+TEST(steedSchemaTest, testSchemaTreeMap)
+{
+    using namespace steed;
+    std::string db("debug"), tb("map"); 
+    const char* keystr= "\"key\""; 
+    int    dt = DataType::s_type_int_64;
+    uint8_t vc = SchemaNode::s_vcat_single;
+
+    // the first writer creates an empty tree, the second one is refused
+    SchemaTreeRef wt, wt2, rd;
+    EXPECT_EQ (SchemaTreeMap::getWritableTree(db, tb, wt ), 0);
+    EXPECT_LT (SchemaTreeMap::getWritableTree(db, tb, wt2), 0);
+    EXPECT_EQ (wt2, nullptr);
+    EXPECT_EQ (wt->addNode(keystr, 0, dt, vc), 0);
+
+    // readers get snapshots while the tree is written
+    EXPECT_EQ (SchemaTreeMap::getSnapshot(db, tb, rd), 1);
+    EXPECT_NE (rd.get(), wt.get());
+    EXPECT_EQ (rd->getNodeNum(), 2);
+
+    std::thread reader([&db, &tb]() {
+        for (int i = 0; i < 100; ++i)
+        {
+            SchemaTreeRef snap;
+            EXPECT_EQ (SchemaTreeMap::getSnapshot(db, tb, snap), 1);
+            EXPECT_GE (snap->getNodeNum(), 2);
+        } // for i
+    });
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        std::lock_guard<std::mutex> lk(wt->getMutex());
+        EXPECT_EQ (wt->addNode(keystr, 1, dt, vc), 0);
+    } // for i
+    reader.join();
+    EXPECT_EQ (rd->getNodeNum(), 2); // not changed by the writer 
+    SchemaTreeMap::releaseWritableTree(wt);
+    EXPECT_EQ (wt, nullptr);
+
+    // without writer readers share the tree in map 
+    SchemaTreeRef r1, r2;
+    EXPECT_EQ (SchemaTreeMap::getSnapshot(db, tb, r1), 1);
+    EXPECT_EQ (SchemaTreeMap::getSnapshot(db, tb, r2), 1);
+    EXPECT_EQ (r1.get(), r2.get());
+    EXPECT_EQ (r1->getNodeNum(), 10);
+
+    // a new writer copies the tree shared by readers
+    EXPECT_EQ (SchemaTreeMap::getWritableTree(db, tb, wt), 1);
+    EXPECT_NE (wt.get(), r1.get());
+    EXPECT_EQ (wt->getNodeNum(), 10);
+    EXPECT_EQ (SchemaTreeMap::lookup(db, tb), wt.get());
+    SchemaTreeMap::releaseWritableTree(wt);
+
+    SchemaTreeMap::destory();
+    EXPECT_EQ (SchemaTreeMap::lookup(db, tb), nullptr);
+    EXPECT_EQ (r1->getNodeNum(), 10); // still held 
+} // testSchemaTreeMap
@@ -204,6 +204,39 @@ TEST(steedStoreTest, testCAB)
         EXPECT_EQ(info_buf->getNextIndex(), info_buf->getUsedNumber());
         EXPECT_EQ(info->m_item_info.m_recd_num, 1); // empty
 
+        info = info_buf->getNextInfo2Write(); // empty tail
+        info->m_file_off = 4096 * info_num;
+        ++info_num;
+
+        delete info_buf; info_buf = nullptr;
+    }
+
+    {
+        // check the empty tail is replaced
+        info_buf = new CABInfoBuffer();
+        info_buf->init2append(path.c_str());
+        info = info_buf->getTailInfo2Append();
+        EXPECT_EQ(info->m_file_off, 4096 * (info_num - 1));
+        EXPECT_EQ(info_buf->getCABInfo(0), nullptr); // tail only
+        EXPECT_EQ(info_buf->popEmptyTail(), 1);
+        EXPECT_EQ(info_buf->getUsedNumber(), info_num - 1);
+
+        info = info_buf->getNextInfo2Write();
+        info->m_item_info.m_recd_num = 2;
+        info->m_file_off = 4096 * (info_num - 1);
+
+        delete info_buf; info_buf = nullptr;
+    }
+
+    {
+        // check the written back infos
+        info_buf = new CABInfoBuffer();
+        info_buf->init2read(path.c_str());
+        EXPECT_EQ(info_buf->getUsedNumber(), info_num);
+        for (uint64_t i = 0; i < info_num; ++i)
+        {   EXPECT_EQ(info_buf->getCABInfo(i)->m_file_off, 4096 * i);   }
+        EXPECT_EQ(info_buf->getTailInfo()->m_item_info.m_recd_num, 2);
+
         delete info_buf; info_buf = nullptr;
     }
 
@@ -235,3 +268,50 @@ TEST(steedStoreTest, testColumnReader)
     EXPECT_EQ(reader.getSchemaTree(), nullptr);
 } // testColumnReader
 
+
+#include "CABCache.h"
+TEST(steedStoreTest, testCABCache)
+{
+    using namespace steed;
+    uint64_t budget = g_config.m_cab_cache_size;
+    g_config.m_cab_cache_size = 256;
+
+    CABCache cache;
+    EXPECT_TRUE(cache.enabled());
+    EXPECT_EQ (cache.lookup("a#0"), nullptr);
+
+    // pinned entries are never evicted 
+    char cont[128];
+    memset(cont, 'a', sizeof(cont));
+    CABCache::Entry *a = cache.insert("a#0", cont, sizeof(cont));
+    CABCache::Entry *b = cache.insert("a#1", cont, sizeof(cont));
+    CABCache::Entry *c = cache.insert("b#0", cont, sizeof(cont));
+    ASSERT_NE (a, nullptr);
+    ASSERT_NE (c, nullptr);
+    EXPECT_EQ (c->m_cont[127], 'a');
+    EXPECT_EQ (cache.getUsed(), 384);
+    EXPECT_EQ (cache.insert("b#1", cont, 512), nullptr); // over budget
+
+    // release the LRU one to evict it 
+    cache.release(a);
+    EXPECT_EQ (cache.getUsed(), 256);
+    EXPECT_EQ (cache.getEvictNum(), 1);
+    EXPECT_EQ (cache.lookup("a#0"), nullptr);
+
+    CABCache::Entry *got = cache.lookup("a#1");
+    EXPECT_EQ (got, b);
+    EXPECT_EQ (cache.getHitNum (), 1);
+    EXPECT_EQ (cache.getMissNum(), 2);
+    cache.release(got);
+    cache.release(b);
+
+    // erase by file and keep the pinned one alive until released 
+    cache.erase("b");
+    EXPECT_EQ (cache.getUsed(), 128);
+    EXPECT_EQ (c->m_drop, true);
+    cache.release(c);
+
+    cache.clear();
+    EXPECT_EQ (cache.getUsed(), 0);
+    g_config.m_cab_cache_size = budget;
+} // testCABCache
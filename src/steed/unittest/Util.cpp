@@ -133,9 +133,102 @@ TEST(steedUtilTest, testBuffer) {
 
         EXPECT_EQ (buf.getPosition(fsize), nullptr);
     }
+
+    // test Buffer growth policy
+    {
+        steed::Buffer buf(4096);
+        uint64_t thd = steed::Buffer::s_grow_linear_threshold;
+        uint64_t stp = steed::Buffer::s_grow_linear_step;
+        EXPECT_EQ (buf.calcGrowCapacity(4097), 8192);
+        EXPECT_EQ (buf.calcGrowCapacity(5 * 4096), 8 * 4096);
+        EXPECT_EQ (buf.calcGrowCapacity(thd + 1), thd + stp);
+        EXPECT_EQ (buf.calcGrowCapacity(UINT64_MAX), 0);
+        EXPECT_EQ (buf.allocate(UINT64_MAX, true), nullptr);
+        EXPECT_EQ (buf.used(), 0);
+    }
+
+    // test Buffer with O_DIRECT: aligned body and unaligned tail 
+    {
+        uint64_t len = 4096 + 100;
+        {
+            steed::Buffer buf(len);
+            EXPECT_EQ (buf.init2write(fn, true), 0);
+            void *got = buf.allocate(len, false);
+            EXPECT_EQ ((uintptr_t)got % buf.getAlignSize(), 0);
+            memset(got, 'd', len);
+            EXPECT_EQ (buf.flush2File(), len);
+        }
+        EXPECT_EQ (steed::Utility::getFileSize(fn), len);
+
+        steed::Buffer buf(len);
+        EXPECT_EQ (buf.init2read(fn, true), 0);
+        EXPECT_EQ (buf.load2Buffer(len, false), len);
+        char *got = (char *)buf.data();
+        EXPECT_EQ (got[0], 'd');
+        EXPECT_EQ (got[len - 1], 'd');
+    }
+
+    // test Buffer viewing the file mapping: detach before modified
+    {
+        uint64_t len = 4096 + 100;
+        steed::Buffer buf(16);
+        EXPECT_EQ (buf.init2read(fn), 0);
+        EXPECT_EQ (buf.mapFile(MADV_SEQUENTIAL), 1);
+        EXPECT_EQ (buf.view2Buffer(len), len);
+        EXPECT_TRUE (buf.isView());
+        EXPECT_EQ (((char *)buf.data())[len - 1], 'd');
+
+        EXPECT_EQ (buf.append("e", 1), 0);
+        EXPECT_FALSE(buf.isView());
+        EXPECT_EQ (buf.used(), len + 1);
+        EXPECT_EQ (((char *)buf.data())[len - 1], 'd');
+        EXPECT_EQ (((char *)buf.data())[len], 'e');
+
+        // out of the mapping: read by IO
+        buf.clear();
+        EXPECT_EQ (buf.view2Buffer(len), 0);
+        EXPECT_FALSE(buf.isView());
+    }
 } // testBuffer
 
 
+#include "BackgroundWriter.h"
+TEST(steedUtilTest, testBackgroundWriter) {
+    const char *fname = "/tmp/steed/test.txt";
+    steed::FileIOViaOS fileIO;
+    EXPECT_EQ (fileIO.init2write(fname), 0);
+
+    // 3 blocks written by 2 pending buffers
+    uint64_t blk = 4096;
+    {
+        steed::BackgroundWriter bw;
+        EXPECT_EQ (bw.init(&fileIO, 2), 0);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            steed::Buffer *buf = bw.acquire();
+            ASSERT_NE (buf, nullptr);
+            void *got = buf->allocate(blk, true);
+            memset(got, 'a' + i, blk);
+            EXPECT_EQ (bw.submit(buf, i * blk), 0);
+        } // for
+        EXPECT_EQ (bw.sync (), 0);
+        EXPECT_EQ (bw.close(), 0);
+    }
+    fileIO.uninit();
+    EXPECT_EQ (steed::Utility::getFileSize(fname), 3 * blk);
+
+    char fbuff[16] = {0};
+    EXPECT_EQ (fileIO.init2read(fname), 0);
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        fileIO.seekContent(i * blk + blk - 1, SEEK_SET);
+        EXPECT_EQ (fileIO.readContent(1, fbuff), 1);
+        EXPECT_EQ (fbuff[0], 'a' + i);
+    } // for
+    fileIO.uninit();
+} // testBackgroundWriter
+
+
 #include "Utility.h"
 TEST(steedUtilTest, testUtilityBits) {
     uint64_t word_len = sizeof(uint16_t) * 8;
@@ -289,6 +382,64 @@ TEST(steedUtilTest, testBitVector) {
 } // testBitVector
 
 
+TEST(steedUtilTest, testBitVectorBulk) {
+    const uint32_t buflen = 1000, num = 1500, guard = 16;
+    char one[buflen] = {0}, bulk[buflen + guard] = {0};
+    memset(bulk + buflen, 0x5a, guard);
+
+    for (uint32_t l = 1; l <= 16; ++l) {
+        uint32_t cap = buflen * 8 / l;
+        uint32_t cnt = (num < cap) ? num : cap;
+        std::vector<uint8_t>  vals8 (cnt);
+        std::vector<uint16_t> vals16(cnt), got16(cnt);
+
+        // reference content appended one by one
+        steed::BitVector bv(l);
+        EXPECT_EQ (bv.init2write(buflen, one), 0);
+        for (uint32_t i = 0; i < cnt; ++i)
+        {
+            vals16[i] = uint16_t((i * 7 + i / 5) & bv.getMask());
+            vals8 [i] = uint8_t (vals16[i]);
+            EXPECT_EQ (bv.append(vals16[i]), 0);
+        } // for i
+
+        // unpack from aligned and unaligned begin
+        for (uint32_t bgn : {0u, 3u, 13u})
+        {
+            std::fill(got16.begin(), got16.end(), 0);
+            EXPECT_EQ (bv.unpack(bgn, cnt - bgn, got16.data()), int64_t(cnt - bgn));
+            EXPECT_TRUE (std::equal(got16.begin(), got16.end() - bgn, vals16.begin() + bgn));
+        } // for bgn
+        EXPECT_EQ (bv.unpack(1, cnt, got16.data()), -1);
+
+        if (l > 8) {
+            uint8_t got8 = 0;
+            EXPECT_EQ (bv.unpack(0, 1, &got8), -1);
+            continue;
+        } // if
+
+        std::vector<uint8_t> got8(cnt);
+        EXPECT_EQ (bv.unpack(5, cnt - 5, got8.data()), int64_t(cnt - 5));
+        EXPECT_TRUE (std::equal(got8.begin(), got8.end() - 5, vals8.begin() + 5));
+
+        // pack after unaligned appends, then repeated values
+        steed::BitVector pv(l);
+        EXPECT_EQ (pv.init2write(buflen, bulk), 0);
+        uint32_t head = 3, rept = 20, mid = cnt - head - rept;
+        for (uint32_t i = 0; i < head; ++i)
+        {   EXPECT_EQ (pv.append(vals8[i]), 0);   }
+        EXPECT_EQ (pv.pack(vals8.data() + head, mid), 0);
+        EXPECT_EQ (pv.append(vals8[head + mid], rept), 0);
+        EXPECT_EQ (pv.getElementUsed(), cnt);
+
+        for (uint32_t i = head + mid; i < cnt; ++i)
+        {   EXPECT_EQ (pv.get(i), vals8[head + mid]);   }
+        EXPECT_EQ (memcmp(one, bulk, l * (head + mid) / 8), 0);
+        EXPECT_EQ (bulk[buflen], 0x5a);
+    } // for l
+} // testBitVectorBulk
+
+
 #include "RandomValues.h"
 #include "BoolVector.h"
 TEST(steedUtilTest, testBoolVector) {
@@ -404,6 +555,105 @@ TEST(steedUtilTest, testAllocator) {
     ptr1 = nullptr, ptr2 = nullptr;
 } // testAllocator
 
+TEST(steedUtilTest, testAllocatorPool) {
+    using namespace steed;
+    EXPECT_EQ (steedPoolSize(1), s_pool_min);
+    EXPECT_EQ (steedPoolSize(4097), 8192);
+    EXPECT_EQ (steedPoolSize(s_pool_max), s_pool_max);
+    EXPECT_EQ (steedPoolSize(s_pool_max + 1), s_pool_max + s_pool_align);
+
+    AllocStats bs, as;
+    steedAllocStats(bs);
+
+    // freed block is reused by the same class, zeroed on demand
+    char *p1 = (char*)steedPoolAlloc(5000, false);
+    ASSERT_TRUE(p1 != nullptr);
+    EXPECT_EQ (uintptr_t(p1) % s_pool_align, 0);
+    memset(p1, 0xFF, 8192);
+    steedPoolFree(p1, 5000);
+
+    char *p2 = (char*)steedPoolAlloc(8192, true);
+    EXPECT_EQ (p2, p1);
+    EXPECT_EQ (p2[0], 0);
+    EXPECT_EQ (p2[8191], 0);
+
+    // direct blocks are resized by realloc
+    char *p3 = (char*)steedPoolAlloc(s_pool_max + 1, false);
+    p3[0] = 'x';
+    p3 = (char*)steedPoolRealloc(p3, s_pool_max + 1, s_pool_max * 2);
+    EXPECT_EQ (p3[0], 'x');
+    EXPECT_EQ (uintptr_t(p3) % s_pool_align, 0);
+
+    steedAllocStats(as);
+    EXPECT_EQ (as.m_alloc_num - bs.m_alloc_num, 3);
+    EXPECT_EQ (as.m_free_num  - bs.m_free_num , 1);
+    EXPECT_GE (as.m_pool_hit  - bs.m_pool_hit , 1);
+    EXPECT_EQ (as.m_inuse - bs.m_inuse, 8192 + s_pool_max * 2);
+
+    steedPoolFree(p2, 8192);
+    steedPoolFree(p3, s_pool_max * 2);
+    steedPoolTrim();
+    steedAllocStats(as);
+    EXPECT_EQ (as.m_inuse , bs.m_inuse);
+    EXPECT_EQ (as.m_cached, 0);
+
+    // non-zeroing Buffer keeps its content when it grows
+    Buffer *buf = new Buffer(100, false);
+    EXPECT_EQ (buf->capacity(), steedPoolSize(100));
+    buf->append("steed", 5);
+    buf->reserve(buf->capacity() * 3);
+    EXPECT_EQ (buf->capacity(), steedPoolSize(steedPoolSize(100) * 3));
+    EXPECT_EQ (memcmp(buf->data(), "steed", 5), 0);
+    delete buf; buf = nullptr;
+} // testAllocatorPool
+
+
+#include "MemTracker.h"
+TEST(steedUtilTest, testMemTracker) {
+    using namespace steed;
+    MemTracker root ("root" , 1 << 20, nullptr);
+    MemTracker query("query", 1 << 16, &root);
+
+    // charges go to the ancestors, refused ones are rolled back
+    EXPECT_TRUE (query.consume(1 << 15));
+    EXPECT_EQ   (root.getUsed(), 1 << 15);
+    EXPECT_FALSE(query.consume(1 << 16));
+    EXPECT_EQ   (query.getUsed(), 1 << 15);
+    EXPECT_EQ   (root .getUsed(), 1 << 15);
+    EXPECT_EQ   (query.getRefused(), 1);
+    EXPECT_EQ   (query.available(), 1 << 15);
+    EXPECT_FALSE(query.pressured());
+
+    EXPECT_TRUE (query.consume(1 << 16, true)); // forced
+    EXPECT_TRUE (query.pressured());
+    query.release(1 << 16);
+    EXPECT_EQ   (query.getPeak(), (1 << 15) + (1 << 16));
+
+    // Buffers are charged to the current tracker of the thread
+    {
+        MemTrackerScope scope(&query);
+        EXPECT_EQ (MemTracker::current(), &query);
+
+        Buffer *buf = new Buffer(4096);
+        EXPECT_EQ (buf->getMemTracker(), &query);
+        EXPECT_EQ (query.getUsed(), (1 << 15) + buf->capacity());
+
+        // growing over the budget is refused
+        buf->setBudget(true);
+        EXPECT_LT (buf->reserve(1 << 16), 0);
+        EXPECT_EQ (buf->capacity(), 4096);
+        EXPECT_EQ (buf->reserve(8192), 0);
+        EXPECT_EQ (query.getUsed(), (1 << 15) + 8192);
+
+        delete buf; buf = nullptr;
+    }
+    EXPECT_EQ (MemTracker::current(), &MemTracker::process());
+    EXPECT_EQ (query.getUsed(), 1 << 15);
+
+    query.release(1 << 15);
+    EXPECT_EQ (root.getUsed(), 0);
+} // testMemTracker
+
 
 #include "SymbolMap.h"
 TEST(steedUtilTest, testSymbolMap) {
@@ -436,3 +686,265 @@ TEST(steedUtilTest, testSymbolMap) {
 //    sm.show();
 } // testSymbolMap
 
+
+
+#include <sstream>
+#include "JSONGenerator.h"
+TEST(steedUtilTest, testJSONGenerator) {
+    steed::JSONGenOption opt = steed::JSONGenOption::eventLog(7);
+    opt.m_drift_every = 16;
+
+    // the same seed generates the same records
+    std::stringstream s1, s2, s3;
+    steed::JSONGenerator g1(opt), g2(opt);
+    EXPECT_GT (g1.output(&s1, 64), 0);
+    EXPECT_GT (g2.output(&s2, 64), 0);
+    EXPECT_EQ (s1.str(), s2.str());
+    EXPECT_EQ (g1.getRecdNum(), 64);
+    EXPECT_EQ (g1.getDriftNum(), 3);
+
+    opt.m_seed = 8;
+    steed::JSONGenerator g3(opt);
+    g3.output(&s3, 64);
+    EXPECT_NE (s1.str(), s3.str());
+
+    // one object per line, nested no deeper than the max depth
+    std::string line;
+    uint32_t lnum = 0;
+    while (std::getline(s1, line)) {
+        ++lnum;
+        EXPECT_EQ (line.front(), '{');
+        EXPECT_EQ (line.back(), '}');
+
+        int level = 0, deepest = 0;
+        bool instr = false;
+        for (auto c : line) {
+            if (c == '"') { instr = !instr; }
+            if (instr) { continue; }
+            if ((c == '{') || (c == '[')) { deepest = std::max(deepest, ++level); }
+            if ((c == '}') || (c == ']')) { --level; }
+        } // for
+        EXPECT_EQ (level, 0);
+        EXPECT_LE (deepest, int(opt.m_max_depth));
+    } // while
+    EXPECT_EQ (lnum, 64);
+
+    // dense and flat without nulls
+    steed::JSONGenOption flat;
+    flat.m_max_depth = 1;
+    flat.m_sparsity  = 0;
+    flat.m_null_rate = 0;
+    flat.m_field_min = flat.m_field_max = 5;
+    steed::JSONGenerator g4(flat);
+    std::string recd;
+    g4.generate(recd);
+    EXPECT_EQ (std::count(recd.begin(), recd.end(), ':'), 5);
+    EXPECT_EQ (recd.find("null"), std::string::npos);
+    EXPECT_EQ (recd.find('['), std::string::npos);
+} // testJSONGenerator
+
+
+#include <thread>
+#include "Metrics.h"
+TEST(steedUtilTest, testMetrics) {
+    using steed::Metrics;
+    steed::MetricsSnapshot snap;
+
+    // disabled: nothing collected
+    Metrics::enable(false);
+    Metrics::reset();
+    Metrics::add(Metrics::recd_parsed, 10);
+    { steed::MetricsTimer t(Metrics::t_parse); }
+    Metrics::snapshot(snap);
+    EXPECT_EQ (snap.get(Metrics::recd_parsed), 0);
+    EXPECT_EQ (snap.m_tm_num[Metrics::t_parse], 0);
+
+    // enabled: counters of exited threads are kept
+    Metrics::enable(true);
+    Metrics::add(Metrics::recd_parsed, 10);
+    std::thread th([] { Metrics::add(Metrics::recd_parsed, 5); Metrics::add(Metrics::cab_read); });
+    th.join();
+    Metrics::record(Metrics::t_io_read, 1000);   // bucket [512, 1024)
+    Metrics::record(Metrics::t_io_read, 3000);   // bucket [2048, 4096)
+    Metrics::snapshot(snap);
+    EXPECT_EQ (snap.get(Metrics::recd_parsed), 15);
+    EXPECT_EQ (snap.get(Metrics::cab_read), 1);
+    EXPECT_EQ (snap.m_tm_num[Metrics::t_io_read], 2);
+    EXPECT_EQ (snap.m_tm_ns [Metrics::t_io_read], 4000);
+    EXPECT_EQ (snap.percentile(Metrics::t_io_read, 0.5), 1023);
+    EXPECT_EQ (snap.percentile(Metrics::t_io_read, 1.0), 4095);
+
+    std::string str;
+    Metrics::output2JSON(str);
+    EXPECT_NE (str.find("\"recd_parsed\": 15"), std::string::npos);
+
+    // write behind: CABs are counted by the background thread once written
+    Metrics::reset();
+    {
+        steed::FileIOViaOS fileIO;
+        EXPECT_EQ (fileIO.init2write("/tmp/steed_ut_metrics.bin"), 0);
+        steed::BackgroundWriter bw;
+        EXPECT_EQ (bw.init(&fileIO, 2), 0);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            steed::Buffer *buf = bw.acquire();
+            ASSERT_NE (buf, nullptr);
+            memset(buf->allocate(512, true), 'a', 512);
+            EXPECT_EQ (bw.submit(buf, i * 512), 0);
+        } // for
+        EXPECT_EQ (bw.close(), 0);
+        fileIO.uninit();
+    }
+    Metrics::snapshot(snap);
+    EXPECT_EQ (snap.get(Metrics::cab_written), 3);
+    EXPECT_EQ (snap.get(Metrics::bytes_written), 3 * 512);
+
+    Metrics::reset();
+    Metrics::snapshot(snap);
+    EXPECT_EQ (snap.get(Metrics::recd_parsed), 0);
+    Metrics::enable(false);
+} // testMetrics
+
+
+
+#include <vector>
+#include "Logger.h"
+static std::vector<std::string> s_log_msgs;
+static void logCallback(int, const char *msg) { s_log_msgs.emplace_back(msg); }
+TEST(steedUtilTest, testLogger) {
+    using steed::Logger;
+    EXPECT_EQ (Logger::getLevel("warn"), Logger::warn);
+    EXPECT_LT (Logger::getLevel("verbose"), 0);
+
+    s_log_msgs.clear();
+    Logger::setCallback(logCallback);
+    Logger::setRate(0);
+    Logger::setLevel(Logger::warn);
+
+    // disabled level: arguments are not evaluated
+    int eval = 0;
+    STEED_LOG(info, "info %d", ++eval);
+    STEED_LOG(warn, "warn %d\n", ++eval);
+    EXPECT_EQ (eval, 1);
+    ASSERT_EQ (s_log_msgs.size(), 1);
+    EXPECT_EQ (s_log_msgs[0], "warn 1");
+
+    // rate limit in one second
+    s_log_msgs.clear();
+    Logger::setRate(3);
+    for (int i = 0; i < 10; ++i) { STEED_LOG(error, "error %d", i); }
+    EXPECT_LE (s_log_msgs.size(), 7); // may cross a second
+    EXPECT_GE (s_log_msgs.size(), 3);
+
+    Logger::setRate(0);
+    Logger::setCallback(nullptr);
+    Logger::setLevel(Logger::info);
+} // testLogger
+
+
+
+#include <fstream>
+#include <sstream>
+#include "Tracer.h"
+TEST(steedUtilTest, testTracer) {
+    using steed::Tracer;
+    EXPECT_FALSE(Tracer::enabled());
+    { steed::TraceScope t(Tracer::parse); }   // not traced
+    EXPECT_EQ (Tracer::stop(), 0);
+    EXPECT_LT (Tracer::start("/tmp/steed_ut.trace", "xml"), 0);
+
+    // json: events of exited threads are kept
+    std::string jfn("/tmp/steed_ut.trace.json");
+    ASSERT_EQ (Tracer::start(jfn, "json"), 0);
+    { steed::TraceScope t(Tracer::batch_read); }
+    std::thread th([] { steed::TraceScope t(Tracer::cab_flush); });
+    th.join();
+    Tracer::add(Tracer::parse, Tracer::now(), 1000);
+    EXPECT_EQ (Tracer::stop(), 3);
+    EXPECT_FALSE(Tracer::enabled());
+
+    std::ifstream jfs(jfn);
+    std::stringstream jss;
+    jss << jfs.rdbuf();
+    std::string jstr = jss.str();
+    EXPECT_NE (jstr.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE (jstr.find("\"name\": \"cab_flush\""), std::string::npos);
+    EXPECT_NE (jstr.find("\"dur\": 1.000"), std::string::npos);
+
+    // binary: magic, version, names and fixed size records
+    std::string bfn("/tmp/steed_ut.trace.bin");
+    ASSERT_EQ (Tracer::start(bfn, "binary"), 0);
+    Tracer::add(Tracer::decompress, Tracer::now(), 10);
+    EXPECT_EQ (Tracer::stop(), 1);
+
+    std::ifstream bfs(bfn, std::ios::binary);
+    std::string bstr((std::istreambuf_iterator<char>(bfs)), std::istreambuf_iterator<char>());
+    EXPECT_EQ (bstr.substr(0, 8), "STEEDTRC");
+    EXPECT_NE (bstr.find("assemble_batch"), std::string::npos);
+    uint64_t dur = 0;
+    memcpy(&dur, bstr.data() + bstr.size() - 24 + 8, sizeof(dur));
+    EXPECT_EQ (dur, 10);
+
+    steed::Utility::removeFile(jfn);
+    steed::Utility::removeFile(bfn);
+} // testTracer
+
+
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "OutputSink.h"
+static int appendBatch(const char *data, uint64_t len, void *arg)
+{
+    std::string *str = (std::string*)arg;
+    str->append(data, len);
+    return (str->size() > 100000) ? -1 : 0;
+} // appendBatch
+
+TEST(steedUtilTest, testOutputSink) {
+    std::string exp;
+    for (int i = 0; i < 3000; ++i) { exp += "{\"i\":" + std::to_string(i) + "}\n"; }
+
+    // memory: grows and releases the '\0' ended content
+    uint64_t len = 0;
+    steed::MemorySink ms(16);
+    ms.write(exp);
+    char *txt = ms.release(len);
+    EXPECT_EQ (len, exp.size());
+    EXPECT_STREQ (txt, exp.c_str());
+    delete [] txt;
+
+    // reserve over the batch size gets nothing
+    std::string got;
+    steed::CallbackSink cs(appendBatch, &got, 64);
+    EXPECT_EQ (cs.reserve(65), nullptr);
+    char *pos = cs.reserve(8);
+    ASSERT_NE (pos, nullptr);
+    memcpy(pos, "reserved", 8);
+    cs.commit(8);
+    for (char c : exp) { cs.put(c); }
+    EXPECT_EQ (cs.flush(), 0);
+    EXPECT_EQ (got, "reserved" + exp);
+    EXPECT_EQ (cs.getTotal(), exp.size() + 8);
+
+    // callback stops the output
+    for (int i = 0; i < 10; ++i) { cs.write(exp); }
+    EXPECT_LT (cs.flush(), 0);
+    EXPECT_FALSE(cs.good());
+
+    // fd: full batches are written by writev
+    std::string fn("/tmp/steed_ut.sink");
+    int fd = ::open(fn.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE (fd, 0);
+    {
+        steed::FDSink fs(fd, 4096, 2);
+        for (int i = 0; i < 5; ++i) { fs.write(exp); }
+        EXPECT_EQ (fs.getTotal(), exp.size() * 5);
+    }
+    ::close(fd);
+
+    std::ifstream ifs(fn);
+    std::string fstr((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_EQ (fstr, exp + exp + exp + exp + exp);
+    steed::Utility::removeFile(fn);
+} // testOutputSink
@@ -27,9 +27,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <malloc.h>
+#include <mutex>
+#include <atomic>
+#include <vector>
 
 #include "Allocator.h"
 #include "DebugInfo.h"
+#include "Logger.h"
 
 namespace steed {
 
@@ -38,7 +42,7 @@ void* steedMemalign(size_t align, size_t size)
     void* x = memalign(align, size);
     if (x == nullptr)
     {
-        puts ("steedMemalign: failed!");
+        STEED_LOG(error, "steedMemalign: failed!");
         DebugInfo::printStackAndExit();
     }
 
@@ -46,16 +50,16 @@ void* steedMemalign(size_t align, size_t size)
 } // steedMemalign
 
 
-void* steedMalloc(size_t size)
+void* steedMalloc(size_t size, bool zero)
 {
     void* x = malloc(size);
     if (x == nullptr)
     {
-        puts ("steedMalloc: failed!");
+        STEED_LOG(error, "steedMalloc: failed!");
         DebugInfo::printStackAndExit();
     }
 
-    memset(x, 0x00, size);
+    if (zero) { memset(x, 0x00, size); }
     return x;
 } // steedMalloc
 
@@ -65,7 +69,7 @@ void* steedRealloc(void* ptr, size_t size)
     void* x = realloc(ptr, size);
     if (x == nullptr)    
     {
-        printf("steedRealloc: failed!");
+        STEED_LOG(error, "steedRealloc: failed!");
         DebugInfo::printStackAndExit();
     }
 
@@ -78,4 +82,289 @@ void steedFree(void* ptr)
     free(ptr);
 } // steedFree
 
+
+
+
+namespace {
+
+const uint32_t s_class_min_bit = 12; // log2(s_pool_min)
+const uint32_t s_class_num     = 15; // 4KB .. 64MB
+
+/** per-thread cache bound of each class */
+const size_t   s_thread_class_cap = 16UL << 20;
+
+
+/** global statistics and caches */
+class PoolStats {
+public:
+    std::atomic<uint64_t> m_alloc_num{0};
+    std::atomic<uint64_t> m_free_num {0};
+    std::atomic<uint64_t> m_pool_hit {0};
+    std::atomic<uint64_t> m_pool_miss{0};
+    std::atomic<uint64_t> m_inuse    {0};
+    std::atomic<uint64_t> m_peak     {0};
+    std::atomic<uint64_t> m_cached   {0};
+    std::atomic<uint64_t> m_zeroed   {0};
+    std::atomic<uint64_t> m_cache_cap{256UL << 20};
+
+public:
+    void updatePeak(uint64_t inuse)
+    {
+        uint64_t pk = m_peak.load(std::memory_order_relaxed);
+        while ((inuse > pk) &&
+            !m_peak.compare_exchange_weak(pk, inuse, std::memory_order_relaxed)) {}
+    } // updatePeak
+}; // PoolStats
+
+
+class GlobalPool {
+public:
+    std::mutex           m_mutex{};
+    std::vector<void*>   m_free [s_class_num]; /**< cached blocks per class */
+    uint64_t             m_bytes{0};           /**< cached bytes            */
+    PoolStats            m_stats{};
+
+public:
+    static GlobalPool &get(void)
+    {
+        static GlobalPool *pool = new GlobalPool(); // never destroyed
+        return *pool;
+    } // get
+
+    /** @return true if kept in the global cache */
+    bool put(uint32_t ci, void *ptr)
+    {
+        size_t bs = size_t(1) << (ci + s_class_min_bit);
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_bytes + bs > m_stats.m_cache_cap.load(std::memory_order_relaxed))
+        {   return false;   }
+        m_free[ci].emplace_back(ptr);
+        m_bytes += bs;
+        return true;
+    } // put
+
+    void *take(uint32_t ci)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_free[ci].empty()) { return nullptr; }
+        void *ptr = m_free[ci].back();
+        m_free[ci].pop_back();
+        m_bytes -= size_t(1) << (ci + s_class_min_bit);
+        return ptr;
+    } // take
+
+    void trim(void)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (uint32_t ci = 0; ci < s_class_num; ++ci)
+        {
+            for (auto p : m_free[ci]) { free(p); }
+            m_free[ci].clear();
+        } // for ci
+        m_stats.m_cached.fetch_sub(m_bytes, std::memory_order_relaxed);
+        m_bytes = 0;
+    } // trim
+}; // GlobalPool
+
+
+/** set when the thread cache is destroyed, blocks freed later bypass it */
+thread_local bool t_cache_dead = false;
+
+/** thread cache: blocks move to the global cache at thread exit */
+class ThreadCache {
+public:
+    std::vector<void*>   m_free[s_class_num]; /**< cached blocks per class */
+
+public:
+    ~ThreadCache(void) { flush(); t_cache_dead = true; }
+
+    void flush(void)
+    {
+        GlobalPool &gp = GlobalPool::get();
+        for (uint32_t ci = 0; ci < s_class_num; ++ci)
+        {
+            size_t bs = size_t(1) << (ci + s_class_min_bit);
+            for (auto p : m_free[ci])
+            {
+                if (gp.put(ci, p)) { continue; }
+                free(p);
+                gp.m_stats.m_cached.fetch_sub(bs, std::memory_order_relaxed);
+            } // for p
+            m_free[ci].clear();
+        } // for ci
+    } // flush
+}; // ThreadCache
+
+
+ThreadCache *localCache(void)
+{
+    if (t_cache_dead) { return nullptr; }
+    static thread_local ThreadCache cache;
+    return &cache;
+} // localCache
+
+
+/** @return class index of the size; s_class_num for direct blocks */
+uint32_t getClass(size_t size)
+{
+    if (size > s_pool_max) { return s_class_num; }
+    if (size <= s_pool_min) { return 0; }
+    uint32_t bit = 64 - __builtin_clzll(uint64_t(size - 1));
+    return bit - s_class_min_bit;
+} // getClass
+
+} // namespace
+
+
+
+void AllocStats::output(FILE *fp)
+{
+    fprintf(fp, "Allocator: alloc %lu free %lu hit %lu miss %lu\n",
+        m_alloc_num, m_free_num, m_pool_hit, m_pool_miss);
+    fprintf(fp, "Allocator: inuse %lu peak %lu cached %lu zeroed %lu bytes\n",
+        m_inuse, m_peak, m_cached, m_zeroed);
+} // output
+
+
+
+size_t steedPoolSize(size_t size)
+{
+    uint32_t ci = getClass(size);
+    return (ci < s_class_num) ? (size_t(1) << (ci + s_class_min_bit)) :
+        (size + s_pool_align - 1) / s_pool_align * s_pool_align;
+} // steedPoolSize
+
+
+
+void* steedPoolAlloc(size_t size, bool zero)
+{
+    size_t     bs = steedPoolSize(size);
+    uint32_t   ci = getClass(size);
+    GlobalPool &gp = GlobalPool::get();
+    PoolStats  &st = gp.m_stats;
+
+    void *ptr = nullptr;
+    if (ci < s_class_num)
+    {
+        ThreadCache *tc = localCache();
+        if ((tc != nullptr) && !tc->m_free[ci].empty())
+        {   ptr = tc->m_free[ci].back(); tc->m_free[ci].pop_back();   }
+        else
+        {   ptr = gp.take(ci);   }
+    } // if
+
+    if (ptr != nullptr)
+    {
+        st.m_pool_hit.fetch_add(1, std::memory_order_relaxed);
+        st.m_cached  .fetch_sub(bs, std::memory_order_relaxed);
+    }
+    else
+    {
+        ptr = steedMemalign(s_pool_align, bs);
+        st.m_pool_miss.fetch_add(1, std::memory_order_relaxed);
+    } // if
+
+    if (zero)
+    {
+        memset(ptr, 0x00, bs);
+        st.m_zeroed.fetch_add(bs, std::memory_order_relaxed);
+    } // if
+
+    st.m_alloc_num.fetch_add(1, std::memory_order_relaxed);
+    st.updatePeak(st.m_inuse.fetch_add(bs, std::memory_order_relaxed) + bs);
+    return ptr;
+} // steedPoolAlloc
+
+
+
+void* steedPoolRealloc(void *ptr, size_t old, size_t size)
+{
+    size_t ob = steedPoolSize(old), nb = steedPoolSize(size);
+    if ((getClass(old) == s_class_num) && (getClass(size) == s_class_num))
+    {
+        PoolStats &st = GlobalPool::get().m_stats;
+        void *got = steedRealloc(ptr, nb);
+        if (uintptr_t(got) % s_pool_align != 0)
+        {
+            // realloc keeps max_align_t only: move to an aligned block
+            void *al = steedMemalign(s_pool_align, nb);
+            memcpy(al, got, (ob < nb) ? ob : nb);
+            free(got);
+            got = al;
+        } // if
+        st.updatePeak(st.m_inuse.fetch_add(nb - ob, std::memory_order_relaxed) + nb - ob);
+        return got;
+    } // if
+
+    void *got = steedPoolAlloc(size, false);
+    memcpy(got, ptr, (ob < nb) ? ob : nb);
+    steedPoolFree(ptr, old);
+    return got;
+} // steedPoolRealloc
+
+
+
+void steedPoolFree(void *ptr, size_t size)
+{
+    if (ptr == nullptr) { return; }
+
+    size_t     bs = steedPoolSize(size);
+    uint32_t   ci = getClass(size);
+    GlobalPool &gp = GlobalPool::get();
+    PoolStats  &st = gp.m_stats;
+    st.m_free_num.fetch_add(1, std::memory_order_relaxed);
+    st.m_inuse   .fetch_sub(bs, std::memory_order_relaxed);
+
+    bool cache = (ci < s_class_num) && (st.m_cache_cap.load(std::memory_order_relaxed) > 0);
+    if (!cache) { free(ptr); return; }
+
+    st.m_cached.fetch_add(bs, std::memory_order_relaxed);
+    ThreadCache *tc = localCache();
+    if ((tc != nullptr) && ((tc->m_free[ci].size() + 1) * bs <= s_thread_class_cap))
+    {   tc->m_free[ci].emplace_back(ptr); return;   }
+    if (gp.put(ci, ptr)) { return; }
+
+    free(ptr);
+    st.m_cached.fetch_sub(bs, std::memory_order_relaxed);
+} // steedPoolFree
+
+
+
+void steedPoolSetCache(size_t cap)
+{
+    GlobalPool::get().m_stats.m_cache_cap.store(cap, std::memory_order_relaxed);
+    if (cap == 0) { steedPoolTrim(); }
+} // steedPoolSetCache
+
+
+
+void steedPoolTrim(void)
+{
+    GlobalPool  &gp = GlobalPool::get();
+    ThreadCache *tc = localCache();
+    for (uint32_t ci = 0; (tc != nullptr) && (ci < s_class_num); ++ci)
+    {
+        size_t bs = size_t(1) << (ci + s_class_min_bit);
+        for (auto p : tc->m_free[ci]) { free(p); }
+        gp.m_stats.m_cached.fetch_sub(bs * tc->m_free[ci].size(), std::memory_order_relaxed);
+        tc->m_free[ci].clear();
+    } // for ci
+    gp.trim();
+} // steedPoolTrim
+
+
+
+void steedAllocStats(AllocStats &s)
+{
+    PoolStats &st = GlobalPool::get().m_stats;
+    s.m_alloc_num = st.m_alloc_num.load(std::memory_order_relaxed);
+    s.m_free_num  = st.m_free_num .load(std::memory_order_relaxed);
+    s.m_pool_hit  = st.m_pool_hit .load(std::memory_order_relaxed);
+    s.m_pool_miss = st.m_pool_miss.load(std::memory_order_relaxed);
+    s.m_inuse     = st.m_inuse    .load(std::memory_order_relaxed);
+    s.m_peak      = st.m_peak     .load(std::memory_order_relaxed);
+    s.m_cached    = st.m_cached   .load(std::memory_order_relaxed);
+    s.m_zeroed    = st.m_zeroed   .load(std::memory_order_relaxed);
+} // steedAllocStats
+
 } // namespace steed
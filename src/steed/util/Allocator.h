@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
 
 namespace steed {
 
@@ -38,8 +41,9 @@ void* steedMemalign(size_t align, size_t size);
 /**
  * Steed wrapper around ::malloc()
  * If malloc() fails, reports error with stack trace and exit.
+ * @param zero    zero the memory, skip it if the caller overwrites it 
  */
-void* steedMalloc(size_t size);
+void* steedMalloc(size_t size, bool zero = true);
 
 /**
  * Steed wrapper around ::realloc().
@@ -54,4 +58,82 @@ void* steedRealloc(void* ptr, size_t size);
 
 void steedFree(void* ptr);
 
+
+
+/**
+ * Size class pool:
+ *   blocks are aligned to s_pool_align and sized by powers of 2 from
+ *   s_pool_min to s_pool_max. Freed blocks are kept in a per-thread cache
+ *   first, then in a global cache bounded by steedPoolSetCache, and are
+ *   reused by later allocations of the same class. Larger blocks are
+ *   allocated and freed directly.
+ */
+const size_t s_pool_align = 4096;       /**< block alignment         */
+const size_t s_pool_min   = 4096;       /**< smallest class size     */
+const size_t s_pool_max   = 64UL << 20; /**< largest class size: 64MB */
+
+/** allocation statistics of the pool */
+class AllocStats {
+public:
+    uint64_t m_alloc_num {0}; /**< allocation number              */
+    uint64_t m_free_num  {0}; /**< free number                    */
+    uint64_t m_pool_hit  {0}; /**< allocations reusing a block    */
+    uint64_t m_pool_miss {0}; /**< allocations from the system    */
+    uint64_t m_inuse     {0}; /**< bytes in use                   */
+    uint64_t m_peak      {0}; /**< peak bytes in use              */
+    uint64_t m_cached    {0}; /**< bytes kept in the caches       */
+    uint64_t m_zeroed    {0}; /**< bytes zeroed on allocation     */
+
+public:
+    /** output the statistics */
+    void output(FILE *fp);
+}; // AllocStats
+
+/**
+ * get the block size allocated for size bytes
+ * @param size    requested bytes
+ * @return class size; size aligned to s_pool_align above s_pool_max
+ */
+size_t steedPoolSize(size_t size);
+
+/**
+ * allocate a block of steedPoolSize(size) bytes aligned to s_pool_align
+ * If the allocation fails, reports error with stack trace and exit.
+ * @param size    requested bytes
+ * @param zero    zero the whole block
+ */
+void*  steedPoolAlloc(size_t size, bool zero = true);
+
+/**
+ * resize the block: direct blocks are realloced, others are copied,
+ *   a direct block moved off s_pool_align by realloc is copied again
+ * @param ptr     block got by steedPoolAlloc
+ * @param old     size requested or the block size of ptr
+ * @param size    new requested bytes
+ * @return new block of steedPoolSize(size) bytes
+ */
+void*  steedPoolRealloc(void *ptr, size_t old, size_t size);
+
+/**
+ * return the block to the pool
+ * @param ptr     block got by steedPoolAlloc
+ * @param size    size requested or the block size
+ */
+void   steedPoolFree (void *ptr, size_t size);
+
+/**
+ * set the global cache capacity, 0 disables caching
+ * @param cap    max cached bytes in the global cache
+ */
+void   steedPoolSetCache(size_t cap);
+
+/** free the blocks in the global cache and the cache of current thread */
+void   steedPoolTrim (void);
+
+/**
+ * get a snapshot of the pool statistics
+ * @param s    got statistics
+ */
+void   steedAllocStats(AllocStats &s);
+
 } // namespace steed 
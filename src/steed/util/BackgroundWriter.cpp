@@ -0,0 +1,177 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file BackgroundWriter.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   BackgroundWriter functions definitions
+ */
+
+#include "BackgroundWriter.h"
+
+namespace steed {
+
+
+BackgroundWriter::~BackgroundWriter(void)
+{
+    close();
+
+    for (auto &b : m_free)
+    {   delete b; b = nullptr;   }
+    m_free.clear();
+
+    m_file_io   = nullptr;
+    m_pend_cap  = m_buf_num = 0;
+} // dtor
+
+
+
+int BackgroundWriter::init(FileIO *fio, uint32_t pend)
+{
+    if ((fio == nullptr) || (pend == 0) || m_thread.joinable())
+    {
+        printf("BackgroundWriter: init with invalid params!\n");
+        return -1;
+    } // if
+
+    m_file_io   = fio;
+    m_pend_cap  = pend;
+    m_stop      = false;
+    m_error     = 0;
+    m_thread    = std::thread(&BackgroundWriter::run, this);
+    return 0;
+} // init
+
+
+
+Buffer *BackgroundWriter::acquire(void)
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+
+    // create buffers until m_pend_cap ones are in use
+    if (m_free.empty() && (m_buf_num < m_pend_cap))
+    {
+        ++m_buf_num;
+        Buffer *buf = new Buffer();
+        buf->initInMemory();
+        return buf;
+    } // if
+
+    m_done.wait(lk, [this]{ return !m_free.empty() || (m_error < 0); });
+    if (m_error < 0) { return nullptr; }
+
+    Buffer *buf = m_free.back();
+    m_free.pop_back();
+    buf->clear();
+    return buf;
+} // acquire
+
+
+
+int BackgroundWriter::submit(Buffer *buf, uint64_t off)
+{
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_error < 0)
+        {
+            m_free.emplace_back(buf);
+            return m_error;
+        } // if
+        m_pending.emplace_back(buf, off);
+    }
+
+    m_todo.notify_one();
+    return 0;
+} // submit
+
+
+
+int BackgroundWriter::sync(void)
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_done.wait(lk, [this]{ return m_pending.empty() && !m_writing; });
+    return m_error;
+} // sync
+
+
+
+int BackgroundWriter::trim(void)
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_done.wait(lk, [this]{ return m_pending.empty() && !m_writing; });
+    for (auto buf : m_free) { delete buf; }
+    m_buf_num -= uint32_t(m_free.size());
+    m_free.clear();
+    return m_error;
+} // trim
+
+
+
+int BackgroundWriter::close(void)
+{
+    if (!m_thread.joinable()) { return m_error; }
+
+    int s = sync();
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stop = true;
+    }
+    m_todo.notify_one();
+    m_thread.join();
+
+    return s;
+} // close
+
+
+
+void BackgroundWriter::run(void)
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+        m_todo.wait(lk, [this]{ return m_stop || !m_pending.empty(); });
+        if (m_pending.empty()) { break; } // stop after all written
+
+        Task task = m_pending.front();
+        m_pending.pop_front();
+        m_writing = true;
+
+        // write without lock
+        lk.unlock();
+        uint64_t len = task.m_buf->used();
+        char    *bin = (char*)task.m_buf->data();
+        int64_t  got = m_file_io->writeContentAt(task.m_off, len, bin);
+        lk.lock();
+
+        if ((got < 0) || (uint64_t(got) != len))
+        {
+            printf("BackgroundWriter: write [%lu] @ [%lu] failed!\n", len, task.m_off);
+            m_error = -1;
+        } // if
+        else { Metrics::add(Metrics::cab_written); }
+
+        m_free.emplace_back(task.m_buf);
+        m_writing = false;
+        m_done.notify_all();
+    } // while
+} // run
+
+
+} // namespace steed
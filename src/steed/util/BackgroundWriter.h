@@ -0,0 +1,130 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file BackgroundWriter.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   write filled Buffers to file in a background thread
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "Buffer.h"
+#include "FileIO.h"
+
+namespace steed {
+
+/**
+ * BackgroundWriter owns a set of Buffers:
+ *   the caller acquires an empty Buffer, fills it and submits it with
+ *   the file offset. The Buffer is written by the background thread and
+ *   recycled. At most m_pend_cap Buffers are pending at the same time,
+ *   acquire blocks until one of them is written.
+ *   Each Buffer holds one CAB, counted as written in Metrics once it is.
+ */
+class BackgroundWriter {
+protected:
+    /** pending write task */
+    class Task {
+    public:
+        Buffer  *m_buf{nullptr}; /**< content to write */
+        uint64_t m_off{0};       /**< file offset     */
+
+    public:
+        Task(Buffer *b, uint64_t o) : m_buf(b), m_off(o) {}
+    }; // Task
+
+protected:
+    FileIO                 *m_file_io  {nullptr}; /**< file to write    */
+    uint32_t                m_pend_cap {0};       /**< max pending num  */
+    uint32_t                m_buf_num  {0};       /**< created buf num  */
+
+    std::deque <Task>       m_pending{};  /**< buffers wait to write  */
+    std::vector<Buffer*>    m_free   {};  /**< written buffers 2 reuse */
+    bool                    m_writing{false}; /**< thread is writing  */
+    bool                    m_stop   {false}; /**< stop thread flag   */
+    int                     m_error  {0};     /**< first write error  */
+
+    std::mutex              m_mutex{};    /**< protect members above  */
+    std::condition_variable m_todo {};    /**< notify pending task    */
+    std::condition_variable m_done {};    /**< notify task is done    */
+    std::thread             m_thread{};   /**< background thread      */
+
+public:
+    BackgroundWriter (void) = default;
+    ~BackgroundWriter(void);
+    BackgroundWriter (const BackgroundWriter&) = delete;
+
+public:
+    /**
+     * init and start the background thread
+     * @param fio     FileIO to write, owned by caller
+     * @param pend    max pending buffer number
+     * @return 0 success; <0 failed
+     */
+    int init(FileIO *fio, uint32_t pend);
+
+    /**
+     * get an empty Buffer to fill,
+     *   block when m_pend_cap buffers are pending
+     * @return Buffer instance; nullptr for failed
+     */
+    Buffer *acquire(void);
+
+    /**
+     * submit filled Buffer to write in background
+     * @param buf    Buffer got from acquire
+     * @param off    file offset to write
+     * @return 0 success; <0 failed
+     */
+    int submit(Buffer *buf, uint64_t off);
+
+    /**
+     * barrier: wait until all pending buffers are written
+     * @return 0 success; <0 write failed
+     */
+    int sync (void);
+
+    /**
+     * sync and free the written buffers to release memory,
+     *   buffers are created again by acquire
+     * @return 0 success; <0 write failed
+     */
+    int trim (void);
+
+    /**
+     * sync and stop the background thread
+     * @return 0 success; <0 write failed
+     */
+    int close(void);
+
+protected:
+    /** background thread loop */
+    void run(void);
+}; // BackgroundWriter
+
+} // namespace steed
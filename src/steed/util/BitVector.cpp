@@ -0,0 +1,223 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file BitVector.cpp
+ * @author  Zhiyi Wang  <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   bulk pack and unpack functions for BitVector.
+ */
+
+#include <type_traits>
+
+#include "BitVector.h"
+
+namespace steed {
+
+namespace {
+
+/*
+ * Elements are packed little endian without gap, so 8 elements with W bits
+ * take exactly W bytes and a group of 8 begins at a byte boundary. The group
+ * kernels below have no branch and a const shift for each element, which the
+ * compiler vectorizes; they are compiled twice, for the default target and
+ * for AVX2, and the AVX2 one is chosen at runtime when the CPU supports it.
+ */
+
+/** word holding a group of 8 elements: W bytes */
+template <uint32_t W>
+using GroupWord = typename std::conditional<(W <= 8), uint64_t, unsigned __int128>::type;
+
+
+template <uint32_t W, class T>
+inline __attribute__((always_inline))
+void unpackGroups(const uint8_t *src, uint64_t gnum, T *dst)
+{
+    const GroupWord<W> mask = (GroupWord<W>(1) << W) - 1;
+    for (uint64_t g = 0; g < gnum; ++g, src += W, dst += 8)
+    {
+        GroupWord<W> word = 0;
+        memcpy(&word, src, W);
+        for (uint32_t k = 0; k < 8; ++k)
+        {   dst[k] = T((word >> (k * W)) & mask);   }
+    } // for g
+} // unpackGroups
+
+
+template <uint32_t W>
+inline __attribute__((always_inline))
+void packGroups(const uint8_t *src, uint64_t gnum, uint8_t *dst)
+{
+    const uint64_t mask = (uint64_t(1) << W) - 1;
+    for (uint64_t g = 0; g < gnum; ++g, src += 8, dst += W)
+    {
+        uint64_t word = 0;
+        for (uint32_t k = 0; k < 8; ++k)
+        {   word |= (uint64_t(src[k]) & mask) << (k * W);   }
+        memcpy(dst, &word, W);
+    } // for g
+} // packGroups
+
+
+#define STEED_BV_CASE_8(F, ...) \
+    case 1: F<1>(__VA_ARGS__); break; case 2: F<2>(__VA_ARGS__); break; \
+    case 3: F<3>(__VA_ARGS__); break; case 4: F<4>(__VA_ARGS__); break; \
+    case 5: F<5>(__VA_ARGS__); break; case 6: F<6>(__VA_ARGS__); break; \
+    case 7: F<7>(__VA_ARGS__); break; case 8: F<8>(__VA_ARGS__); break;
+
+#define STEED_BV_CASE_16(F, ...) STEED_BV_CASE_8(F, __VA_ARGS__) \
+    case  9: F< 9>(__VA_ARGS__); break; case 10: F<10>(__VA_ARGS__); break; \
+    case 11: F<11>(__VA_ARGS__); break; case 12: F<12>(__VA_ARGS__); break; \
+    case 13: F<13>(__VA_ARGS__); break; case 14: F<14>(__VA_ARGS__); break; \
+    case 15: F<15>(__VA_ARGS__); break; case 16: F<16>(__VA_ARGS__); break;
+
+/** define the group kernels dispatched by mask size for a target */
+#define STEED_BV_KERNELS(SUFFIX, ATTR) \
+ATTR void unpack8##SUFFIX(uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst) \
+{ switch (w) { STEED_BV_CASE_8(unpackGroups, src, gnum, dst) default: break; } } \
+ATTR void unpack16##SUFFIX(uint32_t w, const uint8_t *src, uint64_t gnum, uint16_t *dst) \
+{ switch (w) { STEED_BV_CASE_16(unpackGroups, src, gnum, dst) default: break; } } \
+ATTR void pack8##SUFFIX(uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst) \
+{ switch (w) { STEED_BV_CASE_8(packGroups, src, gnum, dst) default: break; } }
+
+STEED_BV_KERNELS(Default, )
+
+#if defined(__x86_64__)
+STEED_BV_KERNELS(Avx2, __attribute__((target("avx2"))))
+
+bool hasAvx2(void)
+{
+    static const bool s_avx2 = __builtin_cpu_supports("avx2");
+    return s_avx2;
+} // hasAvx2
+
+void unpackBits(uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst)
+{ hasAvx2() ? unpack8Avx2 (w, src, gnum, dst) : unpack8Default (w, src, gnum, dst); }
+
+void unpackBits(uint32_t w, const uint8_t *src, uint64_t gnum, uint16_t *dst)
+{ hasAvx2() ? unpack16Avx2(w, src, gnum, dst) : unpack16Default(w, src, gnum, dst); }
+
+void packBits  (uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst)
+{ hasAvx2() ? pack8Avx2   (w, src, gnum, dst) : pack8Default   (w, src, gnum, dst); }
+#else
+void unpackBits(uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst)
+{ unpack8Default (w, src, gnum, dst); }
+
+void unpackBits(uint32_t w, const uint8_t *src, uint64_t gnum, uint16_t *dst)
+{ unpack16Default(w, src, gnum, dst); }
+
+void packBits  (uint32_t w, const uint8_t *src, uint64_t gnum, uint8_t *dst)
+{ pack8Default   (w, src, gnum, dst); }
+#endif
+
+#undef STEED_BV_KERNELS
+#undef STEED_BV_CASE_16
+#undef STEED_BV_CASE_8
+
+} // namespace
+
+
+
+template <class T>
+int64_t BitVector::unpackValues(uint64_t bgn, uint64_t num, T *vals)
+{
+    if (m_mask_size > (sizeof(T) << 3))  { return -1; }
+    if (bgn + num > m_elem_used)         { return -1; }
+    if (m_mask_size == 0)
+    {   memset(vals, 0x00, num * sizeof(T)); return int64_t(num);   }
+
+    // head and tail elements out of the groups one by one
+    uint64_t ei = bgn, end = bgn + num;
+    for (; (ei < end) && (ei % 8 != 0); ++ei)
+    {   *vals++ = T(get(ei));   }
+
+    uint64_t gnum = (end - ei) / 8;
+    const uint8_t *src = (const uint8_t*)m_cont + (ei / 8) * m_mask_size;
+    unpackBits(uint32_t(m_mask_size), src, gnum, vals);
+    ei += gnum * 8, vals += gnum * 8;
+
+    for (; ei < end; ++ei)
+    {   *vals++ = T(get(ei));   }
+
+    return int64_t(num);
+} // unpackValues
+
+
+
+int64_t BitVector::unpack(uint64_t bgn, uint64_t num, uint8_t  *vals)
+{   return unpackValues(bgn, num, vals);   }
+
+int64_t BitVector::unpack(uint64_t bgn, uint64_t num, uint16_t *vals)
+{   return unpackValues(bgn, num, vals);   }
+
+
+
+int BitVector::pack(const uint8_t *vals, uint64_t num)
+{
+    if (m_mask_size == 0) { return 0; }
+    if (m_mask_size >  8) { return -1; }
+    if (m_bits_used + num * m_mask_size > m_bits_cap)
+    {   puts("BitVector: pack overflow!"); return -1;   }
+
+    // head elements one by one until a group begin
+    uint64_t vi = 0;
+    for (; (vi < num) && (m_elem_used % 8 != 0); ++vi)
+    {   append(vals[vi]);   }
+
+    // groups overwrite whole bytes: prepare the 64 bits units as append
+    uint64_t gnum = (num - vi) / 8;
+    uint64_t gend = m_bits_used + gnum * 8 * m_mask_size;
+    while (gend > m_next_64bit) { prepareNext64bit(); }
+
+    uint8_t *dst = (uint8_t*)m_cont + m_bits_used / 8;
+    packBits(uint32_t(m_mask_size), vals + vi, gnum, dst);
+    m_bits_used  = gend;
+    m_elem_used += gnum * 8;
+    vi += gnum * 8;
+
+    for (; vi < num; ++vi)
+    {   append(vals[vi]);   }
+
+    return 0;
+} // pack
+
+
+
+int BitVector::append(uint64_t val, uint64_t num)
+{
+    if (m_mask_size == 0) { return 0; }
+    if (m_mask_size >  8)
+    {
+        for (uint64_t i = 0; i < num; ++i)
+        {   if (append(val) < 0) { return -1; }   }
+        return 0;
+    } // if
+
+    uint8_t  same[256];
+    memset(same, int(val & m_mask), sizeof(same));
+    for (uint64_t done = 0; done < num; done += sizeof(same))
+    {
+        uint64_t cnt = (num - done < sizeof(same)) ? (num - done) : sizeof(same);
+        if (pack(same, cnt) < 0) { return -1; }
+    } // for done
+
+    return 0;
+} // append
+
+} // namespace steed
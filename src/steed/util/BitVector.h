@@ -182,7 +182,46 @@ public:
      */
     int   append       (uint64_t val);
 
+    /**
+     * append an integer num times into the BitVector
+     * @param val    integer value 
+     * @param num    append times 
+     * @return 0 success; <0 failed 
+     */
+    int   append       (uint64_t val, uint64_t num);
+
+public: // bulk funcs: 8 elements in mask size bytes a time, AVX2 if supported
+    /**
+     * append elements in array into the BitVector 
+     * @param vals   element values, mask size <= 8
+     * @param num    element number  
+     * @return 0 success; <0 failed 
+     */
+    int   pack  (const uint8_t *vals, uint64_t num);
+
+    /**
+     * unpack elements [bgn, bgn + num) to array 
+     * @param bgn    begin element index 
+     * @param num    element number 
+     * @param vals   element values, mask size <= 8 or 16 
+     * @return >=0 unpacked number; <0 failed 
+     */
+    int64_t unpack(uint64_t bgn, uint64_t num, uint8_t  *vals);
+    int64_t unpack(uint64_t bgn, uint64_t num, uint16_t *vals);
+
 protected:
+    /**
+     * unpack elements to array with the value type T
+     * @return >=0 unpacked number; <0 failed 
+     */
+    template <class T>
+    int64_t unpackValues(uint64_t bgn, uint64_t num, T *vals);
+
+    /**
+     * prepare the next 64 bits to append: clear the bits in m_bits_cap 
+     */
+    void  prepareNext64bit(void);
+
     /**
      * append a zero value into the BitVector
      * @param val    integer value 
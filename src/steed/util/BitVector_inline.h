@@ -202,27 +202,32 @@ int BitVector::append (uint64_t val)
 
     // check unit overflow
     if (m_bits_used + m_mask_size > m_next_64bit)  
-    {
-        if (m_next_64bit + 64 <= m_bits_cap)
-        {
-            m_cont[m_next_64bit / 64] = 0;
-            m_next_64bit += 64;
-        }
-        else
-        {
-            // next 64 is overflow than m_bits_cap 
-            uint64_t my_last    = (m_bits_cap - m_next_64bit);
-            uint64_t my_mask    = (uint64_t(1) << my_last) - 1;
-            uint64_t other_mask = ~my_mask;
-            m_cont[m_next_64bit / 64] &= other_mask; // keeps other's bits
-            m_next_64bit += 64;
-        } // if 
-    } // if 
+    {   prepareNext64bit();   }
 
     return (val == 0) ? appendZero() : appendNotZero(val);
 } // append 
 
 
+inline
+void BitVector::prepareNext64bit(void)
+{
+    if (m_next_64bit + 64 <= m_bits_cap)
+    {
+        m_cont[m_next_64bit / 64] = 0;
+        m_next_64bit += 64;
+    }
+    else
+    {
+        // next 64 is overflow than m_bits_cap 
+        uint64_t my_last    = (m_bits_cap - m_next_64bit);
+        uint64_t my_mask    = (uint64_t(1) << my_last) - 1;
+        uint64_t other_mask = ~my_mask;
+        m_cont[m_next_64bit / 64] &= other_mask; // keeps other's bits
+        m_next_64bit += 64;
+    } // if 
+} // prepareNext64bit
+
+
 inline 
 int BitVector::appendZero (void) 
 {
@@ -31,10 +31,12 @@ namespace steed {
 // must define a Config when using the buffer
 extern steed::Config g_config;
 
-Buffer::Buffer(uint32_t cap) : m_align(g_config.m_mem_align_size)
+Buffer::Buffer(uint64_t cap, bool zero) :
+    m_zero(zero), m_mem(MemTracker::current()), m_align(g_config.m_mem_align_size)
 {
-    m_cap = ((cap < m_align) ? m_align : Utility::calcAlignSize(cap, m_align));
-    m_buffer = (char*)steedMalloc(m_cap);
+    m_pool = (m_align <= s_pool_align) && (s_pool_align % m_align == 0);
+    m_cap  = ((cap < m_align) ? m_align : Utility::calcAlignSize(cap, m_align));
+    m_buffer = allocMem(m_cap, true); // initial size is bounded by callers
 } // constructor
 
 } // namespace steed
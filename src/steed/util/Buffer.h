@@ -28,10 +28,12 @@
 
 #include <stdint.h>  // uint64_t 
 #include <string>    // string 
+#include <utility>   // swap 
 
 #include "Config.h"
 #include "Utility.h"
 #include "Allocator.h"
+#include "MemTracker.h"
 #include "FileIO.h" 
 
 namespace steed {
@@ -39,14 +41,28 @@ namespace steed {
 class Buffer {
 protected:
     char    *m_buffer{nullptr}; /**< buffer in memory  */
-    uint32_t m_used{0};         /**< buffer used bytes */
-    uint32_t m_cap {0};         /**< buffer capability */
+    uint64_t m_used{0};         /**< buffer used bytes */
+    uint64_t m_cap {0};         /**< buffer capability */
 
     FileIO  *m_file_io{nullptr}; /**< read and write with file   */
     uint8_t  m_io_type{invalid}; /**< buffer mode: default in mem*/
 
+    bool     m_view{false};        /**< m_buffer is in file mapping */
+    char    *m_hold_buf{nullptr};  /**< own memory held during view */
+    uint64_t m_hold_cap{0};        /**< own memory capability       */
+
+    bool     m_zero{true};         /**< zero memory when allocated  */
+    bool     m_pool{false};        /**< memory from the size class pool */
+
+    MemTracker *m_mem   {nullptr}; /**< charged memory tracker      */
+    bool        m_budget{false};   /**< refuse to grow over budget  */
+
 public: 
     const uint32_t m_align{0}; /**< memory aligned base */ 
+
+    /** grow geometrically (x2) below this capacity, linearly above it */
+    static const uint64_t s_grow_linear_threshold = 1UL << 30; // 1GB
+    static const uint64_t s_grow_linear_step      = 1UL << 30; // 1GB
     
     /** buffer mode */
     enum BufferMode { 
@@ -60,7 +76,13 @@ public:
 
 public:
     ~Buffer(void);
-    Buffer (uint32_t cap = 0);
+
+    /**
+     * @param cap     init capacity, rounded up to the block size 
+     * @param zero    zero the memory, false if the content is always 
+     *                written before read (text read, file loaded, ...)
+     */
+    Buffer (uint64_t cap = 0, bool zero = true);
     Buffer (const Buffer&) = delete;
 
 public:
@@ -75,23 +97,26 @@ public:
     /**
      * init 2 write the content in m_buffer 
      * @param n        file name string 2 write 
+     * @param direct   use O_DIRECT IO for aligned content 
      * @return 0 success; <0 failed 
      */
-    int init2write (const std::string &n);
+    int init2write (const std::string &n, bool direct = false);
 
     /**
      * init 2 read the content in file 2 memory assigned 
      * @param n        file name string  
+     * @param direct   use O_DIRECT IO for aligned content 
      * @return 0 success; <0 failed 
      */
-    int init2read  (const std::string &n); 
+    int init2read  (const std::string &n, bool direct = false); 
   
     /**
      * init 2 read and write the content with file 
      * @param n        file name string  
+     * @param direct   use O_DIRECT IO for aligned content 
      * @return 0 success; <0 failed 
      */
-    int init2modify(const std::string &n); 
+    int init2modify(const std::string &n, bool direct = false); 
 
     /**
      * set FileIO to this instance,
@@ -106,10 +131,67 @@ public:
     FileIO *getFileIO(void)
     { return m_file_io; }
 
+    /**
+     * map the file read only to view the content without copying,
+     *   see FileIO::mapContent
+     * @param advice    madvise advice of the access pattern 
+     * @return 1 mapped; 0 not mapped, read by IO; <0 failed 
+     */
+    int     mapFile  (int advice)
+    { return (m_file_io == nullptr) ? -1 : m_file_io->mapContent(advice); }
+
+protected:
+    /**
+     * allocate own memory: from the pool when m_align fits its blocks
+     * @param cap    capacity, updated to the block size 
+     * @param force  charge m_mem even over its budget
+     * @return memory got; nullptr as refused by the budget
+     */
+    char *allocMem(uint64_t &cap, bool force);
+
+    /** free own memory got by allocMem and release the charge */
+    void  freeMem (char *buf, uint64_t cap);
+
+    /**
+     * enable O_DIRECT IO on FileIO, using m_align as the align size 
+     * @return 0 success or fall back to buffered IO; <0 failed 
+     */
+    int enableDirect(void);
+
+    /**
+     * hold own memory and point to the content to view 
+     * @param cont   content begin 
+     * @param len    content length 
+     */
+    void startView  (const char *cont, uint64_t len);
+
+    /**
+     * stop viewing the mapping and restore the own memory, 
+     *   the content in view is dropped
+     */
+    void releaseView(void);
+
+    /**
+     * stop viewing the mapping and copy the content to own memory 
+     *   before the content is modified 
+     * @return 0 success; <0 failed 
+     */
+    int  detachView (void);
+
 public: 
-    void     clear     (void)  { m_used = 0;      }
+    void     clear     (void)  { if (m_view) { releaseView(); } m_used = 0; }
+    MemTracker *getMemTracker(void) { return m_mem; }
+
+    /**
+     * growing over the budget of the MemTracker is refused, 
+     *   reserve and append return failure instead of charging the bytes. 
+     *   Only set it when the caller handles the failure.
+     * @param b    refuse or not 
+     */
+    void     setBudget (bool b) { m_budget = b; }
     void*    data      (void)  { return m_buffer; }
     bool     valid     (void)  { return (m_io_type != invalid); }
+    bool     isView    (void)  { return m_view; }
 
     uint64_t used      (void)  { return m_used; }        
     uint64_t capacity  (void)  { return m_cap ; }        
@@ -120,6 +202,22 @@ public:
     int      reserve   (uint64_t cap);
     int      append    (const void *src, uint64_t len);
 
+    /**
+     * calc the capacity to grow to when need bytes are required
+     *   doubling while the buffer is small, fixed steps when it is large
+     * @param need    minimum capacity required
+     * @return capacity to reserve; 0 for overflow
+     */
+    uint64_t calcGrowCapacity(uint64_t need);
+
+    /**
+     * swap memory content with another Buffer,
+     *   FileIO and buffer mode are kept by each Buffer,
+     *   the charged MemTracker is swapped with the content 
+     * @param b    Buffer to swap content with
+     */
+    void     swapContent(Buffer &b);
+
 public:
     /**
      * get align size
@@ -147,7 +245,7 @@ public:
      * @param end    end   offset write to file: default is -1 as end
      * @return >0 write bytes number; <0  error 
      */
-    int flush2File(uint64_t bgn = 0, uint64_t end = (uint64_t)-1);
+    int64_t flush2File(uint64_t bgn = 0, uint64_t end = (uint64_t)-1);
 
     /**
      * load content from file 2 buffer
@@ -155,7 +253,24 @@ public:
      * @param resize  allow realloc flag to resize buffer 
      * @return >0 read-in block size; 0 EOF; <0 error
      */
-    int load2Buffer(uint64_t len, bool resize);
+    int64_t load2Buffer(uint64_t len, bool resize);
+
+    /**
+     * view content in the file mapping as the buffer content (read only),
+     *   load the content as load2Buffer if not mapped or the buffer is used 
+     * @param len    content length 
+     * @return >0 viewed or read-in size; 0 EOF; <0 error
+     */
+    int64_t view2Buffer(uint64_t len);
+
+    /**
+     * view content owned by others as the buffer content (read only),
+     *   the content must be alive until the buffer is cleared 
+     * @param cont   content begin 
+     * @param len    content length 
+     * @return >=0 viewed size; <0 error
+     */
+    int64_t view2Buffer(const void *cont, uint64_t len);
 
 public:
     void output2debug(void) ;
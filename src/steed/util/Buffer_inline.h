@@ -31,8 +31,9 @@ namespace steed {
 inline
 Buffer::~Buffer (void)
 {
+    if (m_view) { releaseView(); }
     if (m_buffer != nullptr)
-    { free(m_buffer); m_buffer = nullptr; } 
+    { freeMem(m_buffer, m_cap); m_buffer = nullptr; } 
     m_used = 0, m_cap = 0;
 
     bool is_rd  = (m_io_type == read  );
@@ -46,33 +47,111 @@ Buffer::~Buffer (void)
 } // dtor
 
 inline
-int Buffer::init2write(const std::string &n)
+char *Buffer::allocMem(uint64_t &cap, bool force)
+{
+    if (m_pool) { cap = steedPoolSize(cap); }
+    if (!m_mem->consume(cap, force || !m_budget)) { return nullptr; }
+
+    if (!m_pool)
+    {
+        char *got = (char*)steedMemalign(m_align, cap);
+        if (m_zero) { memset(got, 0, cap); }
+        return got;
+    } // if 
+
+    return (char*)steedPoolAlloc(cap, m_zero);
+} // allocMem
+
+inline
+void Buffer::freeMem(char *buf, uint64_t cap)
+{
+    m_mem->release(cap);
+    if (m_pool) { steedPoolFree(buf, cap); }
+    else        { free(buf); }
+} // freeMem
+
+inline
+int Buffer::init2write(const std::string &n, bool direct)
 {
     m_io_type = write;
     m_file_io = new FileIOViaOS();
-    return m_file_io->init2write(n);
+    int s = m_file_io->init2write(n);
+    return ((s < 0) || !direct) ? s : enableDirect();
 } // init2write
  
 inline
-int Buffer::init2read (const std::string &n)
+int Buffer::init2read (const std::string &n, bool direct)
 {
     m_io_type = read;
     m_file_io = new FileIOViaOS(); 
-    return m_file_io->init2read(n); 
+    int s = m_file_io->init2read(n); 
+    return ((s < 0) || !direct) ? s : enableDirect();
 } // init2read
 
 inline
-int Buffer::init2modify (const std::string &n)
+int Buffer::init2modify (const std::string &n, bool direct)
 {
     m_io_type = modify;
     m_file_io = new FileIOViaOS(); 
-    return m_file_io->init2modify(n); 
+    int s = m_file_io->init2modify(n); 
+    return ((s < 0) || !direct) ? s : enableDirect();
 } // init2modify 
 
+inline
+int Buffer::enableDirect(void)
+{
+    // not supported by file system is not an error
+    return (m_file_io->enableDirect(m_align) < 0) ? -1 : 0;
+} // enableDirect 
+
+
+inline
+void Buffer::startView(const char *cont, uint64_t len)
+{
+    m_hold_buf = m_buffer, m_hold_cap = m_cap;
+    m_buffer   = const_cast<char*>(cont);
+    m_used     = m_cap = len;
+    m_view     = true;
+} // startView
+
+
+inline
+void Buffer::releaseView(void)
+{
+    m_buffer = m_hold_buf, m_cap = m_hold_cap, m_used = 0;
+    m_hold_buf = nullptr , m_hold_cap = 0;
+    m_view = false;
+} // releaseView
+
+
+inline
+int Buffer::detachView(void)
+{
+    const char *cont = m_buffer;
+    uint64_t    used = m_used;
+    releaseView();
+
+    if (reserve(used) < 0)
+    {
+        printf("Buffer: reserve to detach view failed!\n");
+        return -1;
+    } // if 
+
+    memcpy(m_buffer, cont, used);
+    m_used = used;
+    return 0;
+} // detachView
+
 
 inline
 void* Buffer::allocate(uint64_t len, bool resize) 
 {
+    if (len > UINT64_MAX - m_used)
+    {
+        printf("Buffer: allocate [%lu] overflow!\n", len);
+        return nullptr;
+    } // if 
+
     uint64_t nu = m_used + len; // next used
     if (nu > m_cap)
     {
@@ -82,7 +161,8 @@ void* Buffer::allocate(uint64_t len, bool resize)
             return nullptr;
         } // if 
 
-        if (reserve(nu * 2) < 0) 
+        uint64_t cap = calcGrowCapacity(nu);
+        if ((cap == 0) || (reserve(cap) < 0)) 
         {
             printf("Buffer: resize to allocator failed!\n");
             return nullptr;
@@ -101,6 +181,8 @@ void* Buffer::allocate(uint64_t len, bool resize)
 inline
 int Buffer::deallocate(uint64_t len) 
 {
+    if (m_view && (detachView() < 0)) { return -1; }
+
     int  ret_val  = 0;
     bool underflow = (len > m_used);  
     if  (underflow)
@@ -119,10 +201,30 @@ inline
 int Buffer::reserve(uint64_t cap)
 {
     if (m_cap >= cap) { return 0; }
+    if (m_view && (detachView() < 0)) { return -1; }
+
+    if (cap > UINT64_MAX - m_align)
+    {
+        printf("Buffer: reserve [%lu] overflow!\n", cap);
+        return -1;
+    } // if 
 
+    // grow by a new m_align block and copy the used bytes into it:
+    //   below s_grow_linear_threshold the copy is paid once per doubling.
+    //   Larger buffers are copied too, realloc keeps only max_align_t
+    //   and FileIO falls back to buffered IO for a misaligned buffer
     cap = Utility::calcAlignSize(cap, this->m_align);
     int   ret_val = 0; 
-    char *buf_got = (char*)steedRealloc(m_buffer, cap); 
+    bool  zero    = m_zero;
+    m_zero = false; // only the tail is zeroed below
+    char *buf_got = allocMem(cap, false);
+    m_zero = zero;
+    if (buf_got != nullptr)
+    {
+        memcpy (buf_got, m_buffer, m_used);
+        freeMem(m_buffer, m_cap);
+    } // if 
+
     if   (buf_got == nullptr)
     {
         printf("Buffer: reserve failed!\n");
@@ -132,17 +234,62 @@ int Buffer::reserve(uint64_t cap)
     {
         m_buffer = buf_got;
         m_cap    = cap;
-        memset(m_buffer + m_used, 0, m_cap - m_used);
+        if (m_zero) { memset(m_buffer + m_used, 0, m_cap - m_used); }
     }  // if 
     return ret_val; 
 } // reserve
 
 
+inline
+uint64_t Buffer::calcGrowCapacity(uint64_t need)
+{
+    uint64_t cap = m_cap;
+    if (cap < s_grow_linear_threshold)
+    {
+        // geometric growth: double while the buffer is small
+        cap = (cap == 0) ? need : cap;
+        while ((cap < need) && (cap < s_grow_linear_threshold))
+        {   cap *= 2;   }
+    } // if 
+
+    if (cap < need)
+    {
+        // linear growth: append fixed steps to avoid over-commit
+        uint64_t lack  = need - cap;
+        uint64_t steps = (lack + s_grow_linear_step - 1) / s_grow_linear_step;
+        if (steps > (UINT64_MAX - cap) / s_grow_linear_step)
+        {   return 0;   } // overflow
+        cap += steps * s_grow_linear_step;
+    } // if 
+
+    return cap;
+} // calcGrowCapacity
+
+
+inline
+void Buffer::swapContent(Buffer &b)
+{
+    assert(m_align == b.m_align);
+    assert(!m_view && !b.m_view);
+    std::swap(m_buffer, b.m_buffer);
+    std::swap(m_used  , b.m_used  );
+    std::swap(m_cap   , b.m_cap   );
+    std::swap(m_mem   , b.m_mem   );
+} // swapContent
+
+
 inline
 int Buffer::append(const void *src, uint64_t len)
 {
-    bool resize = (m_used + len > m_cap);
-    if ((resize) && (reserve(m_used + len) < 0))
+    if (len > UINT64_MAX - m_used)
+    {
+        printf("Buffer: append [%lu] overflow!\n", len);
+        return -1;
+    } // if 
+
+    bool     resize = (m_used + len > m_cap);
+    uint64_t cap    = resize ? calcGrowCapacity(m_used + len) : m_cap;
+    if ((resize) && ((cap == 0) || (reserve(cap) < 0)))
     {
         printf("Buffer: reserve to append failed!\n");  
         return -1; 
@@ -156,7 +303,7 @@ int Buffer::append(const void *src, uint64_t len)
 
 
 inline
-int Buffer::flush2File(uint64_t bgn, uint64_t end)
+int64_t Buffer::flush2File(uint64_t bgn, uint64_t end)
 {
     if (m_file_io == nullptr)
     {
@@ -176,7 +323,7 @@ int Buffer::flush2File(uint64_t bgn, uint64_t end)
 
 
 inline
-int Buffer::load2Buffer(uint64_t len, bool resize)
+int64_t Buffer::load2Buffer(uint64_t len, bool resize)
 {
     if (m_file_io == nullptr)
     {
@@ -184,8 +331,8 @@ int Buffer::load2Buffer(uint64_t len, bool resize)
         return -1;
     }
 
-    int   ret_val = 0;
-    char* rd_pos  = (char*)allocate(len, resize);
+    int64_t ret_val = 0;
+    char*   rd_pos  = (char*)allocate(len, resize);
     if   (rd_pos == nullptr)
     {
         printf("Buffer: allocate 2 load failed!\n"); 
@@ -198,11 +345,38 @@ int Buffer::load2Buffer(uint64_t len, bool resize)
 } // load2Buffer
 
 
+inline
+int64_t Buffer::view2Buffer(uint64_t len)
+{
+    bool        idle = (m_file_io != nullptr) && (m_used == 0) && !m_view;
+    const char *cont = idle ? m_file_io->viewContent(len) : nullptr;
+    if (cont == nullptr) { return load2Buffer(len, true); }
+
+    startView(cont, len);
+    return int64_t(len);
+} // view2Buffer
+
+
+inline
+int64_t Buffer::view2Buffer(const void *cont, uint64_t len)
+{
+    if (m_view) { releaseView(); }
+    if (m_used != 0)
+    {
+        printf("Buffer: view content in a used buffer!\n");
+        return -1;
+    } // if 
+
+    startView((const char*)cont, len);
+    return int64_t(len);
+} // view2Buffer
+
+
 inline
 void Buffer::output2debug(void)
 {
     printf("Buffer output2debug:\n");
-    printf("m_buffer:[%p] m_used:[%u] m_cap:[%u]\n", m_buffer, m_used, m_cap);
+    printf("m_buffer:[%p] m_used:[%lu] m_cap:[%lu]\n", m_buffer, m_used, m_cap);
     printf("available size:[%lu]\n\n", available());
 
     // print buffer content to debug in hex and char 
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "Buffer.h"
+#include "Logger.h"
 
 namespace steed {
 
@@ -35,7 +35,7 @@ Container<T>::Container (uint32_t cap)
 {
     m_ptrs.reserve(cap);
     m_size = sizeof (T);
-    m_buf  = new Buffer(m_size * cap);
+    m_buf  = new Buffer(m_size * cap, false); // constructed by alloc
 } // ctor 
 
 
@@ -98,7 +98,7 @@ T* Container<T>::alloc(void)
     uint64_t len = m_buf->available();
     if ((m_size > len) && (doubleCap() < 0))
     {
-        printf("Container: doubleCap failed!\n");
+        STEED_LOG(error, "Container: doubleCap failed!");
         return nullptr;
     } // if 
 
@@ -117,7 +117,7 @@ int Container<T>::doubleCap (void)
 
     Buffer  *org_buf = m_buf; 
     uint64_t buf_cap = m_buf->capacity();
-    m_buf = new Buffer(buf_cap * 2);
+    m_buf = new Buffer(buf_cap * 2, false);
 
     // copy org_ptrs to m_ptrs
     for (auto &p : org_ptrs)
@@ -133,7 +133,7 @@ int Container<T>::doubleCap (void)
         T*  n =  this->appendNew();
         if (n == nullptr)
         {
-            printf("Container: appendNew failed!\n");
+            STEED_LOG(error, "Container: appendNew failed!");
             return -1;
         } // if
         
@@ -115,4 +115,47 @@ int64_t FileHandlerViaOS::write(uint64_t offset, const void *buffer, uint64_t bu
     return wt_done;
 } // write 
 
+
+
+int64_t FileHandlerViaOS::writeAt(uint64_t offset, const void *buffer, uint64_t bufsize)
+{
+    const char *wt_pos = (const char*)buffer;
+    int64_t  wt_done = 0;
+    uint64_t wt_size = bufsize;
+    while   (wt_size > 0)  // avoid pwrite() interrupted by a signal
+    {
+        int64_t wt_num = ::pwrite(m_file_desc, wt_pos, wt_size, offset + wt_done);
+        if (wt_num > 0)
+        {
+            wt_pos += wt_num, wt_done += wt_num, wt_size -= wt_num;
+        } 
+        else
+        {
+            printf("FileHandlerViaOS: writeAt file[%d] using len[%lu]@[%lu] got errno[%d]!\n", 
+                m_file_desc, wt_size, offset + wt_done, errno);
+            DebugInfo::printStackAndExit(); 
+            return -1;
+        }
+    } // while
+
+    return wt_done;
+} // writeAt
+
+
+
+void *FileHandlerViaOS::map(uint64_t len, int advice)
+{
+    void *addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, m_file_desc, 0);
+    if (addr == MAP_FAILED)
+    {
+        printf("FileHandlerViaOS: mmap file[%d] len[%lu] got errno[%d]!\n", 
+            m_file_desc, len, errno);
+        return nullptr;
+    } // if
+
+    // only a hint: ignore the failure
+    ::madvise(addr, len, advice);
+    return addr;
+} // map
+
 } // namespace steed 
@@ -29,6 +29,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
@@ -94,6 +95,16 @@ public:
      */
     virtual int64_t write(uint64_t offset, const void *buffer, uint64_t bufsize) = 0;
 
+    /**
+     * Blocking write content to file without moving the file offset,
+     *   used by background writer while the owner seeks the file 
+     * @param offset    file offset begin to write  
+     * @param buffer    buffer used to write 
+     * @param bufsize   write length  
+     * @return >=0 success; -1 errors and errno is set appropriately
+     */
+    virtual int64_t writeAt(uint64_t offset, const void *buffer, uint64_t bufsize) = 0;
+
     /**
      * repositions the file offset of the open file description
      * @param offset    file offset   
@@ -102,6 +113,22 @@ public:
      */
     virtual uint64_t seek (uint64_t offset, int whence) = 0;
 
+    /**
+     * map the file content into memory as read only 
+     * @param len       mapped length from the file begin 
+     * @param advice    madvise advice of the access pattern 
+     * @return mapped address; nullptr as error
+     */
+    virtual void *map  (uint64_t len, int advice) = 0;
+
+    /**
+     * unmap the content got from map 
+     * @param addr      mapped address 
+     * @param len       mapped length 
+     * @return 0 success; -1 errors and errno is set appropriately
+     */
+    virtual int   unmap(void *addr, uint64_t len) = 0;
+
 public: 
     /**
      * get file size
@@ -140,8 +167,13 @@ public:
 public:
     int64_t  read (uint64_t offset,       void *buffer, uint64_t bufsize) override;
     int64_t  write(uint64_t offset, const void *buffer, uint64_t bufsize) override;
+    int64_t  writeAt(uint64_t offset, const void *buffer, uint64_t bufsize) override;
     uint64_t seek (uint64_t offset, int whence) override
-    { return ::lseek(m_file_desc, offset, whence); }
+    { return (m_file_off = ::lseek(m_file_desc, offset, whence)); }
+
+    void    *map  (uint64_t len, int advice) override;
+    int      unmap(void *addr, uint64_t len) override
+    { return ::munmap(addr, len); }
 
 private:
     /**
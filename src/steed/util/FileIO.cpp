@@ -32,12 +32,24 @@ namespace steed {
 
 void FileIO::uninit(void)
 {
+    // unmap before closing the file 
+    if ((m_map_addr != nullptr) && (m_file_hand->unmap((void*)m_map_addr, m_map_size) < 0))
+    {   DebugInfo::printStackAndExit();   } 
+    m_map_addr = nullptr, m_map_size = 0;
+
     // close file if needed
     if ((m_file_hand != nullptr) && (m_file_hand->close() < 0))
     {   DebugInfo::printStackAndExit();   } 
 
     delete m_file_hand;
     m_file_hand = nullptr, m_file_name.clear();  
+
+    if ((m_direct_hand != nullptr) && (m_direct_hand->close() < 0))
+    {   DebugInfo::printStackAndExit();   } 
+
+    delete m_direct_hand;
+    m_direct_hand = nullptr, m_direct_align = 0;
+
     m_file_size = 0, m_offset = 0, m_type = invalid;
 } // dtor 
 
@@ -81,4 +93,57 @@ int FileIOViaOS::init(IOType t, const string &n, int flags, mode_t mt)
     return ret_val;
 } // init
 
+
+
+int FileIOViaOS::enableDirect(uint32_t align)
+{
+    if ((m_type == invalid) || (align == 0))
+    {
+        printf("FileIOViaOS: enable O_DIRECT before init!\n");
+        return -1;
+    } // if
+
+    if (m_direct_hand != nullptr) { return 1; }
+
+    // the same file opened again without page cache 
+    int flags = ((m_type == read) ? O_RDONLY : O_RDWR) | O_DIRECT;
+    FileHandler *fh = new FileHandlerViaOS(); 
+    if (fh->open(m_file_name.c_str(), flags) < 0)
+    {
+        printf("FileIOViaOS: O_DIRECT on [%s] got errno [%d], use buffered IO!\n",
+            m_file_name.c_str(), errno);
+        delete fh;
+        return 0;
+    } // if
+
+    m_direct_hand  = fh;
+    m_direct_align = align;
+    return 1;
+} // enableDirect
+
+
+
+int FileIOViaOS::mapContent(int advice)
+{
+    if (m_type != read)
+    {
+        printf("FileIOViaOS: map [%s] is only supported to read!\n", m_file_name.c_str());
+        return -1;
+    } // if
+
+    if (m_map_addr != nullptr) { return 1; }
+    if (m_file_size == 0)      { return 0; } // nothing to map
+
+    void *addr = m_file_hand->map(m_file_size, advice);
+    if (addr == nullptr)
+    {
+        printf("FileIOViaOS: map [%s] failed, use read IO!\n", m_file_name.c_str());
+        return 0;
+    } // if
+
+    m_map_addr = (const char*)addr;
+    m_map_size = m_file_size;
+    return 1;
+} // mapContent
+
 } // namespace steed 
@@ -33,6 +33,8 @@
 #include <string>
 
 #include "DebugInfo.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "FileHandler.h"
 
 namespace steed {
@@ -51,6 +53,10 @@ protected:
 
 protected: 
     FileHandler   *m_file_hand{nullptr}; /**< file handler pointer */
+    FileHandler   *m_direct_hand{nullptr}; /**< O_DIRECT file handler */
+    uint32_t       m_direct_align{0};      /**< O_DIRECT align size  */
+    const char    *m_map_addr{nullptr};    /**< mapped file content  */
+    uint64_t       m_map_size{0};          /**< mapped content size  */
     std::string    m_file_name{};        /**< file name string */
     uint64_t       m_file_size{0};       /**< current file size */
     uint64_t       m_offset{0};          /**< file offset to read and write */
@@ -66,6 +72,8 @@ public:
     const string &getNameStr(void)  { return m_file_name; }
     uint64_t      getSize   (void)  { return m_file_size; }
     uint64_t      getOffset (void)  { return m_offset; }
+    bool          isDirect  (void)  { return m_direct_hand != nullptr; }
+    bool          isMapped  (void)  { return m_map_addr    != nullptr; }
 
 public:
     /**
@@ -108,7 +116,65 @@ protected:
      */
     virtual int init(IOType t, const string &n, int flag, mode_t mt) = 0;
 
+    /**
+     * calc the content length able to use O_DIRECT IO 
+     * @param off     file offset 
+     * @param len     content length 
+     * @param cont    content begin pointer 
+     * @return aligned length from cont; 0 for buffered IO only 
+     */
+    uint64_t calcDirectLength(uint64_t off, uint64_t len, const char *cont)
+    {
+        bool aligned = (m_direct_hand != nullptr) &&
+            (off % m_direct_align == 0) && (uintptr_t(cont) % m_direct_align == 0);
+        return aligned ? (len / m_direct_align * m_direct_align) : 0;
+    } // calcDirectLength
+
 public: 
+    /**
+     * enable O_DIRECT IO after init, the aligned content bypasses the
+     *   page cache and the unaligned tail falls back to buffered IO 
+     * @param align    align size of file offset, length and memory 
+     * @return 1 enabled; 0 not supported, use buffered IO; <0 failed
+     */
+    virtual int enableDirect(uint32_t align) = 0;
+
+    /**
+     * write content at the file offset without moving m_offset,
+     *   m_file_size is not updated either 
+     * @param off     file offset to write 
+     * @param len     content length 
+     * @param cont    content begin pointer 2 write 
+     * @return >0 write bytes as success; < 0 failed
+     */
+    virtual int64_t writeContentAt(uint64_t off, uint64_t len, const char* cont) = 0;
+
+    /**
+     * map the whole file read only after init, the mapping is shared
+     *   by all processes and FileIO instances reading the same file 
+     * @param advice    madvise advice, such as MADV_SEQUENTIAL for scans
+     * @return 1 mapped; 0 not mapped (empty file or failed), read by IO; <0 failed
+     */
+    virtual int mapContent(int advice) = 0;
+
+    /**
+     * get the mapped content @ m_offset and move m_offset as reading it 
+     * @param len     content length 
+     * @return content begin in mapping; nullptr as not mapped or out of range
+     */
+    const char *viewContent(uint64_t len)
+    {
+        bool in_map = (m_map_addr != nullptr) && (m_offset <= m_map_size) &&
+            (len <= m_map_size - m_offset);
+        if (!in_map) { return nullptr; }
+
+        const char *cont = m_map_addr + m_offset;
+        m_offset += len;
+        Metrics::add(Metrics::bytes_read, len);
+        return cont;
+    } // viewContent
+
+
     /**
      * write content to this object
      * @param len     content length 
@@ -151,6 +217,9 @@ protected:
     int init(IOType t, const string &n, int flag, mode_t mt) override;
 
 public:
+    int      enableDirect(uint32_t align) override;
+    int      mapContent  (int advice)     override;
+    int64_t  writeContentAt(uint64_t off, uint64_t len, const char* cont) override;
     int64_t  writeContent(uint64_t len, const char* cont) override;
     int64_t  readContent (uint64_t len,       char* cont) override;
     uint64_t seekContent (uint64_t offset,    int whence) override 
@@ -162,36 +231,74 @@ public:
 inline
 int64_t FileIOViaOS::writeContent(uint64_t len, const char *cont)
 {
-    int64_t wt_size = m_file_hand->write(m_offset, cont, len);
-    if (wt_size < 0)
+    MetricsTimer timer(Metrics::t_io_write);
+    TraceScope   trace(Tracer::io_write);
+    uint64_t dlen = calcDirectLength(m_offset, len, cont);
+    int64_t  dsize = (dlen == 0) ? 0 : m_direct_hand->write(m_offset, cont, dlen);
+    int64_t  bsize = (dsize < 0) ? -1 :
+        m_file_hand->write(m_offset + dsize, cont + dsize, len - dsize);
+    if (bsize < 0)
     {
-        printf("FileIOViaOS: flush [%ld] Bytes to [%s] failed! errno is [%d]\n",
-            wt_size, m_file_name.c_str(), errno);
+        printf("FileIOViaOS: flush [%lu] Bytes to [%s] failed! errno is [%d]\n",
+            len, m_file_name.c_str(), errno);
         DebugInfo::printStackAndExit();
         return -1;
     } // if
 
     // success
+    int64_t wt_size = dsize + bsize;
+    Metrics::add(Metrics::bytes_written, wt_size);
     m_offset += wt_size;
     m_file_size = ((m_offset > m_file_size) ? m_offset : m_file_size);
     return wt_size;
 } // writeContent
 
 
+inline
+int64_t FileIOViaOS::writeContentAt(uint64_t off, uint64_t len, const char *cont)
+{
+    MetricsTimer timer(Metrics::t_io_write);
+    TraceScope   trace(Tracer::io_write);
+    uint64_t dlen = calcDirectLength(off, len, cont);
+    int64_t  dsize = (dlen == 0) ? 0 : m_direct_hand->writeAt(off, cont, dlen);
+    int64_t  bsize = (dsize < 0) ? -1 :
+        m_file_hand->writeAt(off + dsize, cont + dsize, len - dsize);
+    if (bsize < 0)
+    {
+        printf("FileIOViaOS: write [%lu] Bytes @ [%lu] to [%s] failed! errno is [%d]\n",
+            len, off, m_file_name.c_str(), errno);
+        DebugInfo::printStackAndExit();
+        return -1;
+    } // if
+
+    Metrics::add(Metrics::bytes_written, dsize + bsize);
+    return dsize + bsize;
+} // writeContentAt
+
+
 inline
 int64_t FileIOViaOS::readContent(uint64_t len, char *buf)
 {
-    int64_t rd_size = m_file_hand->read(m_offset, buf, len);
-    if (rd_size < 0) 
+    MetricsTimer timer(Metrics::t_io_read);
+    TraceScope   trace(Tracer::io_read);
+    uint64_t dlen = calcDirectLength(m_offset, len, buf);
+    int64_t  dsize = (dlen == 0) ? 0 : m_direct_hand->read(m_offset, buf, dlen);
+    int64_t  bsize = 0;
+    if ((dsize >= 0) && (uint64_t(dsize) == dlen)) // not EOF
+    {   bsize = m_file_hand->read(m_offset + dsize, buf + dsize, len - dsize);   }
+
+    if ((dsize < 0) || (bsize < 0)) 
     {
-        printf("FileIOViaOS: read[%ld] Bytes from [%s] failed! errno is [%d]\n",
-            rd_size, m_file_name.c_str(), errno);
+        printf("FileIOViaOS: read[%lu] Bytes from [%s] failed! errno is [%d]\n",
+            len, m_file_name.c_str(), errno);
         DebugInfo::printStackAndExit(); 
         return -1;
     } // if
 
     // success
+    int64_t rd_size = dsize + bsize;
     m_offset += rd_size; 
+    Metrics::add(Metrics::bytes_read, rd_size);
     return rd_size;
 } // readContent
 
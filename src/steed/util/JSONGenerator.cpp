@@ -0,0 +1,296 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file JSONGenerator.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   JSONGenerator functions definitions
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include "JSONGenerator.h"
+
+namespace steed {
+
+JSONGenOption JSONGenOption::telemetry(uint64_t seed)
+{
+    JSONGenOption opt;
+    opt.m_seed      = seed;
+    opt.m_max_depth = 1;
+    opt.m_field_min = 64;
+    opt.m_field_max = 96;
+    opt.m_sparsity  = 0.9;
+    opt.m_null_rate = 0.02;
+    opt.m_type_mix[t_int   ] = 40;
+    opt.m_type_mix[t_double] = 40;
+    opt.m_type_mix[t_bool  ] = 5;
+    opt.m_type_mix[t_string] = 15;
+    opt.m_type_mix[t_object] = 0;
+    opt.m_type_mix[t_array ] = 0;
+    opt.m_str_card  = 64;
+    return opt;
+} // telemetry
+
+
+
+JSONGenOption JSONGenOption::eventLog(uint64_t seed)
+{
+    JSONGenOption opt;
+    opt.m_seed      = seed;
+    opt.m_max_depth = 6;
+    opt.m_field_min = 2;
+    opt.m_field_max = 5;
+    opt.m_fan_out   = geometric;
+    opt.m_fan_min   = 0;
+    opt.m_fan_max   = 16;
+    opt.m_fan_mean  = 3;
+    opt.m_sparsity  = 0.1;
+    opt.m_null_rate = 0.01;
+    opt.m_type_mix[t_object] = 25;
+    opt.m_type_mix[t_array ] = 15;
+    opt.m_str_card  = 100000;
+    opt.m_str_max   = 48;
+    return opt;
+} // eventLog
+
+
+
+
+
+JSONGenerator::JSONGenerator(const JSONGenOption &opt) :
+    m_opt(opt), m_gen(0, uint64_t(-1), opt.m_seed)
+{
+    if (m_opt.m_field_max < m_opt.m_field_min) { m_opt.m_field_max = m_opt.m_field_min; }
+    if (m_opt.m_fan_max   < m_opt.m_fan_min  ) { m_opt.m_fan_max   = m_opt.m_fan_min  ; }
+    if (m_opt.m_str_max   < m_opt.m_str_min  ) { m_opt.m_str_max   = m_opt.m_str_min  ; }
+    if (m_opt.m_str_card == 0) { m_opt.m_str_card = 1; }
+
+    // string dictionary: distinct random ids with seeded lengths
+    RandomValues ids(m_opt.m_str_card, 0, uint64_t(-1), m_opt.m_seed);
+    m_strs.reserve(ids.values().size());
+    for (auto id : ids.values())
+    {
+        uint64_t len = m_opt.m_str_min + id % (m_opt.m_str_max - m_opt.m_str_min + 1);
+        string s;
+        for (uint64_t ci = 0; ci < len; ++ci, id = id * 6364136223846793005ULL + 1)
+        {   s.append(1, char('a' + (id >> 59) % 26));   }
+        m_strs.emplace_back(s);
+    } // for id
+
+    makeObject(m_root, 0);
+} // ctor
+
+
+
+uint32_t JSONGenerator::pickType(uint32_t depth)
+{
+    // nested types are not picked at the max depth
+    uint32_t tnum  = (depth + 1 < m_opt.m_max_depth) ? JSONGenOption::t_max : JSONGenOption::t_object;
+    uint64_t total = 0;
+    for (uint32_t ti = 0; ti < tnum; ++ti) { total += m_opt.m_type_mix[ti]; }
+    if (total == 0) { return JSONGenOption::t_int; }
+
+    uint64_t pick = random(0, total - 1);
+    for (uint32_t ti = 0; ti < tnum; ++ti)
+    {
+        if (pick < m_opt.m_type_mix[ti]) { return ti; }
+        pick -= m_opt.m_type_mix[ti];
+    } // for ti
+
+    return JSONGenOption::t_int;
+} // pickType
+
+
+
+uint64_t JSONGenerator::pickFanOut(void)
+{
+    if (m_opt.m_fan_out == JSONGenOption::uniform)
+    {   return random(m_opt.m_fan_min, m_opt.m_fan_max);   }
+
+    // geometric: number of failures before the first success
+    double   p   = 1.0 / (1.0 + std::max(m_opt.m_fan_mean, 0.0));
+    double   u   = m_gen.generateReal();
+    uint64_t num = uint64_t(floor(log(1.0 - u) / log(1.0 - p)));
+    num += m_opt.m_fan_min;
+    return (num > m_opt.m_fan_max) ? m_opt.m_fan_max : num;
+} // pickFanOut
+
+
+
+void JSONGenerator::makeField(FieldDef &fd, uint32_t depth)
+{
+    fd.m_type = pickType(depth);
+    fd.m_child.clear();
+
+    if (fd.m_type == JSONGenOption::t_object)
+    {
+        makeObject(fd, depth + 1);
+    }
+    else if (fd.m_type == JSONGenOption::t_array)
+    {
+        // all elements share one definition: values or objects, no matrix
+        fd.m_child.resize(1);
+        FieldDef &elem = fd.m_child.back();
+        makeField(elem, depth + 1);
+        if (elem.m_type == JSONGenOption::t_array)
+        {
+            elem.m_type = JSONGenOption::t_int;
+            elem.m_child.clear();
+        } // if
+    } // if
+} // makeField
+
+
+
+void JSONGenerator::makeObject(FieldDef &fd, uint32_t depth)
+{
+    fd.m_type = JSONGenOption::t_object;
+    fd.m_child.resize(random(m_opt.m_field_min, m_opt.m_field_max));
+    for (auto &cd : fd.m_child)
+    {
+        char name[32] = {0};
+        snprintf(name, sizeof(name), "f%lu", m_name_num++);
+        cd.m_name = name;
+        makeField(cd, depth);
+    } // for cd
+} // makeObject
+
+
+
+void JSONGenerator::drift(void)
+{
+    ++m_drift_num;
+    for (auto &cd : m_root.m_child)
+    {
+        if (!happen(m_opt.m_drift_rate)) { continue; }
+
+        // a new field replaces the old one, or the old one changes type
+        if (happen(0.5))
+        {
+            char name[32] = {0};
+            snprintf(name, sizeof(name), "f%lu", m_name_num++);
+            cd.m_name = name;
+        } // if
+        makeField(cd, 0);
+    } // for cd
+} // drift
+
+
+
+int JSONGenerator::generate(string &str)
+{
+    if ((m_opt.m_drift_every > 0) && (m_recd_num > 0) &&
+        (m_recd_num % m_opt.m_drift_every == 0))
+    {   drift();   }
+
+    appendObject(str, m_root);
+    ++m_recd_num;
+    return 0;
+} // generate
+
+
+
+int64_t JSONGenerator::output(ostream *os, uint64_t num)
+{
+    int64_t bytes = 0;
+    string  recd;
+    for (uint64_t ri = 0; ri < num; ++ri)
+    {
+        recd.clear();
+        generate(recd);
+        recd.append(1, '\n');
+        os->write(recd.data(), recd.size());
+        bytes += recd.size();
+    } // for ri
+
+    return os->good() ? bytes : -1;
+} // output
+
+
+
+void JSONGenerator::appendObject(string &str, const FieldDef &fd)
+{
+    bool first = true;
+    str.append(1, '{');
+    for (auto &cd : fd.m_child)
+    {
+        if (happen(m_opt.m_sparsity)) { continue; } // absent
+
+        if (!first) { str.append(", "); }
+        first = false;
+
+        str.append(1, '"').append(cd.m_name).append("\": ");
+        if (happen(m_opt.m_null_rate)) { str.append("null"); }
+        else                           { appendValue(str, cd); }
+    } // for cd
+    str.append(1, '}');
+} // appendObject
+
+
+
+void JSONGenerator::appendValue(string &str, const FieldDef &fd)
+{
+    char tmp[64] = {0};
+    switch (fd.m_type)
+    {
+        case JSONGenOption::t_int:
+            snprintf(tmp, sizeof(tmp), "%lu", random(0, m_opt.m_int_max));
+            str.append(tmp);
+            break;
+
+        case JSONGenOption::t_double:
+            snprintf(tmp, sizeof(tmp), "%.4f", m_gen.generateReal() * m_opt.m_int_max);
+            str.append(tmp);
+            break;
+
+        case JSONGenOption::t_bool:
+            str.append(happen(0.5) ? "true" : "false");
+            break;
+
+        case JSONGenOption::t_string:
+            str.append(1, '"').append(m_strs[random(0, m_strs.size() - 1)]).append(1, '"');
+            break;
+
+        case JSONGenOption::t_object:
+            appendObject(str, fd);
+            break;
+
+        case JSONGenOption::t_array:
+        {
+            uint64_t num = pickFanOut();
+            str.append(1, '[');
+            for (uint64_t ei = 0; ei < num; ++ei)
+            {
+                if (ei > 0) { str.append(", "); }
+                appendValue(str, fd.m_child.front());
+            } // for ei
+            str.append(1, ']');
+            break;
+        }
+
+        default:
+            str.append("null");
+            break;
+    } // switch
+} // appendValue
+
+} // namespace steed
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file JSONGenerator.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   deterministic synthetic nested JSON (NDJSON) record generator
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "RandomGenerator.h"
+#include "RandomValues.h"
+
+namespace steed {
+
+using std::string;
+using std::vector;
+using std::ostream;
+
+
+/** JSONGenerator knobs: all random choices are made by the seeded engine */
+class JSONGenOption {
+public:
+    /** array fan-out distribution */
+    enum FanOut {
+        uniform   = 0, /**< uniform in [min, max]               */
+        geometric = 1, /**< geometric with mean, clipped by max */
+    };
+
+    /** value type in the type mix */
+    enum ValueType {
+        t_int    = 0,
+        t_double = 1,
+        t_bool   = 2,
+        t_string = 3,
+        t_object = 4,
+        t_array  = 5,
+        t_max    = 6,
+    };
+
+public:
+    uint64_t m_seed      {1};      /**< generator seed             */
+
+    // shape
+    uint32_t m_max_depth {3};      /**< max nested level, root as 1 */
+    uint32_t m_field_min {2};      /**< min field number in object */
+    uint32_t m_field_max {8};      /**< max field number in object */
+    uint32_t m_fan_out   {uniform};/**< array fan-out distribution */
+    uint32_t m_fan_min   {0};      /**< min array element number   */
+    uint32_t m_fan_max   {4};      /**< max array element number   */
+    double   m_fan_mean  {2};      /**< geometric fan-out mean     */
+
+    // sparsity and nulls
+    double   m_sparsity  {0.2};    /**< rate of field absent in record */
+    double   m_null_rate {0.05};   /**< rate of present value as null  */
+
+    // value type mix weights, indexed by ValueType
+    uint32_t m_type_mix[t_max] {30, 15, 10, 25, 12, 8};
+
+    // values
+    uint64_t m_int_max   {1000000};/**< int value in [0, max]          */
+    uint64_t m_str_card  {1024};   /**< distinct string value number   */
+    uint32_t m_str_min   {4};      /**< min string length              */
+    uint32_t m_str_max   {16};     /**< max string length              */
+
+    // schema drift
+    uint64_t m_drift_every{0};     /**< records between drifts, 0 none */
+    double   m_drift_rate {0.1};   /**< rate of top fields replaced    */
+
+public:
+    /**
+     * preset of sparse telemetry:
+     *   many flat optional metrics, most absent in each record
+     */
+    static JSONGenOption telemetry(uint64_t seed);
+
+    /**
+     * preset of deeply nested event logs:
+     *   few fields per level, nested objects and arrays of objects
+     */
+    static JSONGenOption eventLog (uint64_t seed);
+}; // JSONGenOption
+
+
+
+/**
+ * JSONGenerator makes a random schema by the option and instantiates
+ *   it record by record. The same option (seed included) always
+ *   generates the same records.
+ */
+class JSONGenerator {
+protected:
+    /** generated field definition */
+    class FieldDef {
+    public:
+        string           m_name {};  /**< field name                  */
+        uint32_t         m_type {0}; /**< JSONGenOption::ValueType    */
+        vector<FieldDef> m_child{};  /**< object fields or array elem */
+    }; // FieldDef
+
+protected:
+    JSONGenOption      m_opt  ;      /**< generator option     */
+    RandomGenerator    m_gen  ;      /**< seeded random engine */
+    vector<string>     m_strs {};    /**< string dictionary    */
+    FieldDef           m_root {};    /**< current record schema*/
+    uint64_t           m_recd_num{0};/**< generated record num */
+    uint64_t           m_drift_num{0};/**< schema drift times  */
+    uint64_t           m_name_num{0};/**< named field number   */
+
+public:
+    JSONGenerator (const JSONGenOption &opt);
+    ~JSONGenerator(void) = default;
+
+public:
+    uint64_t getRecdNum (void) { return m_recd_num ; }
+    uint64_t getDriftNum(void) { return m_drift_num; }
+
+    /**
+     * append the next record to str, without the line break
+     * @param str    output string
+     * @return 0 success
+     */
+    int  generate(string &str);
+
+    /**
+     * output records as NDJSON
+     * @param os     output stream
+     * @param num    record number
+     * @return output bytes; <0 failed
+     */
+    int64_t output(ostream *os, uint64_t num);
+
+protected:
+    uint64_t random (uint64_t min, uint64_t max) { return m_gen.generate(min, max); }
+    bool     happen (double rate) { return (rate > 0) && (m_gen.generateReal() < rate); }
+
+    uint32_t pickType  (uint32_t depth);
+    uint64_t pickFanOut(void);
+    void     makeField (FieldDef &fd, uint32_t depth);
+    void     makeObject(FieldDef &fd, uint32_t depth);
+    void     drift     (void);
+
+    void     appendObject(string &str, const FieldDef &fd);
+    void     appendValue (string &str, const FieldDef &fd);
+}; // JSONGenerator
+
+} // namespace steed
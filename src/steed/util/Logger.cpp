@@ -0,0 +1,183 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Logger.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   Logger functions definitions
+ */
+
+#include <time.h>
+#include <stdarg.h>
+#include <string.h>
+#include <mutex>
+
+#include "Logger.h"
+
+namespace steed {
+
+std::atomic<int> Logger::s_level{Logger::info};
+
+const char *Logger::s_level_name[Logger::off] = {
+    "TRACE", "DEBUG", "INFO", "WARN", "ERROR"
+};
+
+
+namespace {
+
+/** sink and rate limiter state, guarded by the mutex */
+class LogSink {
+public:
+    std::mutex        m_mutex   {};
+    FILE             *m_file    {nullptr}; /**< opened file, nullptr stderr */
+    Logger::Callback  m_cb      {nullptr}; /**< callback sink               */
+    uint32_t          m_rate    {0};       /**< max messages per second     */
+    time_t            m_sec     {0};       /**< current rate window second  */
+    uint32_t          m_sec_num {0};       /**< output number in the window */
+    uint64_t          m_dropped {0};       /**< dropped number by the rate  */
+
+public:
+    static LogSink &get(void)
+    {
+        static LogSink *sink = new LogSink(); // never destroyed
+        return *sink;
+    } // get
+
+    /** @return true if the message in sec is allowed by the rate */
+    bool admit(time_t sec)
+    {
+        if (m_rate == 0) { return true; }
+        if (sec != m_sec) { m_sec = sec; m_sec_num = 0; }
+        if (m_sec_num >= m_rate) { ++m_dropped; return false; }
+        ++m_sec_num;
+        return true;
+    } // admit
+
+    void write(int l, const char *msg, const char *ts)
+    {
+        if (m_cb != nullptr) { m_cb(l, msg); return; }
+
+        FILE *fp = (m_file == nullptr) ? stderr : m_file;
+        fprintf(fp, "%s %-5s %s\n", ts, Logger::s_level_name[l], msg);
+        fflush (fp);
+    } // write
+}; // LogSink
+
+} // namespace
+
+
+
+int Logger::init(const string &level, const string &fn, uint32_t rate)
+{
+    int l = getLevel(level);
+    if (l < 0)
+    {
+        fprintf(stderr, "Logger: unknown level [%s]!\n", level.c_str());
+        return -1;
+    } // if
+
+    setLevel(Level(l));
+    setRate (rate);
+    return setFile(fn);
+} // init
+
+
+
+int Logger::getLevel(const string &n)
+{
+    static const char *names[] = {"trace", "debug", "info", "warn", "error", "off"};
+    for (int i = 0; i <= off; ++i)
+    {   if (n == names[i]) { return i; }   }
+    return -1;
+} // getLevel
+
+
+
+int Logger::setFile(const string &fn)
+{
+    FILE *fp = nullptr;
+    if (!fn.empty() && ((fp = fopen(fn.c_str(), "a")) == nullptr))
+    {
+        fprintf(stderr, "Logger: open [%s] failed!\n", fn.c_str());
+        return -1;
+    } // if
+
+    LogSink &s = LogSink::get();
+    std::lock_guard<std::mutex> lk(s.m_mutex);
+    if (s.m_file != nullptr) { fclose(s.m_file); }
+    s.m_file = fp;
+    return 0;
+} // setFile
+
+
+
+void Logger::setCallback(Callback cb)
+{
+    LogSink &s = LogSink::get();
+    std::lock_guard<std::mutex> lk(s.m_mutex);
+    s.m_cb = cb;
+} // setCallback
+
+
+
+void Logger::setRate(uint32_t rate)
+{
+    LogSink &s = LogSink::get();
+    std::lock_guard<std::mutex> lk(s.m_mutex);
+    s.m_rate = rate;
+    s.m_sec_num = 0;
+} // setRate
+
+
+
+void Logger::log(Level l, const char *fmt, ...)
+{
+    if ((l < trace) || (l >= off)) { return; }
+
+    time_t now = time(nullptr);
+    LogSink &s = LogSink::get();
+    std::lock_guard<std::mutex> lk(s.m_mutex);
+    if (!s.admit(now)) { return; }
+
+    struct tm tm_now;
+    localtime_r(&now, &tm_now);
+    char ts[32] = {0};
+    strftime(ts, sizeof(ts), "[%Y-%m-%d %H:%M:%S]", &tm_now);
+
+    char msg[1024] = {0};
+    if (s.m_dropped > 0)
+    {
+        snprintf(msg, sizeof(msg), "Logger: %lu messages dropped by the rate limit", s.m_dropped);
+        s.m_dropped = 0;
+        s.write(warn, msg, ts);
+    } // if
+
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+
+    // one message one line
+    size_t len = strlen(msg);
+    while ((len > 0) && (msg[len - 1] == '\n')) { msg[--len] = '\0'; }
+    s.write(l, msg, ts);
+} // log
+
+} // namespace steed
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Logger.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   leveled and rate limited logging to stderr, a file or a callback
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <atomic>
+
+namespace steed {
+
+using std::string;
+
+
+/**
+ * Logger writes one timestamped line per message to the sink:
+ *   stderr as default, a file or a user callback. Messages below the
+ *   level are dropped by one branch before the arguments are evaluated,
+ *   and at most rate messages per second reach the sink.
+ */
+class Logger {
+public:
+    /** log level */
+    enum Level {
+        trace = 0,
+        debug = 1,
+        info  = 2,
+        warn  = 3,
+        error = 4,
+        off   = 5,
+    };
+
+    /** sink callback: level and the message without line break */
+    typedef void (*Callback)(int level, const char *msg);
+
+    static const char *s_level_name[off]; /**< level names */
+
+protected:
+    static std::atomic<int> s_level; /**< min level to output */
+
+private:
+    Logger (void) = delete;
+    ~Logger(void) = delete;
+
+public:
+    static bool enabled (Level l)
+    { return int(l) >= s_level.load(std::memory_order_relaxed); }
+
+    static void setLevel(Level l)
+    { s_level.store(int(l), std::memory_order_relaxed); }
+
+    /**
+     * init level, file and rate limit
+     * @param level  level name
+     * @param fn     file name, empty for stderr
+     * @param rate   max message number per second, 0 unlimited
+     * @return 0 success; <0 failed
+     */
+    static int  init    (const string &level, const string &fn, uint32_t rate);
+
+    /**
+     * get level by name
+     * @param n    level name: trace, debug, info, warn, error or off
+     * @return level; <0 unknown name
+     */
+    static int  getLevel(const string &n);
+
+    /**
+     * set output file, the previous file is closed
+     * @param fn    file name, empty for stderr
+     * @return 0 success; <0 failed
+     */
+    static int  setFile (const string &fn);
+
+    /**
+     * set callback sink instead of the file
+     * @param cb    callback, nullptr to output to the file again
+     */
+    static void setCallback(Callback cb);
+
+    /**
+     * set the rate limit
+     * @param rate  max message number per second, 0 unlimited
+     */
+    static void setRate (uint32_t rate);
+
+    /**
+     * output a message, use the STEED_LOG macro to skip disabled levels
+     * @param l      message level
+     * @param fmt    printf format
+     */
+    static void log(Level l, const char *fmt, ...)
+        __attribute__((format(printf, 2, 3)));
+}; // Logger
+
+} // namespace steed
+
+
+
+/** levels below are removed at compile time */
+#ifndef STEED_LOG_MIN_LEVEL
+#define STEED_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * log a message at the level
+ *   usage: STEED_LOG(warn, "CABReader: load CAB [%lu] failed!", ci);
+ */
+#define STEED_LOG(lvl, ...)                                             \
+    do {                                                                \
+        if ((steed::Logger::lvl >= STEED_LOG_MIN_LEVEL) &&              \
+            steed::Logger::enabled(steed::Logger::lvl))                 \
+        {   steed::Logger::log(steed::Logger::lvl, __VA_ARGS__);   }    \
+    } while (0)
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file MemTracker.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   MemTracker functions definitions
+ */
+
+#include "Logger.h"
+#include "MemTracker.h"
+
+namespace steed {
+
+thread_local MemTracker *MemTracker::t_current = nullptr;
+
+
+MemTracker::MemTracker(const string &name, uint64_t limit, MemTracker *parent) :
+    m_name(name), m_parent(parent), m_limit(int64_t(limit))
+{
+    // empty
+} // ctor
+
+
+
+MemTracker::~MemTracker(void)
+{
+    // Buffers charged to the tracker must be freed before it
+    int64_t left = m_used.load();
+    if (left != 0)
+    {
+        STEED_LOG(warn, "MemTracker: [%s] destroyed with [%ld] bytes charged!",
+            m_name.c_str(), left);
+    } // if
+} // dtor
+
+
+
+MemTracker &MemTracker::process(void)
+{
+    static MemTracker *proc = new MemTracker("process", 0, nullptr); // never destroyed
+    return *proc;
+} // process
+
+
+
+bool MemTracker::consume(uint64_t n, bool force)
+{
+    int64_t sn = int64_t(n);
+    for (MemTracker *t = this; t != nullptr; t = t->m_parent)
+    {
+        int64_t used  = t->m_used.fetch_add(sn) + sn;
+        int64_t limit = t->m_limit.load();
+        if (!force && (limit > 0) && (used > limit))
+        {
+            // roll back the charged trackers, t included
+            for (MemTracker *r = this; r != t->m_parent; r = r->m_parent)
+            {   r->m_used.fetch_sub(sn);   }
+
+            ++t->m_refused;
+            STEED_LOG(warn, "MemTracker: [%s] refused [%lu] bytes, used [%ld] limit [%ld]!",
+                t->m_name.c_str(), n, used - sn, limit);
+            return false;
+        } // if
+
+        int64_t peak = t->m_peak.load();
+        while ((used > peak) && !t->m_peak.compare_exchange_weak(peak, used)) {}
+    } // for t
+
+    return true;
+} // consume
+
+
+
+void MemTracker::release(uint64_t n)
+{
+    for (MemTracker *t = this; t != nullptr; t = t->m_parent)
+    {   t->m_used.fetch_sub(int64_t(n));   }
+} // release
+
+
+
+uint64_t MemTracker::available(void) const
+{
+    uint64_t avail = UINT64_MAX;
+    for (const MemTracker *t = this; t != nullptr; t = t->m_parent)
+    {
+        int64_t limit = t->m_limit.load();
+        if (limit <= 0) { continue; }
+
+        int64_t  used = t->m_used.load();
+        uint64_t left = (used >= limit) ? 0 : uint64_t(limit - used);
+        avail = (left < avail) ? left : avail;
+    } // for t
+
+    return avail;
+} // available
+
+
+
+bool MemTracker::pressured(void) const
+{
+    for (const MemTracker *t = this; t != nullptr; t = t->m_parent)
+    {
+        int64_t limit = t->m_limit.load();
+        if (limit <= 0) { continue; }
+
+        int64_t used = t->m_used.load();
+        if (used * s_pressure_den >= limit * s_pressure_num) { return true; }
+    } // for t
+
+    return false;
+} // pressured
+
+
+
+void MemTracker::output(FILE *fp) const
+{
+    for (const MemTracker *t = this; t != nullptr; t = t->m_parent)
+    {
+        fprintf(fp, "MemTracker [%s]: used [%lu] peak [%lu] limit [%lu] refused [%lu]\n",
+            t->m_name.c_str(), t->getUsed(), t->getPeak(), t->getLimit(), t->getRefused());
+    } // for t
+} // output
+
+} // namespace steed
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file MemTracker.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   memory accountant with per-process and per-query byte budgets
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <atomic>
+
+namespace steed {
+
+using std::string;
+
+
+/**
+ * MemTracker counts the bytes held by Buffers and cached CABs:
+ *   trackers form a tree, the process tracker is the root and each query
+ *   owns a child. Bytes charged to a tracker are charged to its ancestors,
+ *   and a charge is refused when any of them would exceed its limit.
+ *   Buffers are charged to the current tracker of the thread when they are
+ *   created, see MemTrackerScope.
+ */
+class MemTracker {
+public:
+    /** pressured when the used bytes reach 7/8 of the limit */
+    static const uint32_t s_pressure_num = 7;
+    static const uint32_t s_pressure_den = 8;
+
+protected:
+    string                 m_name   {};        /**< name to output     */
+    MemTracker            *m_parent {nullptr}; /**< parent tracker     */
+    std::atomic<int64_t>   m_limit  {0};       /**< max bytes, 0 unlimited */
+    std::atomic<int64_t>   m_used   {0};       /**< charged bytes      */
+    std::atomic<int64_t>   m_peak   {0};       /**< max charged bytes  */
+    std::atomic<uint64_t>  m_refused{0};       /**< refused charge num */
+
+    static thread_local MemTracker *t_current; /**< current of thread  */
+
+public:
+    /**
+     * @param name    name to output
+     * @param limit   max bytes, 0 unlimited
+     * @param parent  parent tracker, nullptr for the root
+     */
+    MemTracker (const string &name, uint64_t limit, MemTracker *parent);
+    ~MemTracker(void);
+    MemTracker (const MemTracker&) = delete;
+
+public:
+    /** @return the process (root) tracker */
+    static MemTracker &process(void);
+
+    /** @return current tracker of this thread, the process one as default */
+    static MemTracker *current(void)
+    { return (t_current != nullptr) ? t_current : &process(); }
+
+    /**
+     * set current tracker of this thread
+     * @param t    tracker, nullptr for the process one
+     * @return previous current tracker
+     */
+    static MemTracker *setCurrent(MemTracker *t)
+    { MemTracker *prev = t_current; t_current = t; return prev; }
+
+public:
+    const string &getName   (void) const { return m_name; }
+    MemTracker   *getParent (void) const { return m_parent; }
+    uint64_t      getLimit  (void) const { return uint64_t(m_limit.load()); }
+    uint64_t      getUsed   (void) const { return uint64_t(m_used .load()); }
+    uint64_t      getPeak   (void) const { return uint64_t(m_peak .load()); }
+    uint64_t      getRefused(void) const { return m_refused.load(); }
+    void          setLimit  (uint64_t l) { m_limit.store(int64_t(l)); }
+
+    /**
+     * charge bytes to this tracker and its ancestors
+     * @param n       bytes to charge
+     * @param force   charge even over the limit, for fixed size buffers
+     * @return true charged; false refused by a limit, nothing is charged
+     */
+    bool consume(uint64_t n, bool force = false);
+
+    /**
+     * release bytes charged by consume
+     * @param n       bytes to release
+     */
+    void release(uint64_t n);
+
+    /**
+     * @return bytes could be charged before reaching any limit,
+     *         UINT64_MAX as unlimited
+     */
+    uint64_t available(void) const;
+
+    /** @return true if this or any ancestor is near or over its limit */
+    bool pressured(void) const;
+
+    /** output usage of this tracker and its ancestors */
+    void output(FILE *fp) const;
+}; // MemTracker
+
+
+
+/** set the current tracker of this thread in the scope */
+class MemTrackerScope {
+protected:
+    MemTracker  *m_prev{nullptr}; /**< previous current tracker */
+
+public:
+    MemTrackerScope (MemTracker *t) : m_prev(MemTracker::setCurrent(t)) {}
+    ~MemTrackerScope(void) { MemTracker::setCurrent(m_prev); }
+    MemTrackerScope (const MemTrackerScope&) = delete;
+}; // MemTrackerScope
+
+} // namespace steed
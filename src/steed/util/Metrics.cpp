@@ -0,0 +1,261 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Metrics.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   Metrics functions definitions
+ */
+
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "Metrics.h"
+
+namespace steed {
+
+std::atomic<bool> Metrics::s_enabled{false};
+
+const char *Metrics::s_counter_name[Metrics::counter_max] = {
+    "recd_parsed", "recd_assembled", "bytes_read", "bytes_written",
+    "cab_written", "cab_read", "bytes_compressed", "bytes_decompressed",
+    "cache_hit", "cache_miss"
+};
+
+const char *Metrics::s_timer_name[Metrics::timer_max] = {
+    "parse", "encode", "compress", "decompress", "io_read", "io_write", "assemble"
+};
+
+
+namespace {
+
+/**
+ * metrics block of one thread:
+ *   only the owner thread writes, so a relaxed load and store is enough
+ */
+class MetricsBlock {
+public:
+    std::atomic<uint64_t> m_cnt   [Metrics::counter_max];
+    std::atomic<uint64_t> m_tm_num[Metrics::timer_max];
+    std::atomic<uint64_t> m_tm_ns [Metrics::timer_max];
+    std::atomic<uint64_t> m_hist  [Metrics::timer_max][Metrics::s_bucket_num];
+
+public:
+    MetricsBlock(void) { clear(); }
+
+    static void inc(std::atomic<uint64_t> &a, uint64_t n)
+    { a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+
+    void clear(void)
+    {
+        for (auto &c : m_cnt   ) { c.store(0, std::memory_order_relaxed); }
+        for (auto &c : m_tm_num) { c.store(0, std::memory_order_relaxed); }
+        for (auto &c : m_tm_ns ) { c.store(0, std::memory_order_relaxed); }
+        for (auto &h : m_hist  )
+        {   for (auto &c : h) { c.store(0, std::memory_order_relaxed); }   }
+    } // clear
+
+    void sum2Snapshot(MetricsSnapshot &s) const
+    {
+        for (uint32_t i = 0; i < Metrics::counter_max; ++i)
+        {   s.m_cnt[i] += m_cnt[i].load(std::memory_order_relaxed);   }
+
+        for (uint32_t i = 0; i < Metrics::timer_max; ++i)
+        {
+            s.m_tm_num[i] += m_tm_num[i].load(std::memory_order_relaxed);
+            s.m_tm_ns [i] += m_tm_ns [i].load(std::memory_order_relaxed);
+            for (uint32_t b = 0; b < Metrics::s_bucket_num; ++b)
+            {   s.m_hist[i][b] += m_hist[i][b].load(std::memory_order_relaxed);   }
+        } // for i
+    } // sum2Snapshot
+}; // MetricsBlock
+
+
+/** all living thread blocks and the sum of exited threads */
+class MetricsRegistry {
+public:
+    std::mutex                   m_mutex  {};
+    std::vector<MetricsBlock*>   m_blocks {};
+    MetricsSnapshot              m_retired{};
+
+public:
+    static MetricsRegistry &get(void)
+    {
+        static MetricsRegistry *reg = new MetricsRegistry(); // never destroyed
+        return *reg;
+    } // get
+}; // MetricsRegistry
+
+
+/** thread local holder: register on first use and retire at thread exit */
+class MetricsHolder {
+public:
+    MetricsBlock  m_block{};
+
+public:
+    MetricsHolder(void)
+    {
+        MetricsRegistry &reg = MetricsRegistry::get();
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        reg.m_blocks.emplace_back(&m_block);
+    } // ctor
+
+    ~MetricsHolder(void)
+    {
+        MetricsRegistry &reg = MetricsRegistry::get();
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        m_block.sum2Snapshot(reg.m_retired);
+        auto &bv = reg.m_blocks;
+        bv.erase(std::remove(bv.begin(), bv.end(), &m_block), bv.end());
+    } // dtor
+}; // MetricsHolder
+
+
+MetricsBlock &localBlock(void)
+{
+    static thread_local MetricsHolder holder;
+    return holder.m_block;
+} // localBlock
+
+} // namespace
+
+
+
+void Metrics::addLocal(Counter c, uint64_t n)
+{
+    MetricsBlock::inc(localBlock().m_cnt[c], n);
+} // addLocal
+
+
+
+void Metrics::recordLocal(Timer t, uint64_t ns)
+{
+    MetricsBlock &b = localBlock();
+    MetricsBlock::inc(b.m_tm_num[t], 1);
+    MetricsBlock::inc(b.m_tm_ns [t], ns);
+
+    uint32_t bi = (ns == 0) ? 0 : uint32_t(63 - __builtin_clzll(ns));
+    if (bi >= s_bucket_num) { bi = s_bucket_num - 1; }
+    MetricsBlock::inc(b.m_hist[t][bi], 1);
+} // recordLocal
+
+
+
+void Metrics::snapshot(MetricsSnapshot &snap)
+{
+    snap = MetricsSnapshot();
+
+    MetricsRegistry &reg = MetricsRegistry::get();
+    std::lock_guard<std::mutex> lk(reg.m_mutex);
+    for (auto b : reg.m_blocks) { b->sum2Snapshot(snap); }
+
+    const MetricsSnapshot &r = reg.m_retired;
+    for (uint32_t i = 0; i < counter_max; ++i) { snap.m_cnt[i] += r.m_cnt[i]; }
+    for (uint32_t i = 0; i < timer_max; ++i)
+    {
+        snap.m_tm_num[i] += r.m_tm_num[i];
+        snap.m_tm_ns [i] += r.m_tm_ns [i];
+        for (uint32_t b = 0; b < s_bucket_num; ++b)
+        {   snap.m_hist[i][b] += r.m_hist[i][b];   }
+    } // for i
+} // snapshot
+
+
+
+void Metrics::reset(void)
+{
+    MetricsRegistry &reg = MetricsRegistry::get();
+    std::lock_guard<std::mutex> lk(reg.m_mutex);
+    for (auto b : reg.m_blocks) { b->clear(); }
+    reg.m_retired = MetricsSnapshot();
+} // reset
+
+
+
+void Metrics::output(FILE *fp)
+{
+    MetricsSnapshot s;
+    snapshot(s);
+
+    fprintf(fp, "Metrics: counters\n");
+    for (uint32_t i = 0; i < counter_max; ++i)
+    {   fprintf(fp, "  %-20s %16lu\n", s_counter_name[i], s.m_cnt[i]);   }
+
+    fprintf(fp, "Metrics: timers          num         total(ms)    p50(us)    p99(us)\n");
+    for (uint32_t i = 0; i < timer_max; ++i)
+    {
+        Timer t = Timer(i);
+        fprintf(fp, "  %-12s %12lu %16.3f %10.1f %10.1f\n", s_timer_name[i],
+            s.m_tm_num[i], s.m_tm_ns[i] / 1e6,
+            s.percentile(t, 0.5) / 1e3, s.percentile(t, 0.99) / 1e3);
+    } // for i
+} // output
+
+
+
+void Metrics::output2JSON(string &str)
+{
+    MetricsSnapshot s;
+    snapshot(s);
+
+    char tmp[256] = {0};
+    str.append("{\"counters\": {");
+    for (uint32_t i = 0; i < counter_max; ++i)
+    {
+        snprintf(tmp, sizeof(tmp), "%s\"%s\": %lu", (i ? ", " : ""),
+            s_counter_name[i], s.m_cnt[i]);
+        str.append(tmp);
+    } // for i
+
+    str.append("}, \"timers\": {");
+    for (uint32_t i = 0; i < timer_max; ++i)
+    {
+        Timer t = Timer(i);
+        snprintf(tmp, sizeof(tmp),
+            "%s\"%s\": {\"num\": %lu, \"ns\": %lu, \"p50_ns\": %lu, \"p99_ns\": %lu}",
+            (i ? ", " : ""), s_timer_name[i], s.m_tm_num[i], s.m_tm_ns[i],
+            s.percentile(t, 0.5), s.percentile(t, 0.99));
+        str.append(tmp);
+    } // for i
+    str.append("}}");
+} // output2JSON
+
+
+
+uint64_t MetricsSnapshot::percentile(Metrics::Timer t, double p) const
+{
+    uint64_t num = m_tm_num[t];
+    if (num == 0) { return 0; }
+
+    uint64_t want = uint64_t(p * num + 0.5);
+    want = (want == 0) ? 1 : want;
+
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < Metrics::s_bucket_num; ++b)
+    {
+        seen += m_hist[t][b];
+        if (seen >= want) { return (uint64_t(2) << b) - 1; }
+    } // for b
+
+    return (uint64_t(2) << (Metrics::s_bucket_num - 1)) - 1;
+} // percentile
+
+} // namespace steed
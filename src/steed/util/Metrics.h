@@ -0,0 +1,185 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Metrics.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   hot path counters, timers and time histograms
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include <chrono>
+
+namespace steed {
+
+using std::string;
+
+
+/** summed values of all threads */
+class MetricsSnapshot;
+
+
+/**
+ * Metrics keeps counters and timers per thread:
+ *   each thread only updates its own block without locking, a snapshot
+ *   sums the blocks of all living and exited threads. When disabled,
+ *   each update point costs one branch.
+ */
+class Metrics {
+public:
+    /** counter id */
+    enum Counter {
+        recd_parsed       = 0, /**< JSON records parsed         */
+        recd_assembled    = 1, /**< records assembled           */
+        bytes_read        = 2, /**< bytes read from files       */
+        bytes_written     = 3, /**< bytes written to files      */
+        cab_written       = 4, /**< CABs flushed                */
+        cab_read          = 5, /**< CABs loaded                 */
+        bytes_compressed  = 6, /**< original bytes compressed   */
+        bytes_decompressed= 7, /**< original bytes decompressed */
+        cache_hit         = 8, /**< CABCache lookup hit         */
+        cache_miss        = 9, /**< CABCache lookup miss        */
+        counter_max       = 10,
+    };
+
+    /** timer id */
+    enum Timer {
+        t_parse      = 0, /**< parse text records to columns */
+        t_encode     = 1, /**< encode CAB layout            */
+        t_compress   = 2, /**< compress CAB content         */
+        t_decompress = 3, /**< decompress CAB content       */
+        t_io_read    = 4, /**< file read system calls       */
+        t_io_write   = 5, /**< file write system calls      */
+        t_assemble   = 6, /**< assemble record batches      */
+        timer_max    = 7,
+    };
+
+    /** time histogram bucket number: bucket i holds [2^i, 2^(i+1)) ns */
+    static const uint32_t s_bucket_num = 40;
+
+    static const char *s_counter_name[counter_max]; /**< counter names */
+    static const char *s_timer_name  [timer_max];   /**< timer names   */
+
+protected:
+    static std::atomic<bool> s_enabled; /**< collect metrics or not */
+
+private:
+    Metrics (void) = delete;
+    ~Metrics(void) = delete;
+
+public:
+    static bool enabled(void) { return s_enabled.load(std::memory_order_relaxed); }
+    static void enable (bool e) { s_enabled.store(e, std::memory_order_relaxed); }
+
+    /** steady clock now in ns */
+    static uint64_t now(void)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    } // now
+
+    /**
+     * add to the counter of current thread
+     * @param c    counter id
+     * @param n    value to add
+     */
+    static void add(Counter c, uint64_t n = 1)
+    { if (enabled()) { addLocal(c, n); } }
+
+    /**
+     * record an elapsed time of the timer in current thread
+     * @param t     timer id
+     * @param ns    elapsed ns
+     */
+    static void record(Timer t, uint64_t ns)
+    { if (enabled()) { recordLocal(t, ns); } }
+
+public:
+    /**
+     * sum the metrics of all threads
+     * @param snap    snapshot result
+     */
+    static void snapshot(MetricsSnapshot &snap);
+
+    /** reset the metrics of all threads */
+    static void reset(void);
+
+    /**
+     * output metrics summary
+     * @param fp    output file
+     */
+    static void output(FILE *fp);
+
+    /**
+     * append metrics as a JSON object to str
+     * @param str    output string
+     */
+    static void output2JSON(string &str);
+
+protected:
+    static void addLocal   (Counter c, uint64_t n);
+    static void recordLocal(Timer   t, uint64_t ns);
+}; // Metrics
+
+
+
+class MetricsSnapshot {
+public:
+    uint64_t m_cnt   [Metrics::counter_max]{};  /**< counter values      */
+    uint64_t m_tm_num[Metrics::timer_max]  {};  /**< timer record number */
+    uint64_t m_tm_ns [Metrics::timer_max]  {};  /**< timer total ns      */
+    uint64_t m_hist  [Metrics::timer_max][Metrics::s_bucket_num]{}; /**< log2 ns */
+
+public:
+    uint64_t get(Metrics::Counter c) const { return m_cnt[c]; }
+
+    /**
+     * approximate time percentile by histogram bucket upper bound
+     * @param t    timer id
+     * @param p    percentile in (0, 1]
+     * @return ns
+     */
+    uint64_t percentile(Metrics::Timer t, double p) const;
+}; // MetricsSnapshot
+
+
+
+/** scoped timer: records the elapsed time when it is destroyed */
+class MetricsTimer {
+protected:
+    Metrics::Timer m_tm ;     /**< timer id             */
+    uint64_t       m_bgn{0};  /**< begin ns, 0 disabled */
+
+public:
+    MetricsTimer (Metrics::Timer t) : m_tm(t)
+    { if (Metrics::enabled()) { m_bgn = Metrics::now(); } }
+
+    ~MetricsTimer(void)
+    { if (m_bgn != 0) { Metrics::record(m_tm, Metrics::now() - m_bgn); } }
+
+    MetricsTimer (const MetricsTimer&) = delete;
+}; // MetricsTimer
+
+} // namespace steed
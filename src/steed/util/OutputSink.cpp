@@ -0,0 +1,240 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file OutputSink.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   OutputSink functions definitions
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Allocator.h"
+#include "OutputSink.h"
+
+namespace steed {
+
+
+
+FDSink::FDSink(int fd, uint64_t size, uint32_t iov) :
+    m_fd(fd), m_size(steedPoolSize(size)), m_iov_cap(iov == 0 ? 1 : iov)
+{
+    m_blocks.reserve(m_iov_cap);
+    m_iovs  .reserve(m_iov_cap);
+
+    m_bgn = (char*)steedPoolAlloc(m_size, false);
+    m_cap = m_size;
+    m_blocks.emplace_back(m_bgn);
+} // ctor
+
+
+
+FDSink::~FDSink(void)
+{
+    flush();
+
+    for (auto &b : m_blocks)
+    {   steedPoolFree(b, m_size); b = nullptr;   }
+    m_blocks.clear();
+    m_bgn = nullptr;
+} // dtor
+
+
+
+int FDSink::flush(void)
+{
+    if (m_fail) { return -1; }
+
+    if (m_used > 0)
+    {
+        m_iovs.push_back({m_bgn, m_used});
+        m_total += m_used, m_used = 0;
+    } // if
+
+    int ret = writeBatches();
+    m_bgn = m_blocks[0];
+    return ret;
+} // flush
+
+
+
+int FDSink::drain(void)
+{
+    if (m_fail) { return -1; }
+
+    // keep the full batch, write them all when no block is free
+    m_iovs.push_back({m_bgn, m_used});
+    m_total += m_used, m_used = 0;
+    if ((m_iovs.size() == m_iov_cap) && (writeBatches() < 0)) { return -1; }
+
+    uint32_t bi = m_iovs.size();
+    if (bi == m_blocks.size())
+    {   m_blocks.emplace_back((char*)steedPoolAlloc(m_size, false));   }
+    m_bgn = m_blocks[bi];
+    return 0;
+} // drain
+
+
+
+int FDSink::writeBatches(void)
+{
+    struct iovec *iov = m_iovs.data();
+    int           num = m_iovs.size();
+    while (num > 0)
+    {
+        ssize_t wt = ::writev(m_fd, iov, num);
+        if (wt < 0)
+        {
+            if (errno == EINTR) { continue; }
+            printf("FDSink: writev fd[%d] got errno[%d]!\n", m_fd, errno);
+            m_iovs.clear();
+            return fail();
+        } // if
+
+        // skip the written batches, then the written part of the next
+        while ((num > 0) && (uint64_t(wt) >= iov->iov_len))
+        {   wt -= iov->iov_len; ++iov, --num;   }
+        if (num > 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + wt;
+            iov->iov_len -= wt;
+        } // if
+    } // while
+
+    m_iovs.clear();
+    return 0;
+} // writeBatches
+
+
+
+CallbackSink::CallbackSink(Callback cb, void *arg, uint64_t size) :
+    m_cb(cb), m_arg(arg)
+{
+    m_cap = (size == 0) ? s_batch_size : size;
+    m_bgn = new char[m_cap];
+} // ctor
+
+
+
+CallbackSink::~CallbackSink(void)
+{
+    flush();
+
+    delete [] m_bgn;
+    m_bgn = nullptr;
+    m_cb  = nullptr;
+    m_arg = nullptr;
+} // dtor
+
+
+
+int CallbackSink::drain(void)
+{
+    if (m_fail) { return -1; }
+    if (m_used == 0) { return 0; }
+
+    if (m_cb(m_bgn, m_used, m_arg) < 0)
+    {
+        puts("CallbackSink: callback stopped the output!");
+        return fail();
+    } // if
+
+    m_total += m_used, m_used = 0;
+    return 0;
+} // drain
+
+
+
+MemorySink::MemorySink(uint64_t cap)
+{
+    m_cap = (cap == 0) ? 4096 : cap;
+    m_bgn = new char[m_cap];
+} // ctor
+
+
+
+char *MemorySink::release(uint64_t &len)
+{
+    if ((m_used == m_cap) && (drain() < 0)) { return nullptr; }
+
+    char *data = m_bgn;
+    data[m_used] = '\0';
+    len   = m_used;
+
+    m_bgn = nullptr;
+    m_cap = m_used = 0;
+    return data;
+} // release
+
+
+
+int MemorySink::drain(void)
+{
+    uint64_t cap = (m_cap == 0) ? 4096 : m_cap * 2;
+    char    *buf = new char[cap];
+    if (m_used > 0) { memcpy(buf, m_bgn, m_used); }
+
+    delete [] m_bgn;
+    m_bgn = buf;
+    m_cap = cap;
+    return 0;
+} // drain
+
+
+
+StreamSink::StreamSink(uint64_t size)
+{
+    m_cap = (size == 0) ? s_batch_size : size;
+    m_bgn = new char[m_cap];
+} // ctor
+
+
+
+StreamSink::~StreamSink(void)
+{
+    flush();
+
+    delete [] m_bgn;
+    m_bgn = nullptr;
+    m_os  = nullptr;
+} // dtor
+
+
+
+int StreamSink::drain(void)
+{
+    if (m_fail) { return -1; }
+    if ((m_used == 0) || (m_os == nullptr)) { m_used = 0; return 0; }
+
+    if (!m_os->write(m_bgn, m_used))
+    {
+        puts("StreamSink: write to ostream failed!");
+        return fail();
+    } // if
+
+    m_total += m_used, m_used = 0;
+    return 0;
+} // drain
+
+
+
+} // namespace steed
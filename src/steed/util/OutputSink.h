@@ -0,0 +1,256 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file OutputSink.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   OutputSink buffers output text and drains it by batches
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace steed {
+
+using std::string;
+using std::vector;
+using std::ostream;
+
+
+/**
+ * OutputSink:
+ *   text is appended to the batch buffer in place, the buffer is drained
+ *   by the sub class when it is full or flushed. The sink fails at the
+ *   first drain error, and all following writes are dropped.
+ */
+class OutputSink {
+protected:
+    char     *m_bgn  {nullptr}; /**< batch buffer begin    */
+    uint64_t  m_cap  {0};       /**< batch buffer capacity */
+    uint64_t  m_used {0};       /**< batch buffer used     */
+    uint64_t  m_total{0};       /**< drained bytes         */
+    bool      m_fail {false};   /**< drain failed flag     */
+
+public:
+    static const uint64_t s_batch_size{1UL << 20}; /**< default batch size */
+
+public:
+    OutputSink (void) = default;
+    virtual ~OutputSink(void) = default;
+    OutputSink (const OutputSink&) = delete;
+
+public:
+    bool     good    (void) { return !m_fail; }
+    uint64_t getTotal(void) { return m_total + m_used; } /**< bytes written */
+
+    void put  (char c)
+    {
+        if ((m_used == m_cap) && (drain() < 0)) { return; }
+        m_bgn[m_used++] = c;
+    } // put
+
+    int  write(const char   *s) { return write(s, strlen(s)); }
+    int  write(const string &s) { return write(s.data(), s.size()); }
+
+    /**
+     * write content to the batch buffer, drain it when it is full
+     * @param s      content begin
+     * @param len    content length
+     * @return 0 success; <0 failed
+     */
+    int  write(const void *s, uint64_t len);
+
+    /**
+     * get space to write in place, commit the used bytes after writing
+     * @param len    bytes needed
+     * @return space begin; nullptr if len is over the batch or failed
+     */
+    char *reserve(uint64_t len);
+    void  commit (uint64_t len) { m_used += len; }
+
+    /**
+     * drain all content written
+     * @return 0 success; <0 failed
+     */
+    virtual int flush(void) { return drain(); }
+
+protected:
+    /**
+     * output [m_bgn, m_bgn + m_used) and reset m_used to 0,
+     *   the sub class may change the batch buffer
+     * @return 0 success; <0 failed
+     */
+    virtual int drain(void) = 0;
+
+    /** mark the sink failed and drop the content */
+    int  fail (void) { m_fail = true; m_used = 0; return -1; }
+}; // OutputSink
+
+
+
+/**
+ * FDSink: write to a file descriptor.
+ *   The batch buffers are aligned blocks, the full ones are kept and
+ *   written together by one writev, so each system call moves m_iov_cap
+ *   batches. The fd is owned by caller.
+ */
+class FDSink : public OutputSink {
+protected:
+    int                 m_fd     {-1}; /**< fd to write           */
+    uint64_t            m_size   {0};  /**< each batch size       */
+    uint32_t            m_iov_cap{0};  /**< batches for a writev  */
+    vector<char*>       m_blocks {};   /**< all batch buffers     */
+    vector<struct iovec> m_iovs  {};   /**< full batches to write */
+
+public:
+    /**
+     * ctor
+     * @param fd     file descriptor to write
+     * @param size   each batch buffer size
+     * @param iov    full batches written by one writev
+     */
+    FDSink (int fd, uint64_t size = s_batch_size, uint32_t iov = 8);
+    ~FDSink(void);
+
+public:
+    int flush(void) override;
+
+protected:
+    int drain(void) override;
+
+    /** writev all full batches, continue after partial writes */
+    int writeBatches(void);
+}; // FDSink
+
+
+
+/**
+ * CallbackSink: pass each batch to a caller-supplied callback
+ */
+class CallbackSink : public OutputSink {
+public:
+    /**
+     * callback to consume a batch
+     * @return 0 continue; <0 stop the output
+     */
+    typedef int (*Callback)(const char *data, uint64_t len, void *arg);
+
+protected:
+    Callback  m_cb  {nullptr}; /**< batch callback   */
+    void     *m_arg {nullptr}; /**< callback arg     */
+
+public:
+    CallbackSink (Callback cb, void *arg, uint64_t size = s_batch_size);
+    ~CallbackSink(void);
+
+protected:
+    int drain(void) override;
+}; // CallbackSink
+
+
+
+/**
+ * MemorySink: keep all content in a growable buffer, nothing is drained.
+ *   release() hands the '\0' ended buffer to the caller, who frees it
+ *   by delete [].
+ */
+class MemorySink : public OutputSink {
+public:
+    MemorySink (uint64_t cap = 4096);
+    ~MemorySink(void) { delete [] m_bgn; m_bgn = nullptr; }
+
+public:
+    const char *getData(void) { return m_bgn;  }
+    uint64_t    size   (void) { return m_used; }
+
+    /**
+     * release the content buffer, the sink is empty after it
+     * @param len    content length without '\0'
+     * @return '\0' ended content, freed by delete []
+     */
+    char *release(uint64_t &len);
+
+    int flush(void) override { return good() ? 0 : -1; }
+
+protected:
+    /** grow the buffer to keep the content */
+    int drain(void) override;
+}; // MemorySink
+
+
+
+/**
+ * StreamSink: write the batches to an ostream, used for ostream callers
+ */
+class StreamSink : public OutputSink {
+protected:
+    ostream  *m_os {nullptr}; /**< stream to write */
+
+public:
+    StreamSink (uint64_t size = 64UL << 10);
+    ~StreamSink(void);
+
+public:
+    /** set the stream, the content of the old one is flushed */
+    void setStream(ostream *os)
+    { if (os != m_os) { flush(); m_os = os; } }
+
+protected:
+    int drain(void) override;
+}; // StreamSink
+
+
+
+
+
+inline
+int OutputSink::write(const void *s, uint64_t len)
+{
+    const char *src = (const char*)s;
+    while (len > 0)
+    {
+        if ((m_used == m_cap) && (drain() < 0)) { return -1; }
+
+        uint64_t n = m_cap - m_used;
+        n = (n < len) ? n : len;
+        memcpy(m_bgn + m_used, src, n);
+        m_used += n, src += n, len -= n;
+    } // while
+    return 0;
+} // write
+
+
+
+inline
+char *OutputSink::reserve(uint64_t len)
+{
+    if (len > m_cap)                               { return nullptr; }
+    if ((m_cap - m_used < len) && (drain() < 0))   { return nullptr; }
+    return (m_cap - m_used < len) ? nullptr : (m_bgn + m_used);
+} // reserve
+
+} // namespace steed
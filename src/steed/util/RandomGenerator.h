@@ -41,12 +41,28 @@ public:
     ~RandomGenerator(void)  = default;
     RandomGenerator (uint64_t min, uint64_t max): 
         m_dev(), m_eng(m_dev()), m_dis(min, max) {}
+
+    /** seeded generator: the same seed generates the same sequence */
+    RandomGenerator (uint64_t min, uint64_t max, uint64_t seed): 
+        m_dev(), m_eng(seed), m_dis(min, max) {}
    
 public:
     /**
      * generate a random value
      */ 
     uint64_t generate(void) { return m_dis(m_eng); }
+
+    /**
+     * generate a random value in [min, max] using the same engine
+     */ 
+    uint64_t generate(uint64_t min, uint64_t max)
+    { return std::uniform_int_distribution<uint64_t>(min, max)(m_eng); }
+
+    /**
+     * generate a random real value in [0, 1)
+     */ 
+    double   generateReal(void)
+    { return std::generate_canonical<double, 53>(m_eng); }
 }; // RandomGenerator
 
 } // steed
\ No newline at end of file
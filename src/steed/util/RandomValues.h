@@ -39,6 +39,7 @@ protected:
 
 public:
     RandomValues (uint64_t num, uint64_t min, uint64_t max);
+    RandomValues (uint64_t num, uint64_t min, uint64_t max, uint64_t seed);
     ~RandomValues(void) = default; 
 
 public:
@@ -58,4 +59,17 @@ inline RandomValues::
     m_values.erase( unique(m_values.begin(), m_values.end()), m_values.end() );
 } // ctor 
 
+
+
+inline RandomValues::
+    RandomValues (uint64_t num, uint64_t min, uint64_t max, uint64_t seed) : m_values(num)
+{
+    RandomGenerator gen(min, max, seed); 
+    for (auto & v : m_values)
+    {   v = gen.generate();   } 
+    
+    std::sort(m_values.begin(), m_values.end());
+    m_values.erase( unique(m_values.begin(), m_values.end()), m_values.end() );
+} // ctor 
+
 } // namespace 
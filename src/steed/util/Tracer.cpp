@@ -0,0 +1,238 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Tracer.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   Tracer functions definitions
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "Logger.h"
+#include "Tracer.h"
+
+namespace steed {
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+const char *Tracer::s_event_name[Tracer::event_max] = {
+    "batch_read", "parse", "column_write", "cab_flush", "cab_load",
+    "compress", "decompress", "assemble_batch", "io_read", "io_write"
+};
+
+
+namespace {
+
+/** one complete trace event */
+class TraceRecord {
+public:
+    uint64_t  m_bgn{0};  /**< begin ns    */
+    uint64_t  m_dur{0};  /**< duration ns */
+    uint32_t  m_tid{0};  /**< thread id   */
+    uint32_t  m_id {0};  /**< event id    */
+}; // TraceRecord
+
+
+/** trace events of one thread, only the owner thread appends */
+class TraceBlock {
+public:
+    std::vector<TraceRecord> m_recds  {};  /**< buffered events */
+    uint32_t                 m_tid    {0}; /**< kernel tid      */
+}; // TraceBlock
+
+
+/** all living thread blocks and the events of exited threads */
+class TraceRegistry {
+public:
+    std::mutex                 m_mutex  {};
+    std::vector<TraceBlock*>   m_blocks {};
+    std::vector<TraceRecord>   m_retired{};
+    string                     m_file   {};         /**< output file    */
+    uint32_t                   m_format {Tracer::json}; /**< output format */
+    uint64_t                   m_bgn    {0};        /**< start ns       */
+    uint64_t                   m_dropped{0};        /**< dropped events */
+
+public:
+    static TraceRegistry &get(void)
+    {
+        static TraceRegistry *reg = new TraceRegistry(); // never destroyed
+        return *reg;
+    } // get
+}; // TraceRegistry
+
+
+/** thread local holder: register on first use and retire at thread exit */
+class TraceHolder {
+public:
+    TraceBlock  m_block{};
+
+public:
+    TraceHolder(void)
+    {
+        m_block.m_tid = uint32_t(syscall(SYS_gettid));
+        TraceRegistry &reg = TraceRegistry::get();
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        reg.m_blocks.emplace_back(&m_block);
+    } // ctor
+
+    ~TraceHolder(void)
+    {
+        TraceRegistry &reg = TraceRegistry::get();
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        auto &rv = m_block.m_recds;
+        reg.m_retired.insert(reg.m_retired.end(), rv.begin(), rv.end());
+        auto &bv = reg.m_blocks;
+        bv.erase(std::remove(bv.begin(), bv.end(), &m_block), bv.end());
+    } // dtor
+}; // TraceHolder
+
+
+TraceBlock &localBlock(void)
+{
+    static thread_local TraceHolder holder;
+    return holder.m_block;
+} // localBlock
+
+
+int writeJSON(FILE *fp, const std::vector<TraceRecord> &recds, uint64_t bgn)
+{
+    int pid = int(getpid());
+    fprintf(fp, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    for (uint64_t i = 0; i < recds.size(); ++i)
+    {
+        const TraceRecord &r = recds[i];
+        uint64_t ts = (r.m_bgn > bgn) ? (r.m_bgn - bgn) : 0;
+        fprintf(fp, "%s{\"name\": \"%s\", \"cat\": \"steed\", \"ph\": \"X\", "
+            "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %u}", (i ? ",\n" : ""),
+            Tracer::s_event_name[r.m_id], ts / 1e3, r.m_dur / 1e3, pid, r.m_tid);
+    } // for i
+    fprintf(fp, "\n]}\n");
+    return ferror(fp) ? -1 : 0;
+} // writeJSON
+
+
+int writeBinary(FILE *fp, const std::vector<TraceRecord> &recds)
+{
+    uint32_t head[2] = {1, Tracer::event_max}; // version, name number
+    fwrite("STEEDTRC", 8, 1, fp);
+    fwrite(head, sizeof(head), 1, fp);
+    for (uint32_t i = 0; i < Tracer::event_max; ++i)
+    {   fwrite(Tracer::s_event_name[i], strlen(Tracer::s_event_name[i]) + 1, 1, fp);   }
+
+    if (!recds.empty())
+    {   fwrite(recds.data(), sizeof(TraceRecord), recds.size(), fp);   }
+    return ferror(fp) ? -1 : 0;
+} // writeBinary
+
+} // namespace
+
+
+
+int Tracer::start(const string &fn, const string &fmt)
+{
+    if ((fmt != "json") && (fmt != "binary"))
+    {
+        STEED_LOG(error, "Tracer: unknown format [%s]!", fmt.c_str());
+        return -1;
+    } // if
+
+    TraceRegistry &reg = TraceRegistry::get();
+    {
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        for (auto b : reg.m_blocks) { b->m_recds.clear(); }
+        reg.m_retired.clear();
+        reg.m_file    = fn;
+        reg.m_format  = (fmt == "json") ? json : binary;
+        reg.m_bgn     = now();
+        reg.m_dropped = 0;
+    }
+
+    s_enabled.store(true, std::memory_order_relaxed);
+    return 0;
+} // start
+
+
+
+int64_t Tracer::stop(void)
+{
+    if (!enabled()) { return 0; }
+    s_enabled.store(false, std::memory_order_relaxed);
+
+    std::vector<TraceRecord> all;
+    TraceRegistry &reg = TraceRegistry::get();
+    std::lock_guard<std::mutex> lk(reg.m_mutex);
+    all.swap(reg.m_retired);
+    for (auto b : reg.m_blocks)
+    {
+        all.insert(all.end(), b->m_recds.begin(), b->m_recds.end());
+        std::vector<TraceRecord>().swap(b->m_recds);
+    } // for b
+
+    std::sort(all.begin(), all.end(),
+        [](const TraceRecord &a, const TraceRecord &b) { return a.m_bgn < b.m_bgn; });
+
+    FILE *fp = fopen(reg.m_file.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        STEED_LOG(error, "Tracer: open [%s] failed!", reg.m_file.c_str());
+        return -1;
+    } // if
+
+    int ws = (reg.m_format == json) ? writeJSON(fp, all, reg.m_bgn) : writeBinary(fp, all);
+    if ((fclose(fp) != 0) || (ws < 0))
+    {
+        STEED_LOG(error, "Tracer: write [%s] failed!", reg.m_file.c_str());
+        return -1;
+    } // if
+
+    if (reg.m_dropped > 0)
+    {   STEED_LOG(warn, "Tracer: %lu events dropped by the thread cap!", reg.m_dropped);   }
+    return int64_t(all.size());
+} // stop
+
+
+
+void Tracer::addLocal(Event e, uint64_t bgn, uint64_t dur)
+{
+    TraceBlock &b = localBlock();
+    if (b.m_recds.size() >= s_thread_cap)
+    {
+        TraceRegistry &reg = TraceRegistry::get();
+        std::lock_guard<std::mutex> lk(reg.m_mutex);
+        ++reg.m_dropped;
+        return;
+    } // if
+
+    b.m_recds.emplace_back();
+    TraceRecord &r = b.m_recds.back();
+    r.m_bgn = bgn;
+    r.m_dur = dur;
+    r.m_tid = b.m_tid;
+    r.m_id  = uint32_t(e);
+} // addLocal
+
+} // namespace steed
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Tracer.h
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   scoped trace events output as Chrome trace JSON or compact binary
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include <chrono>
+
+namespace steed {
+
+using std::string;
+
+
+/**
+ * Tracer buffers complete events (begin, duration, thread) per thread
+ *   and writes all of them when stopped:
+ *   json  : Chrome trace event format, open in chrome://tracing or Perfetto
+ *   binary: "STEEDTRC" | uint32 version | uint32 name # | names ('\0' ended)
+ *           | records of {uint64 bgn_ns, uint64 dur_ns, uint32 tid, uint32 id}
+ *   When stopped, each trace point costs one branch.
+ */
+class Tracer {
+public:
+    /** trace event id */
+    enum Event {
+        batch_read     = 0, /**< read text records in batch   */
+        parse          = 1, /**< parse text to JSONBinTree    */
+        column_write   = 2, /**< generate and write items     */
+        cab_flush      = 3, /**< flush a CAB to file          */
+        cab_load       = 4, /**< load a CAB from file         */
+        compress       = 5, /**< compress CAB content         */
+        decompress     = 6, /**< decompress CAB content       */
+        assemble_batch = 7, /**< assemble a record batch      */
+        io_read        = 8, /**< file read system call        */
+        io_write       = 9, /**< file write system call       */
+        event_max      = 10,
+    };
+
+    /** output format */
+    enum Format {
+        json   = 0,
+        binary = 1,
+    };
+
+    static const char *s_event_name[event_max]; /**< event names */
+
+    /** max buffered event number of each thread, the rest are dropped */
+    static const uint64_t s_thread_cap = (1 << 22);
+
+protected:
+    static std::atomic<bool> s_enabled; /**< tracing or not */
+
+private:
+    Tracer (void) = delete;
+    ~Tracer(void) = delete;
+
+public:
+    static bool enabled(void) { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** steady clock now in ns */
+    static uint64_t now(void)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    } // now
+
+    /**
+     * start tracing, events buffered before are cleared
+     * @param fn     output file name
+     * @param fmt    format name: json or binary
+     * @return 0 success; <0 failed
+     */
+    static int  start(const string &fn, const string &fmt);
+
+    /**
+     * stop tracing and write the buffered events of all threads
+     * @return written event number; <0 failed
+     */
+    static int64_t stop(void);
+
+    /**
+     * add a complete event of current thread
+     * @param e      event id
+     * @param bgn    begin ns got by now()
+     * @param dur    duration ns
+     */
+    static void add(Event e, uint64_t bgn, uint64_t dur)
+    { if (enabled()) { addLocal(e, bgn, dur); } }
+
+protected:
+    static void addLocal(Event e, uint64_t bgn, uint64_t dur);
+}; // Tracer
+
+
+
+/** scoped trace event: added when it is destroyed */
+class TraceScope {
+protected:
+    Tracer::Event  m_ev ;     /**< event id             */
+    uint64_t       m_bgn{0};  /**< begin ns, 0 disabled */
+
+public:
+    TraceScope (Tracer::Event e) : m_ev(e)
+    { if (Tracer::enabled()) { m_bgn = Tracer::now(); } }
+
+    ~TraceScope(void)
+    { if (m_bgn != 0) { Tracer::add(m_ev, m_bgn, Tracer::now() - m_bgn); } }
+
+    TraceScope (const TraceScope&) = delete;
+}; // TraceScope
+
+} // namespace steed
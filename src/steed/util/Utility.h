@@ -79,7 +79,7 @@ uint32_t calcBytesUsed (uint32_t bit_num)
  * @return aligned size
  */
 inline
-uint32_t calcAlignSize (uint32_t num, uint32_t align)
+uint64_t calcAlignSize (uint64_t num, uint64_t align)
 { return (num + align - 1) / align * align; }
 
 /**
@@ -89,7 +89,7 @@ uint32_t calcAlignSize (uint32_t num, uint32_t align)
  * @return aligned size
  */
 inline
-uint32_t calcSize2Align(uint32_t num, uint32_t align)
+uint64_t calcSize2Align(uint64_t num, uint64_t align)
 { return calcAlignSize (num, align) - num; }
 
 /**
@@ -99,7 +99,7 @@ uint32_t calcSize2Align(uint32_t num, uint32_t align)
  * @return aligned begin
  */
 inline
-uint32_t calcAlignBegin(uint32_t num, uint32_t align)
+uint64_t calcAlignBegin(uint64_t num, uint64_t align)
 { return (num / align * align); }
 
 
@@ -0,0 +1,690 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Bench.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   steed benchmark suite:
+ *     end-to-end ingest, scan and assembly and micro benchmarks,
+ *     all run on generated data and the results are output as JSON
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include "CLI/CLI.hpp"
+
+#include "steed.h"
+#include "BitVector.h"
+#include "BinaryValueArray.h"
+#include "CompressorFactory.h"
+#include "JSONBinTree.h"
+#include "JSONGenerator.h"
+#include "JSONRecordNaiveParser.h"
+
+
+namespace steed {
+
+using std::string;
+using std::vector;
+
+
+/** benchmark options */
+class BenchOption {
+public:
+    uint64_t    m_recd_num{100000};    /**< generated record number  */
+    uint64_t    m_seed    {20230101};  /**< data generator seed      */
+    uint32_t    m_repeat  {3};         /**< repeat times, best kept  */
+    uint32_t    m_cab_recd{1024};      /**< records in a CAB         */
+    string      m_dir     {"./steed_bench"};      /**< work directory  */
+    string      m_conf    {};                     /**< user conf file  */
+    string      m_output  {"steed_bench.json"};   /**< result file     */
+    string      m_only    {};                     /**< name filter     */
+    string      m_shape   {"nested"};             /**< data shape      */
+}; // BenchOption
+
+
+/** one benchmark result */
+class BenchResult {
+public:
+    string      m_name {};      /**< benchmark name       */
+    double      m_secs {0};     /**< best elapsed seconds */
+    uint64_t    m_items{0};     /**< processed item num   */
+    uint64_t    m_bytes{0};     /**< processed bytes      */
+}; // BenchResult
+
+
+/** sink callback dropping the output batches */
+static int dropBatch(const char *, uint64_t, void *) { return 0; }
+
+
+/** steady timer in seconds */
+class BenchTimer {
+protected:
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point   m_bgn{Clock::now()};  /**< start time point */
+
+public:
+    void   restart(void) { m_bgn = Clock::now(); }
+    double elapsed(void)
+    { return std::chrono::duration<double>(Clock::now() - m_bgn).count(); }
+}; // BenchTimer
+
+
+
+class Bench {
+protected:
+    BenchOption         &m_opt;             /**< benchmark options   */
+    vector<BenchResult>  m_res  {};         /**< benchmark results   */
+    string               m_json {};         /**< generated NDJSON    */
+    vector<uint64_t>     m_recd_off{};      /**< record begin offset */
+    vector<string>       m_cols {};         /**< all leaf columns    */
+    string               m_db   {"steed_bench"};  /**< bench database */
+    string               m_tb   {"recd"};         /**< bench table    */
+    string               m_jpath{};         /**< NDJSON file path    */
+
+public:
+    Bench (BenchOption &opt) : m_opt(opt) {}
+    ~Bench(void) = default;
+
+public:
+    /**
+     * prepare the work dir, config and generated data
+     * @return 0 success; <0 failed
+     */
+    int  init  (void);
+
+    /**
+     * run all selected benchmarks
+     * @return 0 success; <0 failed
+     */
+    int  run   (void);
+
+    /**
+     * output results as JSON
+     * @return 0 success; <0 failed
+     */
+    int  output(void);
+
+    /** drop the bench database and uninit steed */
+    void uninit(void);
+
+protected:
+    bool selected(const string &name)
+    { return m_opt.m_only.empty() || (name.find(m_opt.m_only) != string::npos); }
+
+    void record(const string &name, double secs, uint64_t items, uint64_t bytes)
+    {
+        m_res.emplace_back();
+        BenchResult &r = m_res.back();
+        r.m_name  = name ;
+        r.m_secs  = secs ;
+        r.m_items = items;
+        r.m_bytes = bytes;
+        fprintf(stderr, "Bench: %-28s %10.4f s %12lu items %12lu bytes\n",
+            name.c_str(), secs, items, bytes);
+    } // record
+
+    void generate   (void);
+    int  loadColumns(void);
+
+protected: // end-to-end benchmarks
+    int  benchIngest  (void);
+    int  benchScan    (const string &name, const vector<string> &cols);
+    int  benchAssemble(void);
+
+protected: // micro benchmarks
+    int  benchNaiveParser(void);
+    int  benchBitVector  (void);
+    int  benchValueArray (void);
+    int  benchCompressor (void);
+}; // Bench
+
+
+
+void Bench::generate(void)
+{
+    JSONGenOption gopt;
+    if      (m_opt.m_shape == "telemetry") { gopt = JSONGenOption::telemetry(m_opt.m_seed); }
+    else if (m_opt.m_shape == "eventlog" ) { gopt = JSONGenOption::eventLog (m_opt.m_seed); }
+    else                                   { gopt.m_seed = m_opt.m_seed; }
+
+    JSONGenerator gen(gopt);
+    m_json.clear();
+    m_recd_off.clear();
+    for (uint64_t ri = 0; ri < m_opt.m_recd_num; ++ri)
+    {
+        m_recd_off.emplace_back(m_json.size());
+        gen.generate(m_json);
+        m_json.append(1, '\n');
+    } // for ri
+} // generate
+
+
+
+int Bench::init(void)
+{
+    if (!Utility::checkFileExisted(m_opt.m_dir) && (Utility::makeDir(m_opt.m_dir) < 0))
+    {
+        printf("Bench: makeDir [%s] failed!\n", m_opt.m_dir.c_str());
+        return -1;
+    } // if
+
+    // use a private store base unless the config file is given
+    string conf(m_opt.m_conf);
+    if (conf.empty())
+    {
+        conf = m_opt.m_dir + "/steed_bench.conf";
+        std::ofstream ofs(conf);
+        if (!ofs.is_open())
+        {
+            printf("Bench: cannot open [%s]!\n", conf.c_str());
+            return -1;
+        } // if
+
+        ofs << "store_base = " << m_opt.m_dir << "/store\n"
+            << "data_dir = data\n"
+            << "schema_dir = schema\n"
+            << "cab_recd_num = " << m_opt.m_cab_recd << "\n";
+    } // if
+
+    steed::init(conf);
+
+    generate();
+    m_jpath = m_opt.m_dir + "/steed_bench.json";
+    std::ofstream jfs(m_jpath);
+    if (!jfs.is_open())
+    {
+        printf("Bench: cannot open [%s]!\n", m_jpath.c_str());
+        return -1;
+    } // if
+    jfs.write(m_json.data(), m_json.size());
+    jfs.close();
+
+    return 0;
+} // init
+
+
+
+void Bench::uninit(void)
+{
+    dropTable(m_db, m_tb);
+    dropDatabase(m_db);
+    steed::uninit();
+} // uninit
+
+
+
+int Bench::loadColumns(void)
+{
+    SchemaTree *tree = nullptr;
+    if (SchemaTreeMap::load(m_db, m_tb, tree) < 0)
+    {
+        printf("Bench: load SchemaTree failed!\n");
+        return -1;
+    } // if
+
+    m_cols.clear();
+    uint64_t nd_num = tree->getNodeNum();
+    for (uint64_t ni = 1; ni < nd_num; ++ni)
+    {
+        if (!tree->isLeaf(ni)) { continue; }
+
+        SchemaPath sp;
+        tree->getPath(ni, sp);
+
+        string name;
+        tree->appendPathName(name, sp);
+        m_cols.emplace_back(name);
+    } // for ni
+
+    return m_cols.empty() ? -1 : 0;
+} // loadColumns
+
+
+
+int Bench::benchIngest(void)
+{
+    double best = 0;
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        dropTable  (m_db, m_tb);
+        createDatabase(m_db);
+        createTable(m_db, m_tb);
+        SchemaTreeMap::destory();
+
+        std::ifstream ifs(m_jpath);
+        std::istream *is = &ifs;
+
+        BenchTimer timer;
+        ColumnParser *cp = new ColumnParser();
+        if (cp->init(m_db, m_tb, is) < 0)
+        {
+            printf("Bench: ColumnParser init failed!\n");
+            delete cp; cp = nullptr;
+            return -1;
+        } // if
+
+        int status = 0;
+        while ((status = cp->parseOne()) > 0) {}
+        delete cp; cp = nullptr; // flush all CABs
+        double secs = timer.elapsed();
+
+        if (status < 0)
+        {
+            printf("Bench: ColumnParser parseOne failed!\n");
+            return -1;
+        } // if
+
+        best = (ri == 0) ? secs : std::min(best, secs);
+    } // for ri
+
+    record("e2e.ingest", best, m_opt.m_recd_num, m_json.size());
+    SchemaTreeMap::destory();
+    return loadColumns();
+} // benchIngest
+
+
+
+int Bench::benchScan(const string &name, const vector<string> &cols)
+{
+    double   best = 0;
+    uint64_t rnum = 0;
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        BenchTimer timer;
+        ColumnAssembler *ca = new ColumnAssembler();
+        if (ca->init(m_db, m_tb, cols) < 0)
+        {
+            printf("Bench: ColumnAssembler init failed!\n");
+            delete ca; ca = nullptr;
+            return -1;
+        } // if
+
+        rnum = 0;
+        char *rbgn = nullptr;
+        while (ca->getNext(rbgn) > 0) { ++rnum; }
+        delete ca; ca = nullptr;
+
+        double secs = timer.elapsed();
+        best = (ri == 0) ? secs : std::min(best, secs);
+    } // for ri
+
+    record(name, best, rnum, 0);
+    return 0;
+} // benchScan
+
+
+
+int Bench::benchAssemble(void)
+{
+    double   best = 0, best_out = 0;
+    uint64_t rnum = 0, bytes = 0;
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        CallbackSink sink(dropBatch, nullptr, g_config.m_out_batch_size);
+
+        BenchTimer timer, out_timer;
+        ColumnAssembler *ca = new ColumnAssembler();
+        if (ca->init(m_db, m_tb, m_cols) < 0)
+        {
+            printf("Bench: ColumnAssembler init failed!\n");
+            delete ca; ca = nullptr;
+            return -1;
+        } // if
+
+        rnum = 0;
+        double out_secs = 0;
+        char *rbgn = nullptr;
+        RecordOutput ro( ca->getSchemaTree() );
+        while (ca->getNext(rbgn) > 0)
+        {
+            out_timer.restart();
+            ro.outJSON2Sink(&sink, rbgn);
+            out_secs += out_timer.elapsed();
+            ++rnum;
+        } // while
+        delete ca; ca = nullptr;
+
+        double secs = timer.elapsed();
+        best     = (ri == 0) ? secs     : std::min(best, secs);
+        best_out = (ri == 0) ? out_secs : std::min(best_out, out_secs);
+        bytes    = sink.getTotal();
+    } // for ri
+
+    record("e2e.assemble"      , best    , rnum, bytes);
+    record("micro.record_output", best_out, rnum, bytes);
+    return 0;
+} // benchAssemble
+
+
+
+int Bench::benchNaiveParser(void)
+{
+    double best = 0;
+    vector<char> text(m_json.begin(), m_json.end());
+    text.emplace_back('\0');
+
+    JSONBinTree      *jtree = new JSONBinTree();
+    JSONRecordParser *jpars = new JSONRecordNaiveParser();
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        // the parser may change the content in place
+        memcpy(text.data(), m_json.data(), m_json.size());
+
+        BenchTimer timer;
+        for (auto off : m_recd_off)
+        {
+            char *c = text.data() + off;
+            jtree->clear();
+            if (jpars->parse(jtree, c) < 0)
+            {
+                printf("Bench: JSONRecordNaiveParser parse failed!\n");
+                delete jpars; jpars = nullptr;
+                delete jtree; jtree = nullptr;
+                return -1;
+            } // if
+        } // for off
+
+        double secs = timer.elapsed();
+        best = (ri == 0) ? secs : std::min(best, secs);
+    } // for ri
+
+    delete jpars; jpars = nullptr;
+    delete jtree; jtree = nullptr;
+
+    record("micro.naive_parser", best, m_recd_off.size(), m_json.size());
+    return 0;
+} // benchNaiveParser
+
+
+
+int Bench::benchBitVector(void)
+{
+    const uint64_t num  = m_opt.m_recd_num * 8;
+    const uint64_t msk  = 3;  // repetition and definition bits
+    const uint64_t len  = Utility::calcAlignSize(num * msk / 8 + 8, 8);
+    vector<uint64_t> cont(len / 8, 0);
+
+    double   best_app = 0, best_get = 0;
+    uint64_t sum = 0;
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        BitVector bv(msk);
+        bv.init2write(len, cont.data());
+
+        BenchTimer timer;
+        for (uint64_t i = 0; i < num; ++i)
+        {   bv.append(i & 7);   }
+        double app = timer.elapsed();
+
+        timer.restart();
+        for (uint64_t i = 0; i < num; ++i)
+        {   sum += bv.get(i);   }
+        double get = timer.elapsed();
+
+        best_app = (ri == 0) ? app : std::min(best_app, app);
+        best_get = (ri == 0) ? get : std::min(best_get, get);
+    } // for ri
+
+    if (sum == uint64_t(-1)) { puts("");  } // keep the get loop
+    record("micro.bitvector.append", best_app, num, len);
+    record("micro.bitvector.get"   , best_get, num, len);
+    return 0;
+} // benchBitVector
+
+
+
+int Bench::benchValueArray(void)
+{
+    const uint64_t num = m_opt.m_recd_num;
+    Buffer buf(4096);
+
+    // fixed length values
+    DataType *dt  = DataType::getDataType(DataType::s_type_int_64);
+    BinaryValueArray *bva = BinaryValueArray::create(&buf, dt);
+    uint64_t  len = bva->getFixSize(num);
+    vector<uint64_t> cont(len / sizeof(uint64_t) + 1, 0);
+
+    double   best_wr = 0, best_rd = 0, best_str = 0;
+    uint64_t sum = 0;
+    char     txt[32] = {0};
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        bva->uninit();
+        bva->init2write(len, cont.data());
+
+        const void *bin = nullptr;
+        BenchTimer timer;
+        for (uint64_t i = 0; i < num; ++i)
+        {
+            snprintf(txt, sizeof(txt), "%lu", i * 7919);
+            bva->writeText(txt, bin);
+        } // for i
+        double wr = timer.elapsed();
+
+        timer.restart();
+        for (uint64_t i = 0; i < num; ++i)
+        {
+            const void *v = bva->read(i);
+            sum += (v == nullptr) ? 0 : *(const uint64_t*)v;
+        } // for i
+        double rd = timer.elapsed();
+
+        best_wr = (ri == 0) ? wr : std::min(best_wr, wr);
+        best_rd = (ri == 0) ? rd : std::min(best_rd, rd);
+    } // for ri
+    delete bva; bva = nullptr;
+
+    // variable length values
+    DataType *st = DataType::getDataType(DataType::s_type_string);
+    uint64_t  slen = num * sizeof(uint64_t);
+    vector<uint64_t> offs(num, 0);
+    for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+    {
+        BinaryValueArray *sva = BinaryValueArray::create(&buf, st);
+        sva->init2write(slen, offs.data());
+
+        const void *bin = nullptr;
+        BenchTimer timer;
+        for (uint64_t i = 0; i < num; ++i)
+        {
+            snprintf(txt, sizeof(txt), "\"value_%lu\"", i % 4096);
+            sva->writeText(txt, bin);
+        } // for i
+        double str = timer.elapsed();
+        delete sva; sva = nullptr;
+
+        best_str = (ri == 0) ? str : std::min(best_str, str);
+    } // for ri
+
+    if (sum == uint64_t(-1)) { puts("");  } // keep the read loop
+    record("micro.value_array.write_int", best_wr , num, len);
+    record("micro.value_array.read_int" , best_rd , num, len);
+    record("micro.value_array.write_str", best_str, num, 0);
+    return 0;
+} // benchValueArray
+
+
+
+int Bench::benchCompressor(void)
+{
+    for (Compressor::Type type = Compressor::none;
+            type <= Compressor::lz4;
+            type = Compressor::Type(type + 1))
+    {
+        Compressor *cmp = CompressorFactory::create(type);
+        uint64_t org_use = m_json.size();
+        vector<char> org(m_json.begin(), m_json.end());
+        vector<char> bin(cmp->compressBound(org_use));
+        vector<char> dec(org_use);
+
+        double best_cmp = 0, best_dec = 0;
+        for (uint32_t ri = 0; ri < m_opt.m_repeat; ++ri)
+        {
+            uint64_t cmp_use = bin.size(), dec_use = dec.size();
+            BenchTimer timer;
+            if (cmp->compress(org.data(), org_use, bin.data(), cmp_use) <= 0)
+            {
+                printf("Bench: compress failed!\n");
+                delete cmp; cmp = nullptr;
+                return -1;
+            } // if
+            double c = timer.elapsed();
+
+            timer.restart();
+            if (cmp->decompress(bin.data(), cmp_use, dec.data(), dec_use) <= 0)
+            {
+                printf("Bench: decompress failed!\n");
+                delete cmp; cmp = nullptr;
+                return -1;
+            } // if
+            double d = timer.elapsed();
+
+            best_cmp = (ri == 0) ? c : std::min(best_cmp, c);
+            best_dec = (ri == 0) ? d : std::min(best_dec, d);
+        } // for ri
+
+        string name = (type == Compressor::none) ? "none" : "lz4";
+        record("micro.compress."   + name, best_cmp, 1, org_use);
+        record("micro.decompress." + name, best_dec, 1, org_use);
+        delete cmp; cmp = nullptr;
+    } // for type
+
+    return 0;
+} // benchCompressor
+
+
+
+int Bench::run(void)
+{
+    // scan and assembly read the ingested table
+    bool need_data = selected("e2e.ingest") || selected("e2e.scan.full") ||
+        selected("e2e.scan.project") || selected("e2e.assemble") ||
+        selected("micro.record_output");
+    if (need_data && (benchIngest() < 0))  { return -1; }
+
+    if (selected("e2e.scan.full"))
+    {
+        if (benchScan("e2e.scan.full", m_cols) < 0) { return -1; }
+    } // if
+
+    if (selected("e2e.scan.project"))
+    {
+        vector<string> proj(m_cols.begin(), m_cols.begin() + std::min(m_cols.size(), size_t(2)));
+        if (benchScan("e2e.scan.project", proj) < 0) { return -1; }
+    } // if
+
+    if (selected("e2e.assemble") || selected("micro.record_output"))
+    {
+        if (benchAssemble() < 0) { return -1; }
+    } // if
+
+    if (selected("micro.naive_parser") && (benchNaiveParser() < 0)) { return -1; }
+    if (selected("micro.bitvector")    && (benchBitVector  () < 0)) { return -1; }
+    if (selected("micro.value_array")  && (benchValueArray () < 0)) { return -1; }
+    if (selected("micro.compress")     && (benchCompressor () < 0)) { return -1; }
+
+    return 0;
+} // run
+
+
+
+int Bench::output(void)
+{
+    std::ofstream ofs;
+    std::ostream *os = &std::cout;
+    if (m_opt.m_output != "-")
+    {
+        ofs.open(m_opt.m_output);
+        if (!ofs.is_open())
+        {
+            printf("Bench: cannot open [%s]!\n", m_opt.m_output.c_str());
+            return -1;
+        } // if
+        os = &ofs;
+    } // if
+
+    char tmp[512] = {0};
+    snprintf(tmp, sizeof(tmp),
+        "{\n  \"bench\": \"steed\",\n  \"records\": %lu,\n  \"json_bytes\": %lu,\n"
+        "  \"shape\": \"%s\",\n  \"seed\": %lu,\n  \"repeat\": %u,\n  \"cab_recd_num\": %u,\n  \"results\": [",
+        m_opt.m_recd_num, uint64_t(m_json.size()), m_opt.m_shape.c_str(), m_opt.m_seed, m_opt.m_repeat,
+        g_config.m_cab_recd_num);
+    *os << tmp;
+
+    for (size_t i = 0; i < m_res.size(); ++i)
+    {
+        const BenchResult &r = m_res[i];
+        double ips = (r.m_secs > 0) ? r.m_items / r.m_secs : 0;
+        double mbs = (r.m_secs > 0) ? r.m_bytes / r.m_secs / 1024 / 1024 : 0;
+        snprintf(tmp, sizeof(tmp),
+            "%s\n    {\"name\": \"%s\", \"seconds\": %.6f, \"items\": %lu, \"bytes\": %lu, "
+            "\"items_per_sec\": %.1f, \"mb_per_sec\": %.3f}",
+            (i ? "," : ""), r.m_name.c_str(), r.m_secs, r.m_items, r.m_bytes, ips, mbs);
+        *os << tmp;
+    } // for i
+
+    *os << "\n  ]\n}\n";
+    return 0;
+} // output
+
+} // namespace steed
+
+
+
+int main(int argc, char *argv[])
+{
+    using namespace steed;
+
+    BenchOption opt;
+    CLI::App app{"steed benchmark suite"};
+    app.add_option("-n,--records", opt.m_recd_num, "generated record number");
+    app.add_option("--seed"      , opt.m_seed    , "data generator seed");
+    app.add_option("--shape"     , opt.m_shape   , "data shape: nested, telemetry or eventlog");
+    app.add_option("-r,--repeat" , opt.m_repeat  , "repeat times, the best is reported");
+    app.add_option("--cab_recd_num", opt.m_cab_recd, "number of records in a CAB");
+    app.add_option("--dir"       , opt.m_dir     , "work directory for generated data");
+    app.add_option("--conf"      , opt.m_conf    , "steed config file, store_base is used as is");
+    app.add_option("-o,--output" , opt.m_output  , "JSON result file, - as stdout");
+    app.add_option("--only"      , opt.m_only    , "run benchmarks whose name contains it");
+    CLI11_PARSE(app, argc, argv);
+
+    if ((opt.m_recd_num == 0) || (opt.m_repeat == 0))
+    {
+        printf("Bench: records and repeat should be positive!\n");
+        return -1;
+    } // if
+
+    Bench bench(opt);
+    int status = bench.init();
+    if (status >= 0) { status = bench.run(); }
+    if (status >= 0) { status = bench.output(); }
+    bench.uninit();
+
+    return (status < 0) ? -1 : 0;
+} // main
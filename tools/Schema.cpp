@@ -7,26 +7,191 @@
  *   SchemaTree Util tools
  */
 
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
 #include "Config.h"
 #include "DataType.h"
 #include "SchemaTree.h"
 #include "SchemaTreePrinter.h"
+#include "StoragePath.h"
+#include "Utility.h"
+#include "CABInfo.h"
 
 
 namespace steed {
 steed::Config g_config;
+
+
+/** storage statistics of one column got from its CABInfo file */
+class ColumnStat {
+public:
+    string           m_name    {};   /**< column path name          */
+    uint64_t         m_cab_num {0};  /**< CAB number                */
+    uint64_t         m_type_num[3]{};/**< CAB number of each type   */
+    uint64_t         m_recd_num{0};  /**< record number             */
+    uint64_t         m_item_num{0};  /**< column item number        */
+    uint64_t         m_null_num{0};  /**< null item number          */
+    uint64_t         m_strg_size{0}; /**< aligned storage bytes     */
+    uint64_t         m_dsk_size{0};  /**< encoded bytes on disk     */
+    uint64_t         m_mem_size{0};  /**< decoded bytes in memory   */
+    double           m_load_ms {0};  /**< CABInfoBuffer load time   */
+    vector<uint32_t> m_cab_size{};   /**< sorted disk size per CAB  */
+
+public:
+    double ratio(void) const
+    { return (m_dsk_size == 0) ? 0 : double(m_mem_size) / m_dsk_size; }
+
+    uint32_t cabSize(double p) const
+    {
+        if (m_cab_size.empty()) { return 0; }
+        uint64_t i = uint64_t(p * (m_cab_size.size() - 1) + 0.5);
+        return m_cab_size[i];
+    } // cabSize
+
+    /**
+     * load the CABInfoBuffer and sum the CABInfos
+     * @param fn    CABInfo file name
+     * @return 0 success; <0 failed
+     */
+    int load(const string &fn)
+    {
+        auto bgn = std::chrono::steady_clock::now();
+        CABInfoBuffer *ib = new CABInfoBuffer();
+        if (ib->init2read(fn, g_config.m_mmap_read) < 0)
+        {
+            printf("ColumnStat: init CABInfoBuffer [%s] failed!\n", fn.c_str());
+            delete ib; ib = nullptr;
+            return -1;
+        } // if
+        auto end = std::chrono::steady_clock::now();
+        m_load_ms = std::chrono::duration<double, std::milli>(end - bgn).count();
+
+        m_cab_num = ib->getUsedNumber();
+        for (uint64_t i = 0; i < m_cab_num; ++i)
+        {
+            CABInfo *ci = ib->getCABInfo(i);
+            CABItemInfo::Type tp = ci->getType();
+            m_type_num[(tp < 3) ? tp : 0] += 1;
+            m_recd_num  += ci->getRecordNum ();
+            m_item_num  += ci->getItemNumber();
+            m_null_num  += ci->getNullNumber();
+            m_strg_size += ci->m_strg_size;
+            m_dsk_size  += ci->m_dsk_size ;
+            m_mem_size  += ci->m_mem_size ;
+            if (!ci->noStorageCont()) { m_cab_size.emplace_back(ci->m_dsk_size); }
+        } // for i
+        std::sort(m_cab_size.begin(), m_cab_size.end());
+
+        delete ib; ib = nullptr;
+        return 0;
+    } // load
+}; // ColumnStat
+
+
+
+/**
+ * output the storage statistics of all leaf columns, sorted by disk size
+ * @param tree    SchemaTree instance
+ * @return 0 success; <0 failed
+ */
+int outputStorageStats(SchemaTree *tree)
+{
+    string dir;
+    Utility::getDataDir(g_config, tree->getDBName(), tree->getCltName(), dir);
+
+    vector<ColumnStat> stats;
+    uint64_t nd_num = tree->getNodeNum();
+    for (uint64_t ni = 1; ni < nd_num; ++ni)
+    {
+        if (!tree->isLeaf(ni)) { continue; }
+
+        SchemaPath sp;
+        tree->getPath(ni, sp);
+
+        string fn;
+        if (StoragePath::getDataPath(dir, tree, sp, fn) < 0)
+        {
+            printf("Schema: get data path of node [%lu] failed!\n", ni);
+            return -1;
+        } // if
+        fn.append(".cab.info");
+        if (!Utility::checkFileExisted(fn)) { continue; } // never written
+
+        stats.emplace_back();
+        ColumnStat &cs = stats.back();
+        tree->appendPathName(cs.m_name, sp);
+        if (cs.load(fn) < 0) { return -1; }
+    } // for ni
+
+    std::sort(stats.begin(), stats.end(),
+        [](const ColumnStat &a, const ColumnStat &b)
+        { return a.m_dsk_size > b.m_dsk_size; });
+
+    ColumnStat all;
+    all.m_name = "(total)";
+    for (auto &cs : stats)
+    {
+        all.m_cab_num   += cs.m_cab_num  ;
+        all.m_recd_num   = std::max(all.m_recd_num, cs.m_recd_num);
+        all.m_item_num  += cs.m_item_num ;
+        all.m_null_num  += cs.m_null_num ;
+        all.m_strg_size += cs.m_strg_size;
+        all.m_dsk_size  += cs.m_dsk_size ;
+        all.m_mem_size  += cs.m_mem_size ;
+        all.m_load_ms   += cs.m_load_ms  ;
+        for (uint32_t t = 0; t < 3; ++t) { all.m_type_num[t] += cs.m_type_num[t]; }
+        all.m_cab_size.insert(all.m_cab_size.end(), cs.m_cab_size.begin(), cs.m_cab_size.end());
+    } // for cs
+    std::sort(all.m_cab_size.begin(), all.m_cab_size.end());
+    stats.emplace_back(all);
+
+    printf("db:[%s] table:[%s] columns:%lu dir:[%s]\n", tree->getDBName().c_str(),
+        tree->getCltName().c_str(), stats.size() - 1, dir.c_str());
+    printf("%-32s %6s %6s %6s %6s %10s %10s %12s %12s %12s %6s %6s "
+        "%10s %10s %10s %10s %9s\n", "column", "CABs", "crucl", "allnul",
+        "triv", "records", "items", "nulls", "disk(B)", "mem(B)", "disk%",
+        "ratio", "cab_min", "cab_p50", "cab_p90", "cab_max", "load(ms)");
+
+    for (auto &cs : stats)
+    {
+        double share = (all.m_dsk_size == 0) ? 0 : 100.0 * cs.m_dsk_size / all.m_dsk_size;
+        printf("%-32s %6lu %6lu %6lu %6lu %10lu %10lu %12lu %12lu %12lu %6.1f %6.2f "
+            "%10u %10u %10u %10u %9.3f\n", cs.m_name.c_str(), cs.m_cab_num,
+            cs.m_type_num[CABItemInfo::crucial], cs.m_type_num[CABItemInfo::allnull],
+            cs.m_type_num[CABItemInfo::trivial], cs.m_recd_num, cs.m_item_num,
+            cs.m_null_num, cs.m_dsk_size, cs.m_mem_size, share, cs.ratio(),
+            cs.cabSize(0), cs.cabSize(0.5), cs.cabSize(0.9), cs.cabSize(1), cs.m_load_ms);
+    } // for cs
+
+    return 0;
+} // outputStorageStats
+
 } // namespace steed
 
+
+
 int main(int argc, const char *argv[])
 {
     using namespace steed;
 
-    if (argc != 3)
+    if ((argc < 3) || (argc > 5))
     {
-        printf("Usage: %s <database> <collection>\n", argv[0]);
+        printf("Usage: %s <database> <collection> [debug|tree|dot|dist|stats] [config]\n", argv[0]);
         return -1;
     } // if 
 
+    string mode((argc > 3) ? argv[3] : "debug");
+    if ((argc > 4) && (g_config.init(argv[4]) != 0))
+    {
+        printf("Config::init [%s] failed!\n", argv[4]);
+        return -1;
+    } // if
 
     string db(argv[1]), col(argv[2]); 
     SchemaTree *t  = new SchemaTree(db, col);
@@ -36,12 +201,14 @@ int main(int argc, const char *argv[])
         return -1;
     }
     
-//    SchemaTreePrinter::output2dot(t);
-//    SchemaTreePrinter::output2tree(t);
-    SchemaTreePrinter::output2debug(t);
-//    SchemaTreePrinter::outputChildNumberDist(t);
+    int status = 0;
+    if      (mode == "dot"  ) { SchemaTreePrinter::output2dot(t);   }
+    else if (mode == "tree" ) { SchemaTreePrinter::output2tree(t);  }
+    else if (mode == "dist" ) { SchemaTreePrinter::outputChildNumberDist(t); }
+    else if (mode == "stats") { status = outputStorageStats(t);     }
+    else                      { SchemaTreePrinter::output2debug(t); }
 
     delete t; t = nullptr;
 
-    return 0;
+    return status;
 } // main
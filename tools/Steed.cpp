@@ -0,0 +1,303 @@
+/*
+ * Copyright 2023 Zhiyi Wang
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * @file Steed.cpp
+ * @author Zhiyi Wang <zhiyiwang@ict.ac.cn>
+ * @version 1.0
+ * @section DESCRIPTION
+ *   steed command line client: runs the Config run modes end to end
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "steed.h"
+
+
+namespace steed {
+
+using std::string;
+using std::vector;
+
+
+/** processed records, bytes and elapsed time of a run mode */
+class RunStat {
+public:
+    uint64_t    m_recd_num{0};  /**< processed record number */
+    uint64_t    m_bytes   {0};  /**< JSON text bytes in/out  */
+    std::chrono::steady_clock::time_point
+                m_bgn{std::chrono::steady_clock::now()}; /**< start time */
+
+public:
+    void output(const char *mode)
+    {
+        double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - m_bgn).count();
+        struct rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+
+        double rps = (secs > 0) ? m_recd_num / secs : 0;
+        double mbs = (secs > 0) ? m_bytes / secs / 1024 / 1024 : 0;
+        fprintf(stderr, "steed: %s %lu records %lu bytes in %.3f s: "
+            "%.1f records/s %.3f MB/s, peak RSS %ld KB\n",
+            mode, m_recd_num, m_bytes, secs, rps, mbs, ru.ru_maxrss);
+    } // output
+}; // RunStat
+
+
+/**
+ * parse or append the JSON records in file into table
+ * @param append    table must exist to append
+ * @return 0 success; <0 failed
+ */
+int runParse(bool append)
+{
+    const string &db = g_config.m_db, &tb = g_config.m_tb;
+    const char  *mode = append ? "append" : "parse";
+    string spath;
+    Utility::getSchemaPath(g_config, db, tb, spath);
+    if (append && !Utility::checkFileExisted(spath))
+    {
+        STEED_LOG(error, "steed: table [%s.%s] does not exist to append!", db.c_str(), tb.c_str());
+        return -1;
+    } // if
+
+    if ((createDatabase(db) < 0) || (createTable(db, tb) < 0))
+    {
+        STEED_LOG(error, "steed: create table [%s.%s] failed!", db.c_str(), tb.c_str());
+        return -1;
+    } // if
+
+    std::ifstream ifs(g_config.m_jpath);
+    if (!ifs.is_open())
+    {
+        STEED_LOG(error, "steed: cannot open [%s]!", g_config.m_jpath.c_str());
+        return -1;
+    } // if
+
+    RunStat stat;
+    std::istream *is = &ifs;
+    ColumnParser *cp = new ColumnParser();
+    if (cp->init(db, tb, is) < 0)
+    {
+        STEED_LOG(error, "steed: ColumnParser init failed!");
+        delete cp; cp = nullptr;
+        return -1;
+    } // if
+
+    int64_t status = 0;
+    while ((status = cp->parseOne()) > 0) { ++stat.m_recd_num; }
+    delete cp; cp = nullptr; // flush all CABs
+
+    if (status < 0)
+    {
+        STEED_LOG(error, "steed: %s [%s] failed!", mode, g_config.m_jpath.c_str());
+        return -1;
+    } // if
+
+    ifs.clear();
+    ifs.seekg(0, std::ios::end);
+    stat.m_bytes = uint64_t(ifs.tellg());
+    if (g_config.m_timing) { stat.output(mode); }
+    return 0;
+} // runParse
+
+
+
+/**
+ * output assembled records as JSON
+ * @return 0 success; <0 failed
+ */
+int32_t outputRows(ColumnAssembler *ca, OutputSink *sink, RunStat &stat)
+{
+    // ndjson: one record each line; json: records in an array
+    bool json = (g_config.m_out_format == "json");
+    if (json) { sink->put('['); }
+
+    char *rbgn = nullptr;
+    int32_t status = 0;
+    RecordOutput ro( ca->getSchemaTree() );
+    while ((status = ca->getNext(rbgn)) > 0)
+    {
+        if (json && (stat.m_recd_num > 0)) { sink->put(','); }
+        if (ro.outJSON2Sink(sink, rbgn) < 0) { return -1; }
+        ++stat.m_recd_num;
+    } // while
+
+    if (json) { sink->write("]\n", 2); }
+    return (sink->flush() < 0) ? -1 : status;
+} // outputRows
+
+
+
+/**
+ * output column items straight from the readers as CSV, TSV or columnar
+ * @return 0 success; <0 failed
+ */
+int32_t outputColumns(ColumnAssembler *ca, OutputSink *sink, RunStat &stat)
+{
+    if (!ca->isFlat())
+    {
+        STEED_LOG(error, "steed: format [%s] needs columns without repeated field!",
+            g_config.m_out_format.c_str());
+        return -1;
+    } // if
+
+    const string &fmt = g_config.m_out_format;
+    bool  bin   = (fmt == "columnar");
+    char  delim = (fmt == "tsv") ? '\t' : ',';
+    ColumnOutput co(ca->getSchemaTree(), ca->getQueryPathes());
+    int32_t status = bin ? co.outBinHeader(sink) : co.outCSVHeader(sink, delim);
+
+    vector<ColumnItem> items;
+    while ((status >= 0) && ((status = ca->getNextItems(items)) > 0))
+    {
+        status = bin ? co.appendBin(sink, items) : co.outCSV2Sink(sink, items, delim);
+        ++stat.m_recd_num;
+    } // while
+
+    if ((status >= 0) && bin) { status = co.outBinFooter(sink); }
+    return ((status >= 0) && (sink->flush() < 0)) ? -1 : status;
+} // outputColumns
+
+
+
+/**
+ * output records or column items to stdout or the output file by batched writes
+ * @param rows   output records as JSON, otherwise column items
+ * @return 0 success; <0 failed
+ */
+int32_t assembleOutput(ColumnAssembler *ca, bool rows, RunStat &stat)
+{
+    const string &path = g_config.m_out_path;
+    int fd = path.empty() ? STDOUT_FILENO : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        STEED_LOG(error, "steed: cannot open [%s]!", path.c_str());
+        return -1;
+    } // if
+
+    int32_t status = 0;
+    {
+        FDSink sink(fd, g_config.m_out_batch_size);
+        status = rows ? outputRows(ca, &sink, stat) : outputColumns(ca, &sink, stat);
+        stat.m_bytes = sink.getTotal();
+    }
+
+    if (!path.empty() && (::close(fd) < 0)) { status = -1; }
+    return status;
+} // assembleOutput
+
+
+
+/**
+ * assemble the columns and output records
+ * @return 0 success; <0 failed
+ */
+int runAssemble(void)
+{
+    const string &db = g_config.m_db, &tb = g_config.m_tb;
+    string spath;
+    Utility::getSchemaPath(g_config, db, tb, spath);
+    if (!Utility::checkFileExisted(spath))
+    {
+        STEED_LOG(error, "steed: table [%s.%s] does not exist!", db.c_str(), tb.c_str());
+        return -1;
+    } // if
+
+    RunStat stat;
+    ColumnAssembler *ca = new ColumnAssembler();
+    if ((ca->init(db, tb, g_config.m_cols, g_config.m_where) < 0) ||
+        (ca->setRecordRange(g_config.m_recd_bgn, g_config.m_recd_end) < 0) ||
+        (ca->setLimit(g_config.m_offset, g_config.m_limit) < 0))
+    {
+        STEED_LOG(error, "steed: ColumnAssembler init failed!");
+        delete ca; ca = nullptr;
+        return -1;
+    } // if
+
+    const string &fmt = g_config.m_out_format;
+    bool rows = (fmt == "ndjson") || (fmt == "json");
+    int32_t status = assembleOutput(ca, rows, stat);
+    delete ca; ca = nullptr;
+
+    if (status < 0)
+    {
+        STEED_LOG(error, "steed: assemble failed!");
+        return -1;
+    } // if
+
+    if (g_config.m_timing) { stat.output("assemble"); }
+    return 0;
+} // runAssemble
+
+
+
+/**
+ * run the mode parsed in g_config
+ * @return 0 success; <0 failed
+ */
+int run(void)
+{
+    const string &db = g_config.m_db, &tb = g_config.m_tb;
+    int status = 0;
+    switch (g_config.getRunMode())
+    {
+        case Config::createDatabase: status = createDatabase(db);     break;
+        case Config::createTable:
+            status = createDatabase(db);
+            if (status >= 0) { status = createTable(db, tb); }
+            break;
+        case Config::dropDatabase:   status = dropDatabase(db);       break;
+        case Config::dropTable:      status = dropTable   (db, tb);   break;
+        case Config::parse:          status = runParse(false);        break;
+        case Config::append:         status = runParse(true );        break;
+        case Config::assemble:       status = runAssemble();          break;
+        default: break; // help is output
+    } // switch
+
+    return (status < 0) ? -1 : 0;
+} // run
+
+} // namespace steed
+
+
+
+int main(int argc, char *argv[])
+{
+    using namespace steed;
+
+    int status = g_config.init(argc, argv, "");
+    if (status != 0) { return status; } // CLI11 output the error
+    if (g_config.getRunMode() == Config::invalid) { return 0; }
+
+    if (initRuntime() < 0) { return -1; }
+
+    status = run();
+
+    steed::uninit();
+    return status;
+} // main